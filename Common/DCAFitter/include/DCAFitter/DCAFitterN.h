@@ -1211,6 +1211,19 @@ GPUdi() bool DCAFitterN<N, Args...>::propagateToX(o2::track::TrackParCov& t, flo
 using DCAFitter2 = DCAFitterN<2, o2::track::TrackParCov>;
 using DCAFitter3 = DCAFitterN<3, o2::track::TrackParCov>;
 
+/// compact result of the fit of one candidate by processBulk
+struct DCAFitResult {
+  int nCand = 0;                               // value returned by DCAFitterN::process
+  float chi2 = 0.f;                            // chi2 at the best PCA candidate
+  o2::gpu::gpustd::array<float, 3> pca = {0.}; // best PCA candidate
+  o2::gpu::gpustd::array<float, 6> cov = {0.}; // its covariance matrix, as from calcPCACovMatrixFlat
+};
+
+/// CPU counterpart of device::processBulk: the i-th elements of the track vectors form candidate i, the result of
+/// its fit is stored in results[i]. The fits are distributed over nThreads threads, each with its own copy of fitter.
+template <class Fitter, class... Tr>
+void processBulk(const int nThreads, const Fitter& fitter, std::vector<DCAFitResult>& results, const std::vector<Tr>&... args);
+
 namespace device
 {
 template <typename Fitter>
@@ -14,12 +14,55 @@
 /// \author ruben.shahoyan@cern.ch
 
 #include "DCAFitter/DCAFitterN.h"
+#include <fmt/format.h>
+#include <algorithm>
+#include <stdexcept>
+#include <tuple>
+
+#ifdef WITH_OPENMP
+#include <omp.h>
+#endif
 
 namespace o2
 {
 namespace vertexing
 {
 
+template <class Fitter, class... Tr>
+void processBulk(const int nThreads, const Fitter& fitter, std::vector<DCAFitResult>& results, const std::vector<Tr>&... args)
+{
+  const size_t nFits = std::get<0>(std::forward_as_tuple(args...)).size();
+  if (((args.size() != nFits) || ...)) {
+    throw std::runtime_error(fmt::format("processBulk: track vectors of different size, the first one has {} tracks", nFits));
+  }
+  results.clear();
+  results.resize(nFits);
+  std::vector<Fitter> fitters(std::max(nThreads, 1), fitter);
+#ifdef WITH_OPENMP
+#pragma omp parallel num_threads(fitters.size())
+#endif
+  {
+#ifdef WITH_OPENMP
+    auto& ft = fitters[omp_get_thread_num()];
+#pragma omp for schedule(dynamic, 64)
+#else
+    auto& ft = fitters[0];
+#endif
+    for (size_t i = 0; i < nFits; i++) {
+      auto& res = results[i];
+      res.nCand = ft.process(args[i]...);
+      if (res.nCand) {
+        res.chi2 = ft.getChi2AtPCACandidate();
+        res.pca = ft.getPCACandidatePos();
+        res.cov = ft.calcPCACovMatrixFlat();
+      }
+    }
+  }
+}
+
+template void processBulk(const int, const DCAFitter2&, std::vector<DCAFitResult>&, const std::vector<o2::track::TrackParCov>&, const std::vector<o2::track::TrackParCov>&);
+template void processBulk(const int, const DCAFitter3&, std::vector<DCAFitResult>&, const std::vector<o2::track::TrackParCov>&, const std::vector<o2::track::TrackParCov>&, const std::vector<o2::track::TrackParCov>&);
+
 void __dummy_instance__()
 {
   DCAFitter2 ft2;
@@ -552,5 +552,70 @@ BOOST_AUTO_TEST_CASE(DCAFitterNProngs)
   outStream.Close();
 }
 
+BOOST_AUTO_TEST_CASE(DCAFitterNBulk)
+{
+  constexpr int NTest = 10000;
+  constexpr int NThreads = 4;
+  TGenPhaseSpace genPHS;
+  constexpr double pion = 0.13957;
+  constexpr double k0 = 0.49761;
+  std::vector<double> k0dec = {pion, pion};
+  std::vector<int> forceQ{1, 1};
+  std::vector<o2::track::TrackParCov> vctracks, tracks0, tracks1;
+  Vec3D vtxGen;
+  double bz = 5.0;
+  for (int iev = 0; iev < NTest; iev++) {
+    generate(vtxGen, vctracks, bz, genPHS, k0, k0dec, forceQ);
+    tracks0.push_back(vctracks[0]);
+    tracks1.push_back(vctracks[1]);
+  }
+
+  o2::vertexing::DCAFitterN<2> ft;
+  ft.setBz(bz);
+  ft.setPropagateToPCA(true);
+  ft.setMaxR(200);
+  ft.setMaxDZIni(4);
+  ft.setMaxDXYIni(4);
+  ft.setMinParamChange(1e-3);
+  ft.setMinRelChi2Change(0.9);
+
+  TStopwatch swS, swB;
+  std::vector<int> resScalar(NTest);
+  std::vector<Vec3D> pcaScalar(NTest);
+  std::vector<float> chi2Scalar(NTest);
+  swS.Start();
+  for (int i = 0; i < NTest; i++) {
+    resScalar[i] = ft.process(tracks0[i], tracks1[i]);
+    if (resScalar[i]) {
+      pcaScalar[i] = ft.getPCACandidate(0);
+      chi2Scalar[i] = ft.getChi2AtPCACandidate(0);
+    }
+  }
+  swS.Stop();
+
+  std::vector<o2::vertexing::DCAFitResult> results;
+  swB.Start();
+  processBulk(NThreads, ft, results, tracks0, tracks1);
+  swB.Stop();
+  LOG(info) << "2-prong fits of " << NTest << " candidates: scalar " << swS.RealTime() * 1000 << " ms, bulk with "
+            << NThreads << " threads " << swB.RealTime() * 1000 << " ms";
+
+  BOOST_REQUIRE(results.size() == NTest);
+  int nMismatch = 0;
+  for (int i = 0; i < NTest; i++) {
+    if (results[i].nCand != resScalar[i]) {
+      nMismatch++;
+      continue;
+    }
+    if (resScalar[i]) {
+      const auto& pca = results[i].pca;
+      nMismatch += std::abs(pca[0] - pcaScalar[i][0]) + std::abs(pca[1] - pcaScalar[i][1]) + std::abs(pca[2] - pcaScalar[i][2]) > 1e-4;
+      nMismatch += std::abs(results[i].chi2 - chi2Scalar[i]) > 1e-4 * std::max(1.f, chi2Scalar[i]);
+      nMismatch += results[i].cov[0] <= 0.f || results[i].cov[2] <= 0.f || results[i].cov[5] <= 0.f;
+    }
+  }
+  BOOST_CHECK(nMismatch == 0);
+}
+
 } // namespace vertexing
 } // namespace o2
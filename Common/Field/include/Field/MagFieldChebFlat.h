@@ -0,0 +1,115 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+/// \file MagFieldChebFlat.h
+/// \brief Flattened representation of the Chebyshev field parameterization for batched evaluation
+#ifndef ALICEO2_FIELD_MAGFIELDCHEBFLAT_H_
+#define ALICEO2_FIELD_MAGFIELDCHEBFLAT_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace o2
+{
+namespace math_utils
+{
+class Chebyshev3D;
+}
+namespace field
+{
+class MagneticWrapperChebyshev;
+
+/// Copy of the solenoid and dipole parameterizations of MagneticWrapperChebyshev with all Chebyshev
+/// coefficients and their row/column bookkeeping stored in contiguous arrays. The evaluation does not touch
+/// the TObjArrays nor the mutable work buffers of Chebyshev3D(Calc), hence it is const and thread safe.
+/// The segment search is delegated to the source wrapper, which must outlive this object, but is skipped
+/// when the point lies in the same segment as the previous one of the batch.
+class MagFieldChebFlat
+{
+ public:
+  static constexpr int MaxCoefs = 128; ///< max number of rows or columns of a single parameterization
+
+  /// segments of the last evaluated points, checked first for the next point
+  struct SegmentCache {
+    int sol = -1;
+    int dip = -1;
+  };
+
+  MagFieldChebFlat() = default;
+  explicit MagFieldChebFlat(const MagneticWrapperChebyshev& src) { init(src); }
+
+  void init(const MagneticWrapperChebyshev& src);
+  bool isInitialized() const { return mSource != nullptr; }
+
+  /// field in kGauss at a single point in cartesian coordinates, same convention as MagneticWrapperChebyshev::Field
+  void Field(const double* xyz, double* b, SegmentCache& cache) const;
+  void Field(const double* xyz, double* b) const
+  {
+    SegmentCache cache;
+    Field(xyz, b, cache);
+  }
+  /// field at n points: xyz and b hold n consecutive {x,y,z} triplets
+  void Field(const float* xyz, float* b, size_t n) const;
+  void Field(const double* xyz, double* b, size_t n) const;
+
+  size_t getNCoefficients() const { return mCoefs.size(); }
+
+ private:
+  struct Param {
+    float bmin[3];
+    float bmax[3];
+    float scale[3];
+    float offset[3];
+    int nRows[3];   ///< number of rows of each output component
+    int rowOffs[3]; ///< first row of each output component in mNColsAtRow/mColOffs
+    bool isInside(const double* x) const
+    {
+      return !(bmin[0] > x[0] || x[0] > bmax[0] || bmin[1] > x[1] || x[1] > bmax[1] || bmin[2] > x[2] || x[2] > bmax[2]);
+    }
+  };
+
+  void addParam(const o2::math_utils::Chebyshev3D& cheb, std::vector<Param>& dest);
+  void evalParam(const Param& par, const double* x, double* res) const;
+  int solenoidField(const double* xyz, double* b, int seg) const;
+  int dipoleField(const double* xyz, double* b, int seg) const;
+
+  static float cheb1D(float x, const float* array, int ncf)
+  {
+    if (ncf <= 0) {
+      return 0;
+    }
+    float b0, b1, b2, x2 = x + x;
+    b0 = array[--ncf];
+    b1 = b2 = 0;
+    for (int i = ncf; i--;) {
+      b2 = b1;
+      b1 = b0;
+      b0 = array[i] + x2 * b1 - b2;
+    }
+    return b0 - x * b1;
+  }
+
+  const MagneticWrapperChebyshev* mSource = nullptr;
+  float mMinZSolenoid = 0.f;
+  std::vector<Param> mSolenoid;
+  std::vector<Param> mDipole;
+  std::vector<uint16_t> mNColsAtRow;  ///< number of significant columns of each row
+  std::vector<int> mColOffs;          ///< first column of each row in mNCoefsAtCol/mCoefOffs
+  std::vector<uint16_t> mNCoefsAtCol; ///< number of significant coefficients of each column
+  std::vector<int> mCoefOffs;         ///< first coefficient of each column in mCoefs
+  std::vector<float> mCoefs;          ///< coefficients of all parameterizations
+};
+
+} // namespace field
+} // namespace o2
+
+#endif
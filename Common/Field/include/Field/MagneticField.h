@@ -20,6 +20,7 @@
 #include "Field/MagFieldParam.h"
 #include "Field/MagneticWrapperChebyshev.h" // for MagneticWrapperChebyshev
 #include "Field/MagFieldFast.h"
+#include "Field/MagFieldChebFlat.h"
 #include "TSystem.h"
 #include "Rtypes.h" // for Double_t, Char_t, Int_t, Float_t, etc
 #include "TNamed.h" // for TNamed
@@ -114,6 +115,11 @@ class MagneticField : public FairField
   /// Main interface from TVirtualMagField used in simulation
   void Field(const Double_t* __restrict__ point, Double_t* __restrict__ bField) override;
 
+  /// Field at n points, xyz and b holding n consecutive {x,y,z} triplets. The measured map is evaluated
+  /// via its flattened copy, reusing the segment of the previous point where possible
+  void Field(const float* __restrict__ xyz, float* __restrict__ b, size_t n);
+  void Field(const double* __restrict__ xyz, double* __restrict__ b, size_t n);
+
   void field(const math_utils::Point3D<float> xyz, float bxyz[3])
   {
     double xyzd[3] = {xyz.X(), xyz.Y(), xyz.Z()}, bxyzd[3] = {0};
@@ -253,6 +259,7 @@ class MagneticField : public FairField
  private:
   std::unique_ptr<MagneticWrapperChebyshev> mMeasuredMap; //! Measured part of the field map
   std::unique_ptr<MagFieldFast> mFastField;               // ! optional fast parametrization
+  std::unique_ptr<MagFieldChebFlat> mFlatMap;             //! flattened copy of the measured map for batched queries
   MagFieldParam::BMap_t mMapType;                         ///< field map type
   Double_t mSolenoid;                                     ///< Solenoid field setting
   MagFieldParam::BeamType_t mBeamType;                    ///< Beam type: A-A (mBeamType=0) or p-p (mBeamType=1)
@@ -0,0 +1,169 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+/// \file MagFieldChebFlat.cxx
+/// \brief Implementation of the flattened Chebyshev field parameterization
+
+#include "Field/MagFieldChebFlat.h"
+#include "Field/MagneticWrapperChebyshev.h"
+#include "MathUtils/Chebyshev3D.h"
+#include "MathUtils/Chebyshev3DCalc.h"
+#include <fairlogger/Logger.h>
+
+using namespace o2::field;
+using namespace o2::math_utils;
+
+void MagFieldChebFlat::init(const MagneticWrapperChebyshev& src)
+{
+  mSource = &src;
+  mMinZSolenoid = src.getMinZSol();
+  mSolenoid.clear();
+  mDipole.clear();
+  mNColsAtRow.clear();
+  mColOffs.clear();
+  mNCoefsAtCol.clear();
+  mCoefOffs.clear();
+  mCoefs.clear();
+  for (int i = 0; i < src.getNumberOfParametersSol(); i++) {
+    addParam(*src.getParameterSolenoid(i), mSolenoid);
+  }
+  for (int i = 0; i < src.getNumberOfParametersDip(); i++) {
+    addParam(*src.getParameterDipole(i), mDipole);
+  }
+  LOGP(debug, "Flattened Chebyshev field: {} solenoid and {} dipole parameterizations, {} coefficients", mSolenoid.size(), mDipole.size(), mCoefs.size());
+}
+
+void MagFieldChebFlat::addParam(const Chebyshev3D& cheb, std::vector<Param>& dest)
+{
+  auto& par = dest.emplace_back();
+  for (int i = 0; i < 3; i++) {
+    par.bmin[i] = cheb.getBoundMin(i);
+    par.bmax[i] = cheb.getBoundMax(i);
+    par.scale[i] = cheb.getBoundaryMappingScale()[i];
+    par.offset[i] = cheb.getBoundaryMappingOffset()[i];
+  }
+  for (int idim = 0; idim < 3; idim++) {
+    const auto* calc = cheb.getChebyshevCalc(idim);
+    const int nRows = calc->getNumberOfRows();
+    const int coefOffs = mCoefs.size();
+    if (nRows > MaxCoefs || calc->getMaxColumnsAtRow() > MaxCoefs) {
+      LOGP(fatal, "Chebyshev parameterization with {} rows and {} columns exceeds the supported {}", nRows, calc->getMaxColumnsAtRow(), MaxCoefs);
+    }
+    par.nRows[idim] = nRows;
+    par.rowOffs[idim] = mNColsAtRow.size();
+    for (int id0 = 0; id0 < nRows; id0++) {
+      const int nCols = calc->getNumberOfColumnsAtRow()[id0];
+      const int col0 = calc->getColAtRowBg()[id0];
+      mNColsAtRow.push_back(nCols);
+      mColOffs.push_back(mNCoefsAtCol.size());
+      for (int id1 = 0; id1 < nCols; id1++) {
+        mNCoefsAtCol.push_back(calc->getCoefficientBound2D0()[col0 + id1]);
+        mCoefOffs.push_back(coefOffs + calc->getCoefficientBound2D1()[col0 + id1]);
+      }
+    }
+    mCoefs.insert(mCoefs.end(), calc->getCoefficients(), calc->getCoefficients() + calc->getNumberOfCoefficients());
+  }
+}
+
+void MagFieldChebFlat::evalParam(const Param& par, const double* x, double* res) const
+{
+  float xi[3], tmp1D[MaxCoefs], tmp2D[MaxCoefs];
+  for (int i = 3; i--;) {
+    xi[i] = (x[i] - par.offset[i]) * par.scale[i];
+#ifdef _BRING_TO_BOUNDARY_
+    xi[i] = xi[i] < -1.f ? -1.f : (xi[i] > 1.f ? 1.f : xi[i]);
+#endif
+  }
+  for (int idim = 3; idim--;) {
+    const int rowOffs = par.rowOffs[idim];
+    for (int id0 = par.nRows[idim]; id0--;) {
+      const int nCols = mNColsAtRow[rowOffs + id0];
+      const int col0 = mColOffs[rowOffs + id0];
+      for (int id1 = nCols; id1--;) {
+        tmp2D[id1] = cheb1D(xi[2], mCoefs.data() + mCoefOffs[col0 + id1], mNCoefsAtCol[col0 + id1]);
+      }
+      tmp1D[id0] = cheb1D(xi[1], tmp2D, nCols);
+    }
+    res[idim] = cheb1D(xi[0], tmp1D, par.nRows[idim]);
+  }
+}
+
+int MagFieldChebFlat::solenoidField(const double* xyz, double* b, int seg) const
+{
+  double rphiz[3];
+  MagneticWrapperChebyshev::cartesianToCylindrical(xyz, rphiz);
+  if (seg < 0 || !mSolenoid[seg].isInside(rphiz)) {
+    seg = mSource->findSolenoidSegment(rphiz);
+    if (seg < 0) {
+      return seg;
+    }
+  }
+  const auto& par = mSolenoid[seg];
+#ifndef _BRING_TO_BOUNDARY_
+  if (!par.isInside(rphiz)) {
+    return -1;
+  }
+#endif
+  evalParam(par, rphiz, b);
+  MagneticWrapperChebyshev::cylindricalToCartesianCylB(rphiz, b, b);
+  return seg;
+}
+
+int MagFieldChebFlat::dipoleField(const double* xyz, double* b, int seg) const
+{
+  if (seg < 0 || !mDipole[seg].isInside(xyz)) {
+    seg = mSource->findDipoleSegment(xyz);
+    if (seg < 0) {
+      return seg;
+    }
+  }
+  const auto& par = mDipole[seg];
+#ifndef _BRING_TO_BOUNDARY_
+  if (!par.isInside(xyz)) {
+    return -1;
+  }
+#endif
+  evalParam(par, xyz, b);
+  return seg;
+}
+
+void MagFieldChebFlat::Field(const double* xyz, double* b, SegmentCache& cache) const
+{
+  b[0] = b[1] = b[2] = 0;
+  if (xyz[2] > mMinZSolenoid) {
+    cache.sol = solenoidField(xyz, b, cache.sol);
+  } else {
+    cache.dip = dipoleField(xyz, b, cache.dip);
+  }
+}
+
+void MagFieldChebFlat::Field(const double* xyz, double* b, size_t n) const
+{
+  SegmentCache cache; // consecutive points are likely to be in the same segment
+  for (size_t i = 0; i < n; i++) {
+    Field(xyz + 3 * i, b + 3 * i, cache);
+  }
+}
+
+void MagFieldChebFlat::Field(const float* xyz, float* b, size_t n) const
+{
+  SegmentCache cache;
+  double xyzD[3], bD[3];
+  for (size_t i = 0; i < n; i++, xyz += 3, b += 3) {
+    xyzD[0] = xyz[0];
+    xyzD[1] = xyz[1];
+    xyzD[2] = xyz[2];
+    Field(xyzD, bD, cache);
+    b[0] = bD[0];
+    b[1] = bD[1];
+    b[2] = bD[2];
+  }
+}
@@ -256,6 +256,7 @@ Bool_t MagneticField::loadParameterization()
   }
   file->Close();
   delete file;
+  mFlatMap = std::make_unique<MagFieldChebFlat>(*mMeasuredMap);
   return kTRUE;
 }
 
@@ -286,6 +287,54 @@ void MagneticField::Field(const Double_t* __restrict__ xyz, Double_t* __restrict
   }
 }
 
+void MagneticField::Field(const double* __restrict__ xyz, double* __restrict__ b, size_t n)
+{
+  /*
+   * query field value at n points
+   */
+  MagFieldChebFlat::SegmentCache cache;
+  for (size_t i = 0; i < n; i++, xyz += 3, b += 3) {
+    if (mFastField && mFastField->Field(xyz, b)) {
+      continue;
+    }
+    if (mMeasuredMap && xyz[2] > mMeasuredMap->getMinZ() && xyz[2] < mMeasuredMap->getMaxZ()) {
+      mFlatMap->Field(xyz, b, cache);
+      const double fact = (xyz[2] > sSolenoidToDipoleZ || mDipoleOnOffFlag) ? mMultipicativeFactorSolenoid : mMultipicativeFactorDipole;
+      for (int j = 3; j--;) {
+        b[j] *= fact;
+      }
+    } else {
+      MachineField(xyz, b);
+    }
+  }
+}
+
+void MagneticField::Field(const float* __restrict__ xyz, float* __restrict__ b, size_t n)
+{
+  double xyzD[3], bD[3];
+  MagFieldChebFlat::SegmentCache cache;
+  for (size_t i = 0; i < n; i++, xyz += 3, b += 3) {
+    if (mFastField && mFastField->Field(xyz, b)) {
+      continue;
+    }
+    xyzD[0] = xyz[0];
+    xyzD[1] = xyz[1];
+    xyzD[2] = xyz[2];
+    if (mMeasuredMap && xyzD[2] > mMeasuredMap->getMinZ() && xyzD[2] < mMeasuredMap->getMaxZ()) {
+      mFlatMap->Field(xyzD, bD, cache);
+      const double fact = (xyzD[2] > sSolenoidToDipoleZ || mDipoleOnOffFlag) ? mMultipicativeFactorSolenoid : mMultipicativeFactorDipole;
+      for (int j = 3; j--;) {
+        b[j] = bD[j] * fact;
+      }
+    } else {
+      MachineField(xyzD, bD);
+      for (int j = 3; j--;) {
+        b[j] = bD[j];
+      }
+    }
+  }
+}
+
 Double_t MagneticField::getBz(const Double_t* xyz) const
 {
   /*
@@ -316,6 +365,7 @@ MagneticField& MagneticField::operator=(const MagneticField& src)
   if (this != &src) {
     if (src.mMeasuredMap) {
       mMeasuredMap.reset(new MagneticWrapperChebyshev(*src.getMeasuredMap()));
+      mFlatMap = std::make_unique<MagFieldChebFlat>(*mMeasuredMap);
     }
     SetName(src.GetName());
     mSolenoid = src.mSolenoid;
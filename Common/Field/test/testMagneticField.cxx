@@ -98,3 +98,69 @@ BOOST_AUTO_TEST_CASE(MagneticField_test)
     BOOST_CHECK(TMath::Abs(rms[i] / nomBz) < 1.e-3);
   }
 }
+
+BOOST_AUTO_TEST_CASE(MagneticFieldBatch_test)
+{
+  std::unique_ptr<MagneticField> fld = std::make_unique<MagneticField>("Maps", "Maps", 1., 1., o2::field::MagFieldParam::k5kG);
+  const double nomBz = 5.00685;
+  const int ntst = 10000, repFactor = 50;
+  float rnd[3];
+  // points along straight lines from the IP, as queried in the track propagation
+  std::vector<double> xyz(3 * ntst), bref(3 * ntst), bbatch(3 * ntst);
+  std::vector<float> xyzF(3 * ntst), bbatchF(3 * ntst);
+  const int nPerLine = 100;
+  for (int it = 0; it < ntst; it++) {
+    if (it % nPerLine == 0) {
+      gRandom->RndmArray(3, rnd);
+    }
+    double r = 400. * (it % nPerLine) / nPerLine;
+    xyz[3 * it] = r * TMath::Cos(rnd[1] * TMath::Pi() * 2);
+    xyz[3 * it + 1] = r * TMath::Sin(rnd[1] * TMath::Pi() * 2);
+    xyz[3 * it + 2] = (rnd[0] - 0.5) * 250 * r / 400.;
+    for (int i = 0; i < 3; i++) {
+      xyzF[3 * it + i] = xyz[3 * it + i];
+    }
+  }
+
+  TStopwatch swPoint, swBatch, swBatchF, swFast;
+  swPoint.Start();
+  for (int ii = repFactor; ii--;) {
+    for (int it = 0; it < ntst; it++) {
+      fld->Field(&xyz[3 * it], &bref[3 * it]);
+    }
+  }
+  swPoint.Stop();
+  swBatch.Start();
+  for (int ii = repFactor; ii--;) {
+    fld->Field(xyz.data(), bbatch.data(), ntst);
+  }
+  swBatch.Stop();
+  swBatchF.Start();
+  for (int ii = repFactor; ii--;) {
+    fld->Field(xyzF.data(), bbatchF.data(), ntst);
+  }
+  swBatchF.Stop();
+
+  double maxDiff = 0., maxDiffF = 0.;
+  for (int it = 0; it < 3 * ntst; it++) {
+    maxDiff = std::max(maxDiff, std::abs(bref[it] - bbatch[it]));
+    maxDiffF = std::max(maxDiffF, std::abs(bref[it] - bbatchF[it]));
+  }
+
+  fld->AllowFastField(true);
+  std::vector<double> bfast(3 * ntst);
+  swFast.Start();
+  for (int ii = repFactor; ii--;) {
+    for (int it = 0; it < ntst; it++) {
+      fld->Field(&xyz[3 * it], &bfast[3 * it]);
+    }
+  }
+  swFast.Stop();
+
+  const double norm = 1. / (ntst * repFactor);
+  LOG(info) << "Timing per point: exact param " << swPoint.CpuTime() * norm << " batched " << swBatch.CpuTime() * norm
+            << " batched float " << swBatchF.CpuTime() * norm << " fast param " << swFast.CpuTime() * norm << " s";
+  LOG(info) << "Max deviation of batched wrt per point field: " << maxDiff << " (double) " << maxDiffF << " (float) kG";
+  BOOST_CHECK(maxDiff / nomBz < 1.e-6);
+  BOOST_CHECK(maxDiffF / nomBz < 1.e-4);
+}
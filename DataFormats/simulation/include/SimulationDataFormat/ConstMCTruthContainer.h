@@ -17,6 +17,7 @@
 #define O2_CONSTMCTRUTHCONTAINER_H
 
 #include <SimulationDataFormat/MCTruthContainer.h>
+#include <algorithm>
 #ifndef GPUCA_STANDALONE
 #include <Framework/Traits.h>
 #endif
@@ -34,7 +35,7 @@ namespace dataformats
 /// This provides access functionality to MCTruthContainer with optimized linear storage
 /// so that the data can easily be shared in memory or sent over network.
 /// This container needs to be initialized by calling "flatten_to" from an existing
-/// MCTruthContainer
+/// MCTruthContainer or filled directly with a ConstMCTruthContainerBuilder
 template <typename TruthElement>
 class ConstMCTruthContainer : public std::vector<char>
 {
@@ -210,8 +211,242 @@ class ConstMCTruthContainerView
   }
 };
 
+/// @class ConstMCTruthContainerBuilder
+/// @brief Fills labels directly into the flat layout of ConstMCTruthContainer
+///
+/// The header elements and the labels are written in place into the provided byte container,
+/// typically the output buffer obtained with make<ConstMCTruthContainer<T>>, so that producers
+/// do not need to build an MCTruthContainer first and copy it with flatten_to.
+/// Room for the header elements is kept in front of the labels (sized by the hint given at
+/// construction, doubled when exceeded, which moves the labels once). finalize() moves the
+/// labels right after the used header elements, writes the FlatHeader and must be called
+/// before the buffer is read or sent.
+template <typename TruthElement, typename ContainerType = std::vector<char>>
+class ConstMCTruthContainerBuilder
+{
+ public:
+  static_assert(sizeof(typename ContainerType::value_type) == 1, "the buffer must be a container of bytes");
+  static_assert(std::is_trivially_copyable<TruthElement>::value, "truth element must be trivially copyable");
+
+  /// the content of @a buffer is discarded, the hints are the expected number of indices and labels
+  ConstMCTruthContainerBuilder(ContainerType& buffer, size_t nIndicesHint = 0, size_t nElementsHint = 0) : mBuffer(buffer), mHeaderCapacity(nIndicesHint)
+  {
+    mBuffer.clear();
+    mBuffer.reserve(getLabelOffset() + nElementsHint * sizeof(TruthElement));
+    mBuffer.resize(getLabelOffset());
+  }
+
+  // return the number of original data indexed so far
+  size_t getIndexedSize() const { return mNHeaders; }
+
+  // return the number of labels added so far
+  size_t getNElements() const { return mNElements; }
+
+  // add element for a particular dataindex, same semantics as MCTruthContainer::addElement:
+  // only strictly consecutive modes are supported, skipped indices are added without labels
+  void addElement(uint32_t dataindex, TruthElement const& element, bool noElement = false)
+  {
+    addIndex(dataindex);
+    if (!noElement) {
+      auto target = reserveElements(1);
+      memcpy(target, &element, sizeof(TruthElement));
+    }
+  }
+
+  /// adds a data index that has no label
+  void addNoLabelIndex(uint32_t dataindex)
+  {
+    addIndex(dataindex);
+  }
+
+  // add multiple labels at once for a given dataindex
+  void addElements(uint32_t dataindex, gsl::span<const TruthElement> elements)
+  {
+    addIndex(dataindex);
+    if (elements.size()) {
+      memcpy(reserveElements(elements.size()), elements.data(), elements.size() * sizeof(TruthElement));
+    }
+  }
+
+  /// Append all indices and labels of a flattened container, with a single copy of each block
+  void mergeAtBack(ConstMCTruthContainerView<TruthElement> const& other)
+  {
+    const auto buffer = other.getBuffer();
+    if ((size_t)buffer.size() < sizeof(FlatHeader)) {
+      return;
+    }
+    FlatHeader flatheader;
+    memcpy(&flatheader, buffer.data(), sizeof(FlatHeader));
+    if (flatheader.sizeofHeaderElement != sizeof(MCTruthHeaderElement) || flatheader.sizeofTruthElement != sizeof(TruthElement)) {
+      throw std::runtime_error("member element sizes don't match");
+    }
+    if ((size_t)buffer.size() < sizeof(FlatHeader) + flatheader.nofHeaderElements * sizeof(MCTruthHeaderElement) + flatheader.nofTruthElements * sizeof(TruthElement)) {
+      throw std::runtime_error("inconsistent buffer size: too small");
+    }
+    if (mNHeaders + flatheader.nofHeaderElements > mHeaderCapacity) {
+      growHeaders(std::max<size_t>(mNHeaders + flatheader.nofHeaderElements, 2 * mHeaderCapacity));
+    }
+    const auto offset = mNElements;
+    const auto* source = buffer.data() + sizeof(FlatHeader);
+    auto* target = getHeaderStart() + mNHeaders;
+    for (uint32_t i = 0; i < flatheader.nofHeaderElements; ++i, source += sizeof(MCTruthHeaderElement)) {
+      MCTruthHeaderElement header;
+      memcpy(&header, source, sizeof(MCTruthHeaderElement));
+      header.index += offset;
+      memcpy(target++, &header, sizeof(MCTruthHeaderElement));
+    }
+    mNHeaders += flatheader.nofHeaderElements;
+    if (flatheader.nofTruthElements) {
+      memcpy(reserveElements(flatheader.nofTruthElements), source, flatheader.nofTruthElements * sizeof(TruthElement));
+    }
+  }
+
+  /// Finish the buffer: move the labels behind the used header elements, write the FlatHeader
+  /// and shrink the container to the final size, which is returned.
+  size_t finalize()
+  {
+    if (mHeaderCapacity != mNHeaders) {
+      auto* data = reinterpret_cast<char*>(mBuffer.data());
+      const auto oldLabelOffset = getLabelOffset();
+      mHeaderCapacity = mNHeaders;
+      memmove(data + getLabelOffset(), data + oldLabelOffset, mNElements * sizeof(TruthElement));
+    }
+    const size_t bufferSize = getLabelOffset() + mNElements * sizeof(TruthElement);
+    mBuffer.resize(bufferSize);
+    FlatHeader flatheader;
+    flatheader.nofHeaderElements = mNHeaders;
+    flatheader.nofTruthElements = mNElements;
+    memcpy(mBuffer.data(), &flatheader, sizeof(FlatHeader));
+    return bufferSize;
+  }
+
+ private:
+  using FlatHeader = typename MCTruthContainer<TruthElement>::FlatHeader;
+
+  size_t getLabelOffset() const { return sizeof(FlatHeader) + mHeaderCapacity * sizeof(MCTruthHeaderElement); }
+
+  MCTruthHeaderElement* getHeaderStart()
+  {
+    return reinterpret_cast<MCTruthHeaderElement*>(reinterpret_cast<char*>(mBuffer.data()) + sizeof(FlatHeader));
+  }
+
+  void addIndex(uint32_t dataindex)
+  {
+    if (dataindex < mNHeaders) {
+      // must currently be the last one
+      if (dataindex != mNHeaders - 1) {
+        throw std::runtime_error("ConstMCTruthContainerBuilder: unsupported code path");
+      }
+      return;
+    }
+    // add empty holes and the new index
+    if (dataindex >= mHeaderCapacity) {
+      growHeaders(std::max<size_t>(dataindex + 1, 2 * mHeaderCapacity));
+    }
+    auto* headers = getHeaderStart();
+    for (; mNHeaders <= dataindex; ++mNHeaders) {
+      headers[mNHeaders] = MCTruthHeaderElement(mNElements);
+    }
+  }
+
+  // increase the space for the header elements, moving the labels behind
+  void growHeaders(size_t capacity)
+  {
+    const auto oldLabelOffset = getLabelOffset();
+    mHeaderCapacity = capacity;
+    mBuffer.resize(getLabelOffset() + mNElements * sizeof(TruthElement));
+    auto* data = reinterpret_cast<char*>(mBuffer.data());
+    memmove(data + getLabelOffset(), data + oldLabelOffset, mNElements * sizeof(TruthElement));
+  }
+
+  // make room for n more labels and return the address of the first one
+  char* reserveElements(size_t n)
+  {
+    const auto offset = getLabelOffset() + mNElements * sizeof(TruthElement);
+    mBuffer.resize(offset + n * sizeof(TruthElement));
+    mNElements += n;
+    return reinterpret_cast<char*>(mBuffer.data()) + offset;
+  }
+
+  ContainerType& mBuffer;
+  size_t mHeaderCapacity = 0;
+  uint32_t mNHeaders = 0;
+  uint32_t mNElements = 0;
+};
+
+/// create a builder filling @a buffer, deducing the container type
+template <typename TruthElement, typename ContainerType>
+ConstMCTruthContainerBuilder<TruthElement, ContainerType> makeConstMCTruthContainerBuilder(ContainerType& buffer, size_t nIndicesHint = 0, size_t nElementsHint = 0)
+{
+  return ConstMCTruthContainerBuilder<TruthElement, ContainerType>(buffer, nIndicesHint, nElementsHint);
+}
+
+/// @class ConstMCTruthContainerMergedView
+/// @brief Concatenation of several flat label containers without copying them
+///
+/// The data indices of the merged parts follow each other in the order in which they were
+/// merged, as with MCTruthContainer::mergeAtBack, but the labels stay in the original buffers,
+/// which must outlive the merged view. flatten_to produces the contiguous form when needed.
+template <typename TruthElement>
+class ConstMCTruthContainerMergedView
+{
+ public:
+  using View = ConstMCTruthContainerView<TruthElement>;
+
+  ConstMCTruthContainerMergedView() = default;
+
+  // merge another container to the back of this one, only the view is stored
+  void mergeAtBack(View const& other)
+  {
+    if (other.getIndexedSize() == 0) {
+      return;
+    }
+    mParts.push_back(other);
+    mIndexOffsets.push_back(mIndexedSize);
+    mIndexedSize += other.getIndexedSize();
+    mNElements += other.getNElements();
+  }
+
+  gsl::span<const TruthElement> getLabels(uint32_t dataindex) const
+  {
+    if (dataindex >= mIndexedSize) {
+      return gsl::span<const TruthElement>();
+    }
+    const auto part = std::upper_bound(mIndexOffsets.begin(), mIndexOffsets.end(), dataindex) - mIndexOffsets.begin() - 1;
+    return mParts[part].getLabels(dataindex - mIndexOffsets[part]);
+  }
+
+  // return the number of original data indexed here
+  size_t getIndexedSize() const { return mIndexedSize; }
+
+  // return the number of labels managed in this container
+  size_t getNElements() const { return mNElements; }
+
+  size_t getNParts() const { return mParts.size(); }
+  View const& getPart(size_t i) const { return mParts[i]; }
+
+  /// Copy all parts into a single buffer with the ConstMCTruthContainer layout
+  template <typename ContainerType>
+  size_t flatten_to(ContainerType& container) const
+  {
+    ConstMCTruthContainerBuilder<TruthElement, ContainerType> builder(container, mIndexedSize, mNElements);
+    for (auto const& part : mParts) {
+      builder.mergeAtBack(part);
+    }
+    return builder.finalize();
+  }
+
+ private:
+  std::vector<View> mParts;
+  std::vector<size_t> mIndexOffsets; // first data index of each part
+  size_t mIndexedSize = 0;
+  size_t mNElements = 0;
+};
+
 using ConstMCLabelContainer = o2::dataformats::ConstMCTruthContainer<o2::MCCompLabel>;
 using ConstMCLabelContainerView = o2::dataformats::ConstMCTruthContainerView<o2::MCCompLabel>;
+using ConstMCLabelContainerBuilder = o2::dataformats::ConstMCTruthContainerBuilder<o2::MCCompLabel>;
+using ConstMCLabelContainerMergedView = o2::dataformats::ConstMCTruthContainerMergedView<o2::MCCompLabel>;
 
 class MCLabelIOHelper
 {
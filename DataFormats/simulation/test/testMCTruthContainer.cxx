@@ -212,6 +212,89 @@ BOOST_AUTO_TEST_CASE(MCTruthContainer_flatten)
   BOOST_CHECK(cc.getLabels(2)[0] == 10);
 }
 
+BOOST_AUTO_TEST_CASE(ConstMCTruthContainer_builder)
+{
+  using TruthElement = long;
+  using TruthContainer = dataformats::MCTruthContainer<TruthElement>;
+  TruthContainer container;
+  dataformats::ConstMCTruthContainer<TruthElement> cc;
+  // no size hints, so that the space for the header elements needs to grow
+  dataformats::ConstMCTruthContainerBuilder<TruthElement> builder(cc);
+  for (uint32_t i = 0; i < 100; ++i) {
+    if (i % 7 == 3) {
+      container.addNoLabelIndex(i);
+      builder.addNoLabelIndex(i);
+      continue;
+    }
+    for (uint32_t j = 0; j <= i % 3; ++j) {
+      container.addElement(i, TruthElement(i * 10 + j));
+      builder.addElement(i, TruthElement(i * 10 + j));
+    }
+  }
+  std::vector<TruthElement> more{1, 2, 3};
+  container.addElements(102, more);
+  builder.addElements(102, more);
+
+  // not supported, must throw
+  BOOST_CHECK_THROW(builder.addElement(0, TruthElement(0)), std::runtime_error);
+
+  const auto size = builder.finalize();
+  BOOST_CHECK(size == cc.size());
+
+  // the layout must be identical to the flattened container
+  std::vector<char> buffer;
+  BOOST_CHECK(container.flatten_to(buffer) == size);
+  BOOST_CHECK(std::equal(buffer.begin(), buffer.end(), cc.begin(), cc.end()));
+  BOOST_CHECK(cc.getIndexedSize() == 103);
+  BOOST_CHECK(cc.getNElements() == container.getNElements());
+  BOOST_CHECK(cc.getLabels(101).size() == 0);
+  BOOST_CHECK(cc.getLabels(102).size() == 3);
+  BOOST_CHECK(cc.getLabels(98).size() == 3);
+  BOOST_CHECK(cc.getLabels(98)[2] == 982);
+}
+
+BOOST_AUTO_TEST_CASE(ConstMCTruthContainer_merge)
+{
+  using TruthElement = long;
+  using TruthContainer = dataformats::MCTruthContainer<TruthElement>;
+  TruthContainer container1, container2, merged;
+  container1.addElement(0, TruthElement(1));
+  container1.addElement(0, TruthElement(2));
+  container1.addNoLabelIndex(1);
+  container1.addElement(2, TruthElement(3));
+  container2.addElement(0, TruthElement(4));
+  container2.addElement(1, TruthElement(5));
+  container2.addElement(1, TruthElement(6));
+  merged.mergeAtBack(container1);
+  merged.mergeAtBack(container2);
+
+  dataformats::ConstMCTruthContainer<TruthElement> cc1, cc2, empty;
+  container1.flatten_to(cc1);
+  container2.flatten_to(cc2);
+
+  // zero-copy concatenation
+  dataformats::ConstMCTruthContainerMergedView<TruthElement> view;
+  view.mergeAtBack(cc1);
+  view.mergeAtBack(empty);
+  view.mergeAtBack(cc2);
+  BOOST_CHECK(view.getNParts() == 2);
+  BOOST_CHECK(view.getIndexedSize() == merged.getIndexedSize());
+  BOOST_CHECK(view.getNElements() == merged.getNElements());
+  for (uint32_t i = 0; i < merged.getIndexedSize(); ++i) {
+    auto labels = view.getLabels(i);
+    auto expected = merged.getLabels(i);
+    BOOST_CHECK(std::equal(labels.begin(), labels.end(), expected.begin(), expected.end()));
+  }
+  BOOST_CHECK(view.getLabels(3).data() == cc2.getLabels(0).data());
+  BOOST_CHECK(view.getLabels(5).size() == 0);
+
+  // contiguous copy, identical to the flattened merged container
+  std::vector<char> flat, expected;
+  view.flatten_to(flat);
+  merged.flatten_to(expected);
+  BOOST_CHECK(flat == expected);
+}
+
 BOOST_AUTO_TEST_CASE(LabelContainer_noncont)
 {
   using TruthElement = long;
@@ -89,6 +89,9 @@ class AlignableSensor : public AlignableVolume
   void setMatrixClAlgReco(const TGeoHMatrix& m) { mMatClAlgReco = m; }
   //
  protected:
+  //
+  // derivatives vs sensor LOCAL frame parameters for explicitly provided tracking to local matrix
+  void dPosTraDParGeomLOC(const AlignmentPoint* pnt, double* deriv, const TGeoHMatrix& t2l) const;
   //
   bool IsSortable() const override { return true; }
   int Compare(const TObject* a) const override;
@@ -107,6 +107,17 @@ class Controller final : public TObject
     void print() const;
   };
 
+  /// workspace of the track in a batch of tracks fitted concurrently
+  struct TrackSlot {
+    std::unique_ptr<AlignmentTrack> track;         // track and its points
+    std::unique_ptr<AlignmentPoint> refPoint;      // vertex constraint point of the track
+    const o2::track::TrackParCov* trcIn = nullptr; // original inner track parameters, for debug output
+    int vtxRef = -1;                               // vertex-tracks reference entry of the track
+    bool vtxCont = false;                          // track is constrained to the vertex
+    bool ok = false;                               // refit and derivatives calculation succeeded
+  };
+  static constexpr int TracksPerThreadInBatch = 16; // number of tracks per thread collected before the concurrent fit
+
   using DetID = o2::detectors::DetID;
   using GTrackID = o2::dataformats::GlobalTrackID;
 
@@ -225,6 +236,10 @@ class Controller final : public TObject
   void initMIlleOutput();
   void initResidOutput();
   bool storeProcessedTrack(o2::dataformats::GlobalTrackID tid = {});
+  bool prepareTrack(GTrackID trackIndex, const o2::dataformats::PrimaryVertex* vtx, bool useVertexConstrain, bool fieldON, TrackSlot& slot);
+  bool fitTrack(TrackSlot& slot) const;
+  void fitTracks(int nSlots, int nThreads);
+  int getNThreadsToUse(bool fieldON) const;
   void extractDbgTrack();
   void printStatistics() const;
   //
@@ -288,6 +303,7 @@ class Controller final : public TObject
   const o2::gpu::GPUParam* getTPCParam() const { return mTPCParam; }
 
  protected:
+  void swapTrackSlot(TrackSlot& slot);
   //
   // --------- dummies -----------
   Controller(const Controller&);
@@ -331,6 +347,7 @@ class Controller final : public TObject
   std::unordered_map<int, int> mLbl2ID; // Labels mapping to parameter ID
   //
   std::unique_ptr<AlignmentPoint> mRefPoint; //! reference point for track definition
+  std::vector<TrackSlot> mTrackSlots;        //! workspaces of the tracks processed in the current batch
   //
   int mDebugOutputLevel = 0;
   o2::utils::TreeStreamRedirector* mDBGOut = nullptr;
@@ -57,6 +57,9 @@ class EventVertex : public AlignableSensor
   void prepareMatrixL2GIdeal() final { mMatL2GIdeal.Clear(); } // unit matrix
   void prepareMatrixT2L() final;
   //
+  // the T2L matrix is defined by the alpha of the vertex point of given track rather than by the last setAlpha
+  void dPosTraDParGeomLOC(const AlignmentPoint* pnt, double* deriv) const final;
+  //
  protected:
   EventVertex(const EventVertex&);
   EventVertex& operator=(const EventVertex&);
@@ -47,9 +47,25 @@ void AlignableSensor::dPosTraDParGeomLOC(const AlignmentPoint* pnt, double* deri
   // Jacobian of position in sensor tracking frame (tra) vs sensor LOCAL frame
   // parameters in TGeoHMatrix convention.
   // Result is stored in array deriv as linearized matrix 6x3
+  dPosTraDParGeomLOC(pnt, deriv, getMatrixT2L());
+}
+
+//_________________________________________________________
+void AlignableSensor::dPosTraDParGeomLOC(const AlignmentPoint* pnt, double* deriv, const TGeoHMatrix& t2l) const
+{
+  // Jacobian of position in sensor tracking frame (tra) vs sensor LOCAL frame
+  // parameters in TGeoHMatrix convention, for given tracking to local matrix
+  // Result is stored in array deriv as linearized matrix 6x3
   const double kDelta[kNDOFGeom] = {0.1, 0.1, 0.1, 0.5 * DegToRad(), 0.5 * DegToRad(), 0.5 * DegToRad()}; // changed angles to radians
   double delta[kNDOFGeom], pos0[3], pos1[3], pos2[3], pos3[3];
   TGeoHMatrix matMod;
+  const TGeoHMatrix t2li = t2l.Inverse();
+  // variation matrix in tracking frame for variation in sensor LOCAL frame: tau = T2L^-1*delta*T2L
+  auto getDeltaT2L = [&]() {
+    delta2Matrix(matMod, delta);
+    matMod.Multiply(&t2l);
+    matMod.MultiplyLeft(&t2li);
+  };
   //
   memset(delta, 0, kNDOFGeom * sizeof(double));
   memset(deriv, 0, kNDOFGeom * 3 * sizeof(double));
@@ -63,20 +79,19 @@ void AlignableSensor::dPosTraDParGeomLOC(const AlignmentPoint* pnt, double* deri
     //
     double var = kDelta[ip];
     delta[ip] -= var;
-    // variation matrix in tracking frame for variation in sensor LOCAL frame
-    getDeltaT2LmodLOC(matMod, delta);
+    getDeltaT2L();
     matMod.LocalToMaster(tra, pos0); // varied position in tracking frame
     //
     delta[ip] += 0.5 * var;
-    getDeltaT2LmodLOC(matMod, delta);
+    getDeltaT2L();
     matMod.LocalToMaster(tra, pos1); // varied position in tracking frame
     //
     delta[ip] += var;
-    getDeltaT2LmodLOC(matMod, delta);
+    getDeltaT2L();
     matMod.LocalToMaster(tra, pos2); // varied position in tracking frame
     //
     delta[ip] += 0.5 * var;
-    getDeltaT2LmodLOC(matMod, delta);
+    getDeltaT2L();
     matMod.LocalToMaster(tra, pos3); // varied position in tracking frame
     //
     delta[ip] = 0;
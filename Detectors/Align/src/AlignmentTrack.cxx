@@ -14,6 +14,7 @@
 /// @since  2021-02-01
 /// @brief  Track model for the alignment
 
+#include <atomic>
 #include <cstdio>
 #include "Align/AlignmentTrack.h"
 #include "Framework/Logger.h"
@@ -736,7 +737,7 @@ void AlignmentTrack::richardsonDeriv(const trackParam_t* trSet, const double* de
 {
   // Calculate Richardson derivatives for diagonalized Y and Z from a set of kRichardsonN pairs
   // of tracks with same parameter of i-th pair varied by +-delta[i]
-  static double derRichY[kRichardsonN], derRichZ[kRichardsonN];
+  double derRichY[kRichardsonN], derRichZ[kRichardsonN];
   //
   for (int icl = 0; icl < kRichardsonN; icl++) { // calculate kRichardsonN variations with del, del/2, del/4...
     double resYVP = 0, resYVN = 0, resZVP = 0, resZVN = 0;
@@ -1001,7 +1002,7 @@ bool AlignmentTrack::fitLeg(trackParam_t& trc, int pFrom, int pTo, bool& inv)
                          0, 0, 0, kErrAng * kErrAng,
                          0, 0, 0, 0, kErrRelPtI * kErrRelPtI};
   //
-  static int count = 0;
+  static std::atomic<int> count{0};
   const auto& algConf = AlignConfig::Instance();
   if (algConf.verbose > 2) {
     LOGP(info, "FIT COUNT {}", count++);
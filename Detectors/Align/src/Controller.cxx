@@ -57,6 +57,10 @@
 #include "CommonUtils/TreeStreamRedirector.h"
 #include <unordered_map>
 
+#ifdef WITH_OPENMP
+#include <omp.h>
+#endif
+
 using namespace TMath;
 using namespace o2::align::utils;
 using namespace o2::dataformats;
@@ -162,6 +166,94 @@ void Controller::process()
   int nvRefs = primVer2TRefs.size();
   bool fieldON = std::abs(PropagatorD::Instance()->getNominalBz()) > 0.1;
 
+  // The tracks are processed in batches: the points are collected sequentially since the detectors keep the
+  // per-track state, then the fits and derivatives of the batch are computed concurrently and finally the
+  // records are written in the order of the input tracks, so that the output does not depend on the number of threads.
+  const int nThreads = getNThreadsToUse(fieldON);
+  const int batchSize = nThreads > 1 ? nThreads * TracksPerThreadInBatch : 1;
+  int nSlots = 0, lastAccVtxRef = -1;
+
+  auto flushTracks = [&]() {
+    fitTracks(nSlots, nThreads);
+    for (int is = 0; is < nSlots; is++) {
+      auto& slot = mTrackSlots[is];
+      if (!slot.ok) {
+        continue;
+      }
+      swapTrackSlot(slot);
+      auto trackIndex = mAlgTrack->getCurrentTrackID();
+      if (mDebugOutputLevel && mAlgTrackDbg.setTrackParam(mAlgTrack.get())) {
+        mAlgTrackDbg.mGID = trackIndex;
+        (*mDBGOut) << "algtrack"
+                   << "runNumber=" << mTimingInfo.runNumber
+                   << "tfID=" << mTimingInfo.tfCounter
+                   << "orbit=" << mTimingInfo.firstTForbit
+                   << "bz=" << PropagatorD::Instance()->getNominalBz()
+                   << "t=" << mAlgTrackDbg << "\n";
+      }
+      if (mUseMC && mDebugOutputLevel > 1) {
+        auto lbl = mRecoData->getTrackMCLabel(trackIndex);
+        if (lbl.isValid()) {
+          std::vector<float> pntX, pntY, pntZ, trcX, trcY, trcZ, prpX, prpY, prpZ, alpha, xsens, pntXTF, pntYTF, pntZTF, resY, resZ;
+          std::vector<int> detid, volid;
+
+          o2::MCTrack mcTrack = *mcReader.getTrack(lbl);
+          trackParam_t recTrack{*mAlgTrack};
+          for (int ip = 0; ip < mAlgTrack->getNPoints(); ip++) {
+            double tmp[3], tmpg[3];
+            auto* pnt = mAlgTrack->getPoint(ip);
+            auto* sens = pnt->getSensor();
+            detid.emplace_back(pnt->getDetID());
+            volid.emplace_back(pnt->getVolID());
+            TGeoHMatrix t2g;
+            sens->getMatrixT2G(t2g);
+            t2g.LocalToMaster(pnt->getXYZTracking(), tmpg);
+            pntX.emplace_back(tmpg[0]);
+            pntY.emplace_back(tmpg[1]);
+            pntZ.emplace_back(tmpg[2]);
+            double xyz[3]{pnt->getXTracking(), pnt->getYTracking(), pnt->getZTracking()};
+            xyz[1] += mAlgTrack->getResidual(0, ip);
+            xyz[2] += mAlgTrack->getResidual(1, ip);
+            t2g.LocalToMaster(xyz, tmpg);
+            trcX.emplace_back(tmpg[0]);
+            trcY.emplace_back(tmpg[1]);
+            trcZ.emplace_back(tmpg[2]);
+
+            pntXTF.emplace_back(pnt->getXTracking());
+            pntYTF.emplace_back(pnt->getYTracking());
+            pntZTF.emplace_back(pnt->getZTracking());
+            resY.emplace_back(mAlgTrack->getResidual(0, ip));
+            resZ.emplace_back(mAlgTrack->getResidual(1, ip));
+
+            alpha.emplace_back(pnt->getAlphaSens());
+            xsens.emplace_back(pnt->getXSens());
+          }
+          (*mDBGOut) << "mccomp"
+                     << "mcTr=" << mcTrack << "recTr=" << recTrack << "gid=" << trackIndex << "lbl=" << lbl << "vtxConst=" << slot.vtxCont
+                     << "pntX=" << pntX << "pntY=" << pntY << "pntZ=" << pntZ
+                     << "trcX=" << trcX << "trcY=" << trcY << "trcZ=" << trcZ
+                     << "alp=" << alpha << "xsens=" << xsens
+                     << "pntXTF=" << pntXTF << "pntYTF=" << pntYTF << "pntZTF=" << pntZTF
+                     << "resY=" << resY << "resZ=" << resZ
+                     << "detid=" << detid << "volid=" << volid << "\n";
+        }
+      }
+      mStat.data[ProcStat::kAccepted][ProcStat::kTracks]++;
+      if (slot.vtxCont) {
+        mStat.data[ProcStat::kAccepted][ProcStat::kTracksWithVertex]++;
+      }
+      nTrcAcc++;
+      if (slot.vtxRef != lastAccVtxRef) {
+        lastAccVtxRef = slot.vtxRef;
+        mStat.data[ProcStat::kAccepted][ProcStat::kVertices]++;
+        nVtxAcc++;
+      }
+      storeProcessedTrack(trackIndex);
+      swapTrackSlot(slot);
+    }
+    nSlots = 0;
+  };
+
   for (int ivref = 0; ivref < nvRefs; ivref++) {
     const o2::dataformats::PrimaryVertex* vtx = (ivref < nvRefs - 1) ? &primVertices[ivref] : nullptr;
     bool useVertexConstrain = false;
@@ -179,7 +271,6 @@ void Controller::process()
       LOGP(info, "processing vtref {} of {} with {} tracks, {}", ivref, nvRefs, trackRef.getEntries(), vtx ? vtx->asString() : std::string{});
     }
     nVtx++;
-    bool newVtx = true;
     for (int src : mTrackSources) {
       if ((GIndex::getSourceDetectorsMask(src) & mDetMask).none()) { // do we need this source?
         continue;
@@ -187,8 +278,6 @@ void Controller::process()
       int start = trackRef.getFirstEntryOfSource(src), end = start + trackRef.getEntriesOfSource(src);
       for (int ti = start; ti < end; ti++) {
         auto trackIndex = primVerGIs[ti];
-        mAlgTrack->setCurrentTrackID(trackIndex);
-        bool tpcIn = false;
         if (trackIndex.isAmbiguous()) {
           auto& ambSeen = ambigTable[trackIndex];
           if (ambSeen) { // processed
@@ -200,214 +289,205 @@ void Controller::process()
         if (vtx) {
           mStat.data[ProcStat::kInput][ProcStat::kTracksWithVertex]++;
         }
-        int npnt = 0;
-        auto contributorsGID = mRecoData->getSingleDetectorRefs(trackIndex);
-
-        std::string trComb;
-        for (int ig = 0; ig < GIndex::NSources; ig++) {
-          if (contributorsGID[ig].isIndexSet()) {
-            trComb += " " + contributorsGID[ig].asString();
-          }
-        }
-        if (algConf.verbose > 1) {
-          LOG(info) << "processing track " << trackIndex.asString() << " contributors: " << trComb;
-        }
-        resetForNextTrack();
         nTrc++;
-        // RS const auto& trcOut = mRecoData->getTrackParamOut(trackIndex);
-        auto trcOut = mRecoData->getTrackParamOut(trackIndex);
-        const auto& trcIn = mRecoData->getTrackParam(trackIndex);
-        // check detectors contributions
-        AlignableDetector* det = nullptr;
-        int ndet = 0, npntDet = 0;
-
-        if ((det = getDetector(DetID::ITS))) {
-          if (contributorsGID[GIndex::ITS].isIndexSet() && (npntDet = det->processPoints(contributorsGID[GIndex::ITS], algConf.minITSClusters, false)) > 0) {
-            npnt += npntDet;
-            ndet++;
-          } else if (mAllowAfterburnerTracks && contributorsGID[GIndex::ITSAB].isIndexSet() && (npntDet = det->processPoints(contributorsGID[GIndex::ITSAB], 2, false)) > 0) {
-            npnt += npntDet;
-            ndet++;
-          } else {
-            continue;
-          }
+        if (nSlots == (int)mTrackSlots.size()) {
+          auto& slot = mTrackSlots.emplace_back();
+          slot.track = std::make_unique<AlignmentTrack>();
+          slot.refPoint = std::make_unique<AlignmentPoint>();
         }
-        if ((det = getDetector(DetID::TPC)) && contributorsGID[GIndex::TPC].isIndexSet()) {
-          float t0 = 0, t0err = 0;
-          mRecoData->getTrackTime(trackIndex, t0, t0err);
-          ((AlignableDetectorTPC*)det)->setTrackTimeStamp(t0);
-          npntDet = det->processPoints(contributorsGID[GIndex::TPC], algConf.minTPCClusters, false);
-          if (npntDet > 0) {
-            npnt += npntDet;
-            ndet++;
-            tpcIn = true;
-          }
-        }
-
-        if ((det = getDetector(DetID::TRD)) && contributorsGID[GIndex::TRD].isIndexSet() && (npntDet = det->processPoints(contributorsGID[GIndex::TRD], algConf.minTRDTracklets, false)) > 0) {
-          npnt += npntDet;
-          ndet++;
+        auto& slot = mTrackSlots[nSlots];
+        slot.vtxRef = ivref;
+        swapTrackSlot(slot);
+        bool ok = prepareTrack(trackIndex, vtx, useVertexConstrain, fieldON, slot);
+        swapTrackSlot(slot);
+        if (ok && ++nSlots == batchSize) {
+          flushTracks();
         }
-        if ((det = getDetector(DetID::TOF)) && contributorsGID[GIndex::TOF].isIndexSet() && (npntDet = det->processPoints(contributorsGID[GIndex::TOF], algConf.minTOFClusters, false)) > 0) {
-          npnt += npntDet;
-          ndet++;
-        }
-        // other detectors
-        if (algConf.verbose > 1) {
-          LOGP(info, "processing track {} {} of vtref {}, Ndets:{}, Npoints: {}, use vertex: {} | Kin: {} Kout: {}", ti, trackIndex.asString(), ivref, ndet, npnt, useVertexConstrain && trackIndex.isPVContributor(), trcIn.asString(), trcOut.asString());
-        }
-        if (ndet < algConf.minDetectors || (tpcIn && ndet == 1)) { // we don't want TPC only track
-          continue;
-        }
-        if (npnt < algConf.minPointTotal) {
-          if (algConf.verbose > 0) {
-            LOGP(info, "too few points {} < {}", npnt, algConf.minPointTotal);
-          }
-          continue;
-        }
-        bool vtxCont = false;
-        if (trackIndex.isPVContributor() && useVertexConstrain) {
-          mAlgTrack->copyFrom(trcIn); // copy kinematices of inner track just for propagation to the vertex
-          if (addVertexConstraint(*vtx)) {
-            mAlgTrack->setRefPoint(mRefPoint.get()); // set vertex as a reference point
-            vtxCont = true;
-          }
-        }
-        mAlgTrack->copyFrom(trcOut); // copy kinematices of outer track as the refit will be done inward
-        mAlgTrack->setFieldON(fieldON);
-        mAlgTrack->sortPoints();
-
-        int pntMeas = mAlgTrack->getInnerPointID() - 1;
-        if (pntMeas < 0) { // this should not happen
-          mAlgTrack->Print("p meas");
-          LOG(error) << "AliAlgTrack->GetInnerPointID() cannot be 0";
-        }
-        if (!mAlgTrack->iniFit()) {
-          if (algConf.verbose > 0) {
-            LOGP(warn, "iniFit failed");
-          }
-          continue;
-        }
-        // compare refitted and original track
-        if (mDebugOutputLevel) {
-          trackParam_t trcAlgRef(*mAlgTrack.get());
-          std::array<double, 5> dpar{};
-          std::array<double, 15> dcov{};
-          for (int i = 0; i < 5; i++) {
-            dpar[i] = trcIn.getParam(i);
-          }
-          for (int i = 0; i < 15; i++) {
-            dcov[i] = trcIn.getCov()[i];
-          }
-          trackParam_t trcOrig(trcIn.getX(), trcIn.getAlpha(), dpar, dcov, trcIn.getCharge());
-          if (PropagatorD::Instance()->propagateToAlphaX(trcOrig, trcAlgRef.getAlpha(), trcAlgRef.getX(), true)) {
-            (*mDBGOut) << "trcomp"
-                       << "orig=" << trcOrig << "fit=" << trcAlgRef << "\n";
-          }
-        }
-        // RS: this is to substitute the refitter track by MC truth, just for debugging
-        /*
-        if (mUseMC) {
-          auto lbl = mRecoData->getTrackMCLabel(trackIndex);
-          if (lbl.isValid()) {
-            o2::MCTrack mcTrack = *mcReader.getTrack(lbl);
-            std::array<float,3> xyz{(float)mcTrack.GetStartVertexCoordinatesX(),(float)mcTrack.GetStartVertexCoordinatesY(),(float)mcTrack.GetStartVertexCoordinatesZ()},
-              pxyz{(float)mcTrack.GetStartVertexMomentumX(),(float)mcTrack.GetStartVertexMomentumY(),(float)mcTrack.GetStartVertexMomentumZ()};
-            std::array<float,21> cv21{10., 0.,10., 0.,0.,10., 0.,0.,0.,1.,   0.,0.,0.,0.,1., 0.,0.,0.,0.,0.,1.};
-            trcOut.set(xyz, pxyz, cv21, trcOut.getSign(), false);
-            mAlgTrack->copyFrom(trcOut);
-          }
-        }
-        */
-        if (!mAlgTrack->processMaterials()) {
-          if (algConf.verbose > 0) {
-            LOGP(warn, "processMaterials failed");
-          }
-          continue;
-        }
-        mAlgTrack->defineDOFs();
-        if (!mAlgTrack->calcResidDeriv()) {
-          if (algConf.verbose > 0) {
-            LOGP(warn, "calcResidDeriv failed");
-          }
-          continue;
-        }
-        if (mDebugOutputLevel && mAlgTrackDbg.setTrackParam(mAlgTrack.get())) {
-          mAlgTrackDbg.mGID = trackIndex;
-          (*mDBGOut) << "algtrack"
-                     << "runNumber=" << mTimingInfo.runNumber
-                     << "tfID=" << mTimingInfo.tfCounter
-                     << "orbit=" << mTimingInfo.firstTForbit
-                     << "bz=" << PropagatorD::Instance()->getNominalBz()
-                     << "t=" << mAlgTrackDbg << "\n";
-        }
-        if (mUseMC && mDebugOutputLevel > 1) {
-          auto lbl = mRecoData->getTrackMCLabel(trackIndex);
-          if (lbl.isValid()) {
-            std::vector<float> pntX, pntY, pntZ, trcX, trcY, trcZ, prpX, prpY, prpZ, alpha, xsens, pntXTF, pntYTF, pntZTF, resY, resZ;
-            std::vector<int> detid, volid;
-
-            o2::MCTrack mcTrack = *mcReader.getTrack(lbl);
-            trackParam_t recTrack{*mAlgTrack};
-            for (int ip = 0; ip < mAlgTrack->getNPoints(); ip++) {
-              double tmp[3], tmpg[3];
-              auto* pnt = mAlgTrack->getPoint(ip);
-              auto* sens = pnt->getSensor();
-              detid.emplace_back(pnt->getDetID());
-              volid.emplace_back(pnt->getVolID());
-              TGeoHMatrix t2g;
-              sens->getMatrixT2G(t2g);
-              t2g.LocalToMaster(pnt->getXYZTracking(), tmpg);
-              pntX.emplace_back(tmpg[0]);
-              pntY.emplace_back(tmpg[1]);
-              pntZ.emplace_back(tmpg[2]);
-              double xyz[3]{pnt->getXTracking(), pnt->getYTracking(), pnt->getZTracking()};
-              xyz[1] += mAlgTrack->getResidual(0, ip);
-              xyz[2] += mAlgTrack->getResidual(1, ip);
-              t2g.LocalToMaster(xyz, tmpg);
-              trcX.emplace_back(tmpg[0]);
-              trcY.emplace_back(tmpg[1]);
-              trcZ.emplace_back(tmpg[2]);
-
-              pntXTF.emplace_back(pnt->getXTracking());
-              pntYTF.emplace_back(pnt->getYTracking());
-              pntZTF.emplace_back(pnt->getZTracking());
-              resY.emplace_back(mAlgTrack->getResidual(0, ip));
-              resZ.emplace_back(mAlgTrack->getResidual(1, ip));
-
-              alpha.emplace_back(pnt->getAlphaSens());
-              xsens.emplace_back(pnt->getXSens());
-            }
-            (*mDBGOut) << "mccomp"
-                       << "mcTr=" << mcTrack << "recTr=" << recTrack << "gid=" << trackIndex << "lbl=" << lbl << "vtxConst=" << vtxCont
-                       << "pntX=" << pntX << "pntY=" << pntY << "pntZ=" << pntZ
-                       << "trcX=" << trcX << "trcY=" << trcY << "trcZ=" << trcZ
-                       << "alp=" << alpha << "xsens=" << xsens
-                       << "pntXTF=" << pntXTF << "pntYTF=" << pntYTF << "pntZTF=" << pntZTF
-                       << "resY=" << resY << "resZ=" << resZ
-                       << "detid=" << detid << "volid=" << volid << "\n";
-          }
-        }
-        mStat.data[ProcStat::kAccepted][ProcStat::kTracks]++;
-        if (vtxCont) {
-          mStat.data[ProcStat::kAccepted][ProcStat::kTracksWithVertex]++;
-        }
-        nTrcAcc++;
-        if (newVtx) {
-          newVtx = false;
-          mStat.data[ProcStat::kAccepted][ProcStat::kVertices]++;
-          nVtxAcc++;
-        }
-        storeProcessedTrack(trackIndex);
       }
     }
   }
+  flushTracks();
   auto timerEnd = std::chrono::system_clock::now();
   std::chrono::duration<float, std::milli> duration = timerEnd - timerStart;
-  LOGP(info, "Processed TF {}: {} vertices ({} used), {} tracks ({} used) in {} ms", mNTF, nVtx, nVtxAcc, nTrc, nTrcAcc, duration.count());
+  LOGP(info, "Processed TF {}: {} vertices ({} used), {} tracks ({} used) in {} ms with {} thread(s)", mNTF, nVtx, nVtxAcc, nTrc, nTrcAcc, duration.count(), nThreads);
   mNTF++;
 }
 
+//________________________________________________________________
+bool Controller::prepareTrack(GTrackID trackIndex, const o2::dataformats::PrimaryVertex* vtx, bool useVertexConstrain, bool fieldON, TrackSlot& slot)
+{
+  // collect the points of the track into the current mAlgTrack and set its reference kinematics,
+  // return false if the track is rejected
+  const auto& algConf = AlignConfig::Instance();
+  resetForNextTrack();
+  mAlgTrack->setCurrentTrackID(trackIndex);
+  bool tpcIn = false;
+  int npnt = 0;
+  auto contributorsGID = mRecoData->getSingleDetectorRefs(trackIndex);
+
+  if (algConf.verbose > 1) {
+    std::string trComb;
+    for (int ig = 0; ig < GIndex::NSources; ig++) {
+      if (contributorsGID[ig].isIndexSet()) {
+        trComb += " " + contributorsGID[ig].asString();
+      }
+    }
+    LOG(info) << "processing track " << trackIndex.asString() << " contributors: " << trComb;
+  }
+  // RS const auto& trcOut = mRecoData->getTrackParamOut(trackIndex);
+  auto trcOut = mRecoData->getTrackParamOut(trackIndex);
+  const auto& trcIn = mRecoData->getTrackParam(trackIndex);
+  // check detectors contributions
+  AlignableDetector* det = nullptr;
+  int ndet = 0, npntDet = 0;
+
+  if ((det = getDetector(DetID::ITS))) {
+    if (contributorsGID[GIndex::ITS].isIndexSet() && (npntDet = det->processPoints(contributorsGID[GIndex::ITS], algConf.minITSClusters, false)) > 0) {
+      npnt += npntDet;
+      ndet++;
+    } else if (mAllowAfterburnerTracks && contributorsGID[GIndex::ITSAB].isIndexSet() && (npntDet = det->processPoints(contributorsGID[GIndex::ITSAB], 2, false)) > 0) {
+      npnt += npntDet;
+      ndet++;
+    } else {
+      return false;
+    }
+  }
+  if ((det = getDetector(DetID::TPC)) && contributorsGID[GIndex::TPC].isIndexSet()) {
+    float t0 = 0, t0err = 0;
+    mRecoData->getTrackTime(trackIndex, t0, t0err);
+    ((AlignableDetectorTPC*)det)->setTrackTimeStamp(t0);
+    npntDet = det->processPoints(contributorsGID[GIndex::TPC], algConf.minTPCClusters, false);
+    if (npntDet > 0) {
+      npnt += npntDet;
+      ndet++;
+      tpcIn = true;
+    }
+  }
+
+  if ((det = getDetector(DetID::TRD)) && contributorsGID[GIndex::TRD].isIndexSet() && (npntDet = det->processPoints(contributorsGID[GIndex::TRD], algConf.minTRDTracklets, false)) > 0) {
+    npnt += npntDet;
+    ndet++;
+  }
+  if ((det = getDetector(DetID::TOF)) && contributorsGID[GIndex::TOF].isIndexSet() && (npntDet = det->processPoints(contributorsGID[GIndex::TOF], algConf.minTOFClusters, false)) > 0) {
+    npnt += npntDet;
+    ndet++;
+  }
+  // other detectors
+  if (algConf.verbose > 1) {
+    LOGP(info, "processing track {} of vtref {}, Ndets:{}, Npoints: {}, use vertex: {} | Kin: {} Kout: {}", trackIndex.asString(), slot.vtxRef, ndet, npnt, useVertexConstrain && trackIndex.isPVContributor(), trcIn.asString(), trcOut.asString());
+  }
+  if (ndet < algConf.minDetectors || (tpcIn && ndet == 1)) { // we don't want TPC only track
+    return false;
+  }
+  if (npnt < algConf.minPointTotal) {
+    if (algConf.verbose > 0) {
+      LOGP(info, "too few points {} < {}", npnt, algConf.minPointTotal);
+    }
+    return false;
+  }
+  slot.vtxCont = false;
+  if (trackIndex.isPVContributor() && useVertexConstrain) {
+    mAlgTrack->copyFrom(trcIn); // copy kinematices of inner track just for propagation to the vertex
+    if (addVertexConstraint(*vtx)) {
+      mAlgTrack->setRefPoint(mRefPoint.get()); // set vertex as a reference point
+      slot.vtxCont = true;
+    }
+  }
+  mAlgTrack->copyFrom(trcOut); // copy kinematices of outer track as the refit will be done inward
+  mAlgTrack->setFieldON(fieldON);
+  mAlgTrack->sortPoints();
+
+  int pntMeas = mAlgTrack->getInnerPointID() - 1;
+  if (pntMeas < 0) { // this should not happen
+    mAlgTrack->Print("p meas");
+    LOG(error) << "AliAlgTrack->GetInnerPointID() cannot be 0";
+  }
+  slot.trcIn = &trcIn;
+  return true;
+}
+
+//________________________________________________________________
+bool Controller::fitTrack(TrackSlot& slot) const
+{
+  // refit the track and calculate residuals and derivatives. Only the slot workspace is modified,
+  // so that different slots can be processed concurrently
+  const auto& algConf = AlignConfig::Instance();
+  auto& algTrack = *slot.track;
+  if (!algTrack.iniFit()) {
+    if (algConf.verbose > 0) {
+      LOGP(warn, "iniFit failed");
+    }
+    return false;
+  }
+  // compare refitted and original track, the debug output is produced only in the single-thread mode
+  if (mDebugOutputLevel) {
+    const auto& trcIn = *slot.trcIn;
+    trackParam_t trcAlgRef(algTrack);
+    std::array<double, 5> dpar{};
+    std::array<double, 15> dcov{};
+    for (int i = 0; i < 5; i++) {
+      dpar[i] = trcIn.getParam(i);
+    }
+    for (int i = 0; i < 15; i++) {
+      dcov[i] = trcIn.getCov()[i];
+    }
+    trackParam_t trcOrig(trcIn.getX(), trcIn.getAlpha(), dpar, dcov, trcIn.getCharge());
+    if (PropagatorD::Instance()->propagateToAlphaX(trcOrig, trcAlgRef.getAlpha(), trcAlgRef.getX(), true)) {
+      (*mDBGOut) << "trcomp"
+                 << "orig=" << trcOrig << "fit=" << trcAlgRef << "\n";
+    }
+  }
+  if (!algTrack.processMaterials()) {
+    if (algConf.verbose > 0) {
+      LOGP(warn, "processMaterials failed");
+    }
+    return false;
+  }
+  algTrack.defineDOFs();
+  if (!algTrack.calcResidDeriv()) {
+    if (algConf.verbose > 0) {
+      LOGP(warn, "calcResidDeriv failed");
+    }
+    return false;
+  }
+  return true;
+}
+
+//________________________________________________________________
+void Controller::fitTracks(int nSlots, int nThreads)
+{
+#ifdef WITH_OPENMP
+#pragma omp parallel for schedule(dynamic) num_threads(nThreads)
+#endif
+  for (int is = 0; is < nSlots; is++) {
+    mTrackSlots[is].ok = fitTrack(mTrackSlots[is]);
+  }
+}
+
+//________________________________________________________________
+int Controller::getNThreadsToUse(bool fieldON) const
+{
+  // the tracks are fitted concurrently only if the propagation does not use thread-unsafe TGeo navigation
+  // or full field map, and no debug output is requested
+  const auto& algConf = AlignConfig::Instance();
+  const auto* prop = PropagatorD::Instance();
+  if (algConf.nThreads < 2 || mDebugOutputLevel ||
+      algConf.matCorType == (int)MatCorrType::USEMatCorrTGeo || (algConf.matCorType == (int)MatCorrType::USEMatCorrLUT && !prop->getMatLUT()) ||
+      (fieldON && !prop->hasFastFieldSet())) {
+    return 1;
+  }
+  return algConf.nThreads;
+}
+
+//________________________________________________________________
+void Controller::swapTrackSlot(TrackSlot& slot)
+{
+  // exchange the current track and reference point with those of the slot, so that the detectors and the output methods,
+  // which work with mAlgTrack and mRefPoint, act on the slot
+  std::swap(mAlgTrack, slot.track);
+  std::swap(mRefPoint, slot.refPoint);
+}
+
 //________________________________________________________________
 void Controller::processCosmic()
 {
@@ -51,6 +51,16 @@ void EventVertex::prepareMatrixT2L()
   //
 }
 
+//____________________________________________
+void EventVertex::dPosTraDParGeomLOC(const AlignmentPoint* pnt, double* deriv) const
+{
+  // derivatives vs LOCAL frame parameters with the T2L matrix of the track the point belongs to,
+  // the tracks with vertex constraint may be processed concurrently
+  TGeoHMatrix t2l;
+  t2l.RotateZ(pnt->getAlphaSens() * RadToDeg());
+  AlignableSensor::dPosTraDParGeomLOC(pnt, deriv, t2l);
+}
+
 //____________________________________________
 void EventVertex::applyCorrection(double* vtx) const
 {
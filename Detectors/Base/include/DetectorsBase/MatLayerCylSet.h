@@ -47,6 +47,15 @@ struct MatLayerCylSetLayout {
   int* mInterval2LrID;  //[mNRIntervals] mapping from r2 interval to layer ID
 };
 
+/// cell of the material LUT containing the end point of the last query of a track, used for the incremental stepping
+struct MatBudgetCache {
+  short layer = -1; ///< layer ID, -1 if the point was not in a layer
+  int phiSlice = -1;
+  int phiBin = -1;
+  int zBin = -1;
+  float x = 0.f, y = 0.f, z = 0.f; ///< the point, a ray starting from it reuses the cell without searching it again
+};
+
 class MatLayerCylSet : public o2::gpu::FlatObject
 {
 
@@ -101,6 +110,16 @@ class MatLayerCylSet : public o2::gpu::FlatObject
 #endif // !GPUCA_ALIGPUCODE
   GPUd() MatBudget getMatBudget(float x0, float y0, float z0, float x1, float y1, float z1) const;
 
+  /// same as above, but if both points are in the cell where the previous ray of the track ended, the cell is used
+  /// directly without tracing the ray through the layers. The cache is updated with the cell of the end point
+  GPUd() MatBudget getMatBudget(float x0, float y0, float z0, float x1, float y1, float z1, MatBudgetCache& cache) const;
+
+  /// material budget for n rays given in SoA form; consecutive rays are expected to be steps of the same track
+  GPUd() void getMatBudget(int n, const float* x0, const float* y0, const float* z0, const float* x1, const float* y1, const float* z1, MatBudget* res) const;
+
+  /// finds the layer cell containing the point, returns false if the point is outside of all layers
+  GPUd() bool findCell(float x, float y, float z, MatBudgetCache& cell) const;
+
   GPUd() int searchSegment(float val, int low = -1, int high = -1) const;
 
   /// searches a layer based on r2 input, using a lookup table
@@ -135,6 +135,7 @@ class PropagatorImpl
   GPUd() const o2::gpu::GPUTPCGMPolynomialField* getGPUField() const { return mGPUField; }
   GPUd() void setNominalBz(value_type bz) { mNominalBz = bz; }
   GPUd() bool hasMagFieldSet() const { return mField != nullptr; }
+  GPUd() bool hasFastFieldSet() const { return mFieldFast != nullptr; }
 
   GPUd() value_type estimateLTFast(o2::track::TrackLTIntegral& lt, const o2::track::TrackParametrization<value_type>& trc) const;
   GPUd() float estimateLTIncrement(const o2::track::TrackParametrization<value_type>& trc, const o2::math_utils::Point3D<value_type>& postStart, const o2::math_utils::Point3D<value_type>& posEnd) const;
@@ -152,6 +153,8 @@ class PropagatorImpl
 #endif
 
   GPUd() MatBudget getMatBudget(MatCorrType corrType, const o2::math_utils::Point3D<value_type>& p0, const o2::math_utils::Point3D<value_type>& p1) const;
+  /// same as above, using the cache of the LUT cell reached by the previous step of the track
+  GPUd() MatBudget getMatBudget(MatCorrType corrType, const o2::math_utils::Point3D<value_type>& p0, const o2::math_utils::Point3D<value_type>& p1, MatBudgetCache& cache) const;
 
   GPUd() void getFieldXYZ(const math_utils::Point3D<float> xyz, float* bxyz) const;
 
@@ -0,0 +1,76 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+/// \file PropagatorBatch.h
+/// \brief Propagation of pools of tracks to a common reference
+
+#ifndef ALICEO2_BASE_PROPAGATORBATCH_
+#define ALICEO2_BASE_PROPAGATORBATCH_
+
+#include "DetectorsBase/Propagator.h"
+#include <cstdint>
+#include <vector>
+#include <gsl/span>
+
+namespace o2
+{
+namespace base
+{
+
+/// Propagates a pool of tracks to a common X or radius with the same field and material settings as
+/// PropagatorImpl, which is used for the single-track transport.
+/// The tracks are processed by several threads when the field and material queries are thread safe,
+/// i.e. for the Bz-only propagation or with the fast field map, and without the TGeo material queries.
+template <typename value_T>
+class PropagatorBatchImpl
+{
+ public:
+  using value_type = value_T;
+  using Propagator_t = PropagatorImpl<value_type>;
+  using MatCorrType = typename Propagator_t::MatCorrType;
+  using TrackParCov_t = track::TrackParametrizationWithError<value_type>;
+
+  explicit PropagatorBatchImpl(const Propagator_t* prop = Propagator_t::Instance()) : mPropagator(prop) {}
+
+  void setNThreads(int n) { mNThreads = n > 0 ? n : 1; }
+  int getNThreads() const { return mNThreads; }
+
+  /// propagate every track to X in its own frame, return the number of successfully propagated tracks.
+  /// If provided, status is set to 1 for these tracks and to 0 for the others, which are left where their
+  /// propagation stopped, as with the single-track propagation
+  size_t propagateToX(gsl::span<TrackParCov_t> tracks, value_type x, bool bzOnly = false, value_type maxSnp = Propagator_t::MAX_SIN_PHI,
+                      value_type maxStep = Propagator_t::MAX_STEP, MatCorrType matCorr = MatCorrType::USEMatCorrLUT,
+                      std::vector<uint8_t>* status = nullptr) const;
+
+  /// propagate every track to the radius r in the lab frame, keeping its own frame
+  size_t propagateToR(gsl::span<TrackParCov_t> tracks, value_type r, bool bzOnly = false, value_type maxSnp = Propagator_t::MAX_SIN_PHI,
+                      value_type maxStep = Propagator_t::MAX_STEP, MatCorrType matCorr = MatCorrType::USEMatCorrLUT,
+                      std::vector<uint8_t>* status = nullptr) const;
+
+  /// number of threads which will be used for given settings
+  int getNThreadsFor(bool bzOnly, MatCorrType matCorr) const;
+
+ private:
+  template <typename F>
+  size_t process(gsl::span<TrackParCov_t> tracks, int nThreads, std::vector<uint8_t>* status, F&& propagate) const;
+
+  const Propagator_t* mPropagator = nullptr;
+  int mNThreads = 1;
+};
+
+using PropagatorBatchF = PropagatorBatchImpl<float>;
+using PropagatorBatchD = PropagatorBatchImpl<double>;
+using PropagatorBatch = PropagatorBatchF;
+
+} // namespace base
+} // namespace o2
+
+#endif
@@ -402,6 +402,90 @@ GPUd() MatBudget MatLayerCylSet::getMatBudget(float x0, float y0, float z0, floa
   return rval;
 }
 
+//_________________________________________________________________________________________________
+GPUd() MatBudget MatLayerCylSet::getMatBudget(float x0, float y0, float z0, float x1, float y1, float z1, MatBudgetCache& cache) const
+{
+  // get material budget traversed on the line between point0 and point1, checking first if both points are
+  // in the cell where the previous step of the track ended
+  MatBudgetCache cell0 = cache;
+  if (x0 != cache.x || y0 != cache.y || z0 != cache.z) { // not a continuation of the previous step
+    findCell(x0, y0, z0, cell0);
+  }
+  findCell(x1, y1, z1, cache); // the cell of the end point is the start cell of the next step
+  if (cell0.layer >= 0 && cell0.layer == cache.layer && cell0.phiSlice == cache.phiSlice && cell0.zBin == cache.zBin) {
+    // z bins are convex, the layer is not: the chord must not dip below its inner radius
+    const auto& lr = getLayer(cache.layer);
+    float dx = x1 - x0, dy = y1 - y0, dz = z1 - z0, dxy2 = dx * dx + dy * dy;
+    float t = dxy2 > Ray::Tiny ? -(x0 * dx + y0 * dy) / dxy2 : 0.f;
+    t = t < 0.f ? 0.f : (t > 1.f ? 1.f : t);
+    float xc = x0 + t * dx, yc = y0 + t * dy, dist = o2::gpu::CAMath::Sqrt(dxy2 + dz * dz);
+    if (xc * xc + yc * yc >= lr.getRMin2() && dist >= Ray::MinDistToConsider) {
+      // phi slices merged by MatLayerCyl::optimizePhiSlices may span more than pi: the chord sweeps the shorter
+      // arc between its end points, all phi bins of this arc must belong to the slice
+      int nPhiBins = lr.getNPhiBins(), dBin = cache.phiBin - cell0.phiBin;
+      if (2 * dBin > nPhiBins) {
+        dBin -= nPhiBins;
+      } else if (2 * dBin < -nPhiBins) {
+        dBin += nPhiBins;
+      }
+      int step = dBin > 0 ? 1 : -1, ib = cell0.phiBin;
+      bool inSlice = true;
+      for (int i = 0; i < dBin * step && inSlice; i++) {
+        ib += step;
+        ib = ib < 0 ? ib + nPhiBins : (ib >= nPhiBins ? ib - nPhiBins : ib);
+        inSlice = lr.phiBin2Slice(ib) == cache.phiSlice;
+      }
+      if (inSlice) {
+        MatBudget rval;
+        const auto& matCell = lr.getCell(cache.phiSlice, cache.zBin);
+        rval.meanRho = matCell.meanRho;
+        rval.meanX2X0 = matCell.meanX2X0 * dist;
+        rval.length = dist;
+        return rval;
+      }
+    }
+  }
+  return getMatBudget(x0, y0, z0, x1, y1, z1);
+}
+
+//_________________________________________________________________________________________________
+GPUd() void MatLayerCylSet::getMatBudget(int n, const float* x0, const float* y0, const float* z0, const float* x1, const float* y1, const float* z1, MatBudget* res) const
+{
+  MatBudgetCache cache;
+  for (int i = 0; i < n; i++) {
+    res[i] = getMatBudget(x0[i], y0[i], z0[i], x1[i], y1[i], z1[i], cache);
+  }
+}
+
+//_________________________________________________________________________________________________
+GPUd() bool MatLayerCylSet::findCell(float x, float y, float z, MatBudgetCache& cell) const
+{
+  cell.layer = -1;
+  cell.x = x;
+  cell.y = y;
+  cell.z = z;
+  float r2 = x * x + y * y;
+  if (r2 < getRMin2() || r2 >= getRMax2()) {
+    return false;
+  }
+  int interval = mInitializedLayerVoxelLU ? searchLayerFast(r2, 0) : searchSegment(r2, 0);
+  int lrID = get()->mInterval2LrID[interval];
+  if (lrID < 0) { // in the gap between layers
+    return false;
+  }
+  const auto& lr = getLayer(lrID);
+  if (lr.isZOutside(z) != MatLayerCyl::Within) {
+    return false;
+  }
+  float phi = o2::gpu::CAMath::ATan2(y, x);
+  o2::math_utils::bringTo02Pi(phi);
+  cell.layer = lrID;
+  cell.phiBin = lr.getPhiBinID(phi);
+  cell.phiSlice = lr.phiBin2Slice(cell.phiBin);
+  cell.zBin = lr.getZBinID(z);
+  return true;
+}
+
 //_________________________________________________________________________________________________
 GPUd() bool MatLayerCylSet::getLayersRange(const Ray& ray, short& lmin, short& lmax) const
 {
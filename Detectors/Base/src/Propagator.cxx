@@ -171,6 +171,7 @@ GPUd() bool PropagatorImpl<value_T>::PropagateToXBxByBz(TrackParCov_t& track, va
   }
 
   gpu::gpustd::array<value_type, 3> b{};
+  MatBudgetCache matCache; // consecutive steps of the track are likely to stay in the same LUT cell
   while (math_utils::detail::abs<value_type>(dx) > Epsilon) {
     auto step = math_utils::detail::min<value_type>(math_utils::detail::abs<value_type>(dx), maxStep);
     if (dir < 0) {
@@ -180,11 +181,11 @@ GPUd() bool PropagatorImpl<value_T>::PropagateToXBxByBz(TrackParCov_t& track, va
     auto xyz0 = track.getXYZGlo();
     getFieldXYZ(xyz0, &b[0]);
 
-    auto correct = [&track, &xyz0, tofInfo, matCorr, signCorr, this]() {
+    auto correct = [&track, &xyz0, &matCache, tofInfo, matCorr, signCorr, this]() {
       bool res = true;
       if (matCorr != MatCorrType::USEMatCorrNONE) {
         auto xyz1 = track.getXYZGlo();
-        auto mb = this->getMatBudget(matCorr, xyz0, xyz1);
+        auto mb = this->getMatBudget(matCorr, xyz0, xyz1, matCache);
         if (!track.correctForMaterial(mb.meanX2X0, mb.getXRho(signCorr))) {
           res = false;
         }
@@ -240,6 +241,7 @@ GPUd() bool PropagatorImpl<value_T>::PropagateToXBxByBz(TrackPar_t& track, value
   }
 
   gpu::gpustd::array<value_type, 3> b{};
+  MatBudgetCache matCache; // consecutive steps of the track are likely to stay in the same LUT cell
   while (math_utils::detail::abs<value_type>(dx) > Epsilon) {
     auto step = math_utils::detail::min<value_type>(math_utils::detail::abs<value_type>(dx), maxStep);
     if (dir < 0) {
@@ -249,11 +251,11 @@ GPUd() bool PropagatorImpl<value_T>::PropagateToXBxByBz(TrackPar_t& track, value
     auto xyz0 = track.getXYZGlo();
     getFieldXYZ(xyz0, &b[0]);
 
-    auto correct = [&track, &xyz0, tofInfo, matCorr, signCorr, this]() {
+    auto correct = [&track, &xyz0, &matCache, tofInfo, matCorr, signCorr, this]() {
       bool res = true;
       if (matCorr != MatCorrType::USEMatCorrNONE) {
         auto xyz1 = track.getXYZGlo();
-        auto mb = this->getMatBudget(matCorr, xyz0, xyz1);
+        auto mb = this->getMatBudget(matCorr, xyz0, xyz1, matCache);
         if (!track.correctForELoss(((signCorr < 0) ? -mb.length : mb.length) * mb.meanRho)) {
           res = false;
         }
@@ -308,6 +310,7 @@ GPUd() bool PropagatorImpl<value_T>::propagateToX(TrackParCov_t& track, value_ty
     signCorr = -dir; // sign of eloss correction is not imposed
   }
 
+  MatBudgetCache matCache; // consecutive steps of the track are likely to stay in the same LUT cell
   while (math_utils::detail::abs<value_type>(dx) > Epsilon) {
     auto step = math_utils::detail::min<value_type>(math_utils::detail::abs<value_type>(dx), maxStep);
     if (dir < 0) {
@@ -315,11 +318,11 @@ GPUd() bool PropagatorImpl<value_T>::propagateToX(TrackParCov_t& track, value_ty
     }
     auto x = track.getX() + step;
     auto xyz0 = track.getXYZGlo();
-    auto correct = [&track, &xyz0, tofInfo, matCorr, signCorr, this]() {
+    auto correct = [&track, &xyz0, &matCache, tofInfo, matCorr, signCorr, this]() {
       bool res = true;
       if (matCorr != MatCorrType::USEMatCorrNONE) {
         auto xyz1 = track.getXYZGlo();
-        auto mb = this->getMatBudget(matCorr, xyz0, xyz1);
+        auto mb = this->getMatBudget(matCorr, xyz0, xyz1, matCache);
         if (!track.correctForMaterial(mb.meanX2X0, mb.getXRho(signCorr))) {
           res = false;
         }
@@ -373,6 +376,7 @@ GPUd() bool PropagatorImpl<value_T>::propagateToX(TrackPar_t& track, value_type
     signCorr = -dir; // sign of eloss correction is not imposed
   }
 
+  MatBudgetCache matCache; // consecutive steps of the track are likely to stay in the same LUT cell
   while (math_utils::detail::abs<value_type>(dx) > Epsilon) {
     auto step = math_utils::detail::min<value_type>(math_utils::detail::abs<value_type>(dx), maxStep);
     if (dir < 0) {
@@ -381,11 +385,11 @@ GPUd() bool PropagatorImpl<value_T>::propagateToX(TrackPar_t& track, value_type
     auto x = track.getX() + step;
     auto xyz0 = track.getXYZGlo();
 
-    auto correct = [&track, &xyz0, tofInfo, matCorr, signCorr, this]() {
+    auto correct = [&track, &xyz0, &matCache, tofInfo, matCorr, signCorr, this]() {
       bool res = true;
       if (matCorr != MatCorrType::USEMatCorrNONE) {
         auto xyz1 = track.getXYZGlo();
-        auto mb = this->getMatBudget(matCorr, xyz0, xyz1);
+        auto mb = this->getMatBudget(matCorr, xyz0, xyz1, matCache);
         if (!track.correctForELoss(mb.getXRho(signCorr))) {
           res = false;
         }
@@ -740,6 +744,18 @@ GPUd() MatBudget PropagatorImpl<value_T>::getMatBudget(PropagatorImpl<value_type
   return mMatLUT->getMatBudget(p0.X(), p0.Y(), p0.Z(), p1.X(), p1.Y(), p1.Z());
 }
 
+//____________________________________________________________
+template <typename value_T>
+GPUd() MatBudget PropagatorImpl<value_T>::getMatBudget(PropagatorImpl<value_type>::MatCorrType corrType, const math_utils::Point3D<value_type>& p0, const math_utils::Point3D<value_type>& p1, MatBudgetCache& cache) const
+{
+#if !defined(GPUCA_STANDALONE) && !defined(GPUCA_GPUCODE)
+  if (corrType == MatCorrType::USEMatCorrTGeo || !mMatLUT) {
+    return getMatBudget(corrType, p0, p1);
+  }
+#endif
+  return mMatLUT->getMatBudget(p0.X(), p0.Y(), p0.Z(), p1.X(), p1.Y(), p1.Z(), cache);
+}
+
 template <typename value_T>
 template <typename T>
 GPUd() void PropagatorImpl<value_T>::getFieldXYZImpl(const math_utils::Point3D<T> xyz, T* bxyz) const
@@ -0,0 +1,86 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+/// \file PropagatorBatch.cxx
+/// \brief Propagation of pools of tracks to a common reference
+
+#include "DetectorsBase/PropagatorBatch.h"
+
+#ifdef WITH_OPENMP
+#include <omp.h>
+#endif
+
+using namespace o2::base;
+
+//____________________________________________________________
+template <typename value_T>
+int PropagatorBatchImpl<value_T>::getNThreadsFor(bool bzOnly, MatCorrType matCorr) const
+{
+  // TGeo navigation and the full Chebyshev field map use mutable internal state
+  if (matCorr == MatCorrType::USEMatCorrTGeo || (matCorr == MatCorrType::USEMatCorrLUT && !mPropagator->getMatLUT())) {
+    return 1;
+  }
+  if (!bzOnly && !mPropagator->hasFastFieldSet()) {
+    return 1;
+  }
+  return mNThreads;
+}
+
+//____________________________________________________________
+template <typename value_T>
+template <typename F>
+size_t PropagatorBatchImpl<value_T>::process(gsl::span<TrackParCov_t> tracks, int nThreads, std::vector<uint8_t>* status, F&& propagate) const
+{
+  const long nTracks = tracks.size();
+  if (status) {
+    status->resize(nTracks);
+  }
+  size_t nOK = 0;
+#ifdef WITH_OPENMP
+#pragma omp parallel for schedule(dynamic, 64) num_threads(nThreads) reduction(+ : nOK)
+#endif
+  for (long i = 0; i < nTracks; i++) {
+    bool res = propagate(tracks[i]);
+    if (status) {
+      (*status)[i] = res;
+    }
+    nOK += res;
+  }
+  return nOK;
+}
+
+//____________________________________________________________
+template <typename value_T>
+size_t PropagatorBatchImpl<value_T>::propagateToX(gsl::span<TrackParCov_t> tracks, value_type x, bool bzOnly, value_type maxSnp, value_type maxStep, MatCorrType matCorr,
+                                                  std::vector<uint8_t>* status) const
+{
+  return process(tracks, getNThreadsFor(bzOnly, matCorr), status, [&](TrackParCov_t& trc) {
+    return mPropagator->propagateTo(trc, x, bzOnly, maxSnp, maxStep, matCorr);
+  });
+}
+
+//____________________________________________________________
+template <typename value_T>
+size_t PropagatorBatchImpl<value_T>::propagateToR(gsl::span<TrackParCov_t> tracks, value_type r, bool bzOnly, value_type maxSnp, value_type maxStep, MatCorrType matCorr,
+                                                  std::vector<uint8_t>* status) const
+{
+  const value_type bz = mPropagator->getNominalBz();
+  return process(tracks, getNThreadsFor(bzOnly, matCorr), status, [&](TrackParCov_t& trc) {
+    value_type x;
+    return trc.getXatLabR(r, x, bz) && mPropagator->propagateTo(trc, x, bzOnly, maxSnp, maxStep, matCorr);
+  });
+}
+
+namespace o2::base
+{
+template class PropagatorBatchImpl<float>;
+template class PropagatorBatchImpl<double>;
+} // namespace o2::base
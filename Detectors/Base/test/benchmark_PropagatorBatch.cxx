@@ -0,0 +1,77 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+/// \file benchmark_PropagatorBatch.cxx
+/// \brief Benchmark of the batched track propagation vs the loop over single tracks
+
+#include "benchmark/benchmark.h"
+#include "DetectorsBase/PropagatorBatch.h"
+#include <random>
+
+using namespace o2::base;
+using TrackParCov = o2::track::TrackParCov;
+using MatCorrType = Propagator::MatCorrType;
+
+constexpr float Bz = 5.f;
+constexpr float XToGo = 80.f;
+
+std::vector<TrackParCov> generateTracks(size_t n)
+{
+  std::mt19937 gen(12345);
+  std::uniform_real_distribution<float> yz(-1.f, 1.f), snp(-0.3f, 0.3f), tgl(-1.f, 1.f), q2pt(-3.f, 3.f), alpha(-3.1f, 3.1f);
+  std::vector<TrackParCov> tracks;
+  tracks.reserve(n);
+  for (size_t i = 0; i < n; i++) {
+    std::array<float, o2::track::kNParams> par{yz(gen), yz(gen), snp(gen), tgl(gen), q2pt(gen)};
+    std::array<float, o2::track::kCovMatSize> cov{1e-4, 0., 1e-4, 0., 0., 1e-5, 0., 0., 0., 1e-5, 0., 0., 0., 0., 1e-3};
+    tracks.emplace_back(1.f, alpha(gen), par, cov);
+  }
+  return tracks;
+}
+
+Propagator* getPropagator()
+{
+  auto prop = Propagator::Instance(true); // no field map or material needed for the Bz-only transport
+  prop->setNominalBz(Bz);
+  return prop;
+}
+
+static void BM_PropagateScalar(benchmark::State& state)
+{
+  auto prop = getPropagator();
+  const auto src = generateTracks(state.range(0));
+  for (auto _ : state) {
+    auto tracks = src;
+    size_t nOK = 0;
+    for (auto& trc : tracks) {
+      nOK += prop->propagateToX(trc, XToGo, Bz, Propagator::MAX_SIN_PHI, Propagator::MAX_STEP, MatCorrType::USEMatCorrNONE);
+    }
+    benchmark::DoNotOptimize(nOK);
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+static void BM_PropagateBatch(benchmark::State& state)
+{
+  PropagatorBatch propBatch(getPropagator());
+  propBatch.setNThreads(state.range(1));
+  const auto src = generateTracks(state.range(0));
+  for (auto _ : state) {
+    auto tracks = src;
+    benchmark::DoNotOptimize(propBatch.propagateToX(tracks, XToGo, true, Propagator::MAX_SIN_PHI, Propagator::MAX_STEP, MatCorrType::USEMatCorrNONE));
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+BENCHMARK(BM_PropagateScalar)->Arg(1 << 10)->Arg(1 << 16);
+BENCHMARK(BM_PropagateBatch)->Args({1 << 10, 1})->Args({1 << 16, 1})->Args({1 << 16, 4})->Args({1 << 16, 8});
+
+BENCHMARK_MAIN();
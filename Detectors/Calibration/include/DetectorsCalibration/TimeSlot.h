@@ -39,6 +39,7 @@ class TimeSlot
   {
     mContainer = src.mContainer ? std::make_unique<Container>(*src.mContainer) : nullptr;
   }
+  TimeSlot(TimeSlot&& src) = default;
   TimeSlot& operator=(TimeSlot&& src) = default;
 
   ~TimeSlot() = default;
@@ -53,6 +54,7 @@ class TimeSlot
   const Container* getContainer() const { return mContainer.get(); }
   Container* getContainer() { return mContainer.get(); }
   void setContainer(std::unique_ptr<Container> ptr) { mContainer = std::move(ptr); }
+  std::unique_ptr<Container> releaseContainer() { return std::move(mContainer); }
 
   void setTFStart(TFType v) { mTFStart = v; }
   void setTFEnd(TFType v) { mTFEnd = v; }
@@ -63,10 +65,26 @@ class TimeSlot
   // compare the TF with this slot boundaties
   int relateToTF(TFType tf) { return tf < mTFStart ? -1 : (tf > mTFEnd ? 1 : 0); }
 
+  // fill statistics: number of fill calls and time spent in them
+  void addFill(double ms)
+  {
+    mNFills++;
+    mFillTimeMS += ms;
+  }
+  size_t getNFills() const { return mNFills; }
+  double getFillTimeMS() const { return mFillTimeMS; }
+
   // merge data of previous slot to this one and extend the mTFStart to cover prev
+  // (a slot without container adopts the one of prev, if any)
   void mergeToPrevious(TimeSlot& prev)
   {
-    mContainer->merge(prev.mContainer.get());
+    if (!mContainer) {
+      mContainer = std::move(prev.mContainer);
+    } else if (prev.mContainer) {
+      mContainer->merge(prev.mContainer.get());
+    }
+    mNFills += prev.mNFills;
+    mFillTimeMS += prev.mFillTimeMS;
     mTFStart = prev.mTFStart;
     mTFStartMS = prev.mTFStartMS;
   }
@@ -74,7 +92,9 @@ class TimeSlot
   void print() const
   {
     LOGF(info, "Calibration slot %5d <=TF<=  %5d (start in ms = %ld)", mTFStart, mTFEnd, mTFStartMS);
-    mContainer->print();
+    if (mContainer) {
+      mContainer->print();
+    }
   }
 
  private:
@@ -83,6 +103,8 @@ class TimeSlot
   size_t mEntries = 0;
   long mRunStartOrbit = 0;
   std::unique_ptr<Container> mContainer; // user object to accumulate the calibration data for this slot
+  size_t mNFills = 0;                    //! number of fill calls
+  double mFillTimeMS = 0;                //! time spent in the fill calls
   long mTFStartMS = 0;                   // start time of the slot in ms that avoids to calculate it on the fly; needed when a slot covers more runs, otherwise the OrbitReset that is read is the one of the latest run, and the validity will be wrong
 
   ClassDefNV(TimeSlot, 2);
@@ -20,8 +20,11 @@
 #include "DetectorsBase/GRPGeomHelper.h"
 #include "CommonDataFormat/TFIDInfo.h"
 #include <TFile.h>
+#include <chrono>
 #include <filesystem>
 #include <deque>
+#include <future>
+#include <mutex>
 #include <gsl/gsl>
 #include <limits>
 #include <type_traits>
@@ -32,10 +35,27 @@ namespace o2
 namespace framework
 {
 class ProcessingContext;
+class ServiceRegistryRef;
 }
 namespace calibration
 {
 
+// publish the statistics of the finalized slots through the DataProcessingStats of the device
+void publishSlotStats(const o2::framework::ServiceRegistryRef& services, size_t nFinalizedSlots, double totalFillTimeMS,
+                      double totalFinalizeTimeMS, double maxFinalizeTimeMS, int nPendingFinalizations);
+
+// slots being finalized asynchronously, kept out of the (streamed) TimeSlotCalibration
+template <typename Slot>
+struct SlotFinalizationQueue {
+  struct PendingSlot {
+    std::unique_ptr<Slot> slot;                   // slot moved out of the pool for finalization
+    std::future<double> done;                     // returns the time spent in finalizeSlot in ms
+    std::chrono::steady_clock::time_point closed; // time when the slot was closed
+  };
+  std::deque<PendingSlot> pending;
+  std::mutex outputMutex; // to be used by derived classes to protect the output of asynchronous finalizeSlot
+};
+
 template <typename Container>
 class TimeSlotCalibration
 {
@@ -46,7 +66,14 @@ class TimeSlotCalibration
   static constexpr TFType INFINITE_TF = o2::calibration::INFINITE_TF;
 
   TimeSlotCalibration() = default;
-  virtual ~TimeSlotCalibration() = default;
+  virtual ~TimeSlotCalibration()
+  {
+    try {
+      waitForFinalization(); // normally done already at the end of stream
+    } catch (const std::exception& e) {
+      LOGP(error, "Asynchronous slot finalization failed: {}", e.what());
+    }
+  }
   float getMaxSlotsDelay() const { return mMaxSlotsDelay; }
   void setMaxSlotsDelay(float v) { mMaxSlotsDelay = v > 0. ? v : 0.; }
 
@@ -120,6 +147,50 @@ class TimeSlotCalibration
 
   void setUpdateAtTheEndOfRunOnly() { mUpdateAtTheEndOfRunOnly = kTRUE; }
 
+  // Asynchronous finalization: with n > 0 the closed slots are moved out of the pool and finalized on up to n
+  // worker threads while the new TFs keep being filled. finalizeSlot may then run concurrently for several slots
+  // and with process(): the derived class must protect the output it produces (e.g. with getOutputMutex()),
+  // and the output may be used only after waitForFinalization(). The pending finalizations are drained by
+  // checkSlotsToFinalize(INFINITE_TF) at the end of stream, by reset() and, as a last resort, by the destructor.
+  // With n = 0 (default) the slots are finalized synchronously.
+  void setNFinalizeThreads(int n)
+  {
+    mNFinalizeThreads = n > 0 ? n : 0;
+    if (mNFinalizeThreads && !mFinalizationQueue) {
+      mFinalizationQueue = std::make_unique<SlotFinalizationQueue<Slot>>();
+    }
+  }
+  int getNFinalizeThreads() const { return mNFinalizeThreads; }
+  int getNPendingFinalizations() const { return mFinalizationQueue ? mFinalizationQueue->pending.size() : 0; }
+  void waitForFinalization() { collectFinalizedSlots(true); }
+
+  // Merge-on-close: the slots do not get a container when they are created, but an empty copy of the first
+  // container created by emplaceNewSlot when their first TF is filled, and an underpopulated slot passes its
+  // container on to the next slot if that one has no data yet instead of merging them. The memory is thus bounded
+  // to the containers of the open slots which got data, plus those being finalized, while each slot keeps only
+  // its own TFs.
+  // Not used in the FinalizeWhenReady and UpdateAtTheEndOfRunOnly modes, which have a single slot anyway.
+  void setMergeOnClose(bool v)
+  {
+    if constexpr (std::is_copy_constructible_v<Container>) {
+      mMergeOnClose = v;
+    } else if (v) {
+      LOGP(error, "Merge-on-close mode requires a copy-constructible container, ignoring");
+    }
+  }
+  bool getMergeOnClose() const { return mMergeOnClose; }
+
+  // statistics of the finalized slots
+  size_t getNFinalizedSlots() const { return mNFinalizedSlots; }
+  double getTotalFillTimeMS() const { return mTotalFillTimeMS; }
+  double getTotalFinalizeTimeMS() const { return mTotalFinalizeTimeMS; }
+  double getMaxFinalizeTimeMS() const { return mMaxFinalizeTimeMS; }
+  // to be called by the device, e.g. after process() and at the end of stream, to send the above to the monitoring
+  void publishStats(const o2::framework::ServiceRegistryRef& services) const
+  {
+    publishSlotStats(services, mNFinalizedSlots, mTotalFillTimeMS, mTotalFinalizeTimeMS, mMaxFinalizeTimeMS, getNPendingFinalizations());
+  }
+
   int getNSlots() const { return mSlots.size(); }
   Slot& getSlotForTF(TFType tf);
   Slot& getSlot(int i) { return (Slot&)mSlots.at(i); }
@@ -134,7 +205,9 @@ class TimeSlotCalibration
 
   virtual void reset()
   { // reset to virgin state (need for start - stop - start)
+    waitForFinalization();
     mSlots.clear();
+    mEmptyContainer.reset();
     mLastClosedTF = 0;
     mFirstTF = 0;
     mMaxSeenTF = 0;
@@ -242,6 +315,14 @@ class TimeSlotCalibration
   }
 
   TFType tf2SlotMin(TFType tf) const;
+  std::mutex& getOutputMutex()
+  {
+    if (!mFinalizationQueue) {
+      mFinalizationQueue = std::make_unique<SlotFinalizationQueue<Slot>>();
+    }
+    return mFinalizationQueue->outputMutex;
+  }
+
   std::deque<Slot> mSlots;
 
   o2::dataformats::TFIDInfo mCurrentTFInfo{};
@@ -273,7 +354,24 @@ class TimeSlotCalibration
   TimeSlotMetaData mSaveMetaData{};
   bool mSavedSlotAllowed = false;
 
-  ClassDef(TimeSlotCalibration, 1);
+  bool useMergeOnClose() const { return mMergeOnClose && !mFinalizeWhenReady && !mUpdateAtTheEndOfRunOnly; }
+  Container* getFillContainer(Slot& slot);
+  void initNewSlot(Slot& slot);
+  void attachContainer(Slot& slot);
+  void doFinalizeSlot(Slot& slot);
+  void collectFinalizedSlots(bool wait);
+  void reportFinalizedSlot(const Slot& slot, double finalizeMS, double waitMS);
+
+  int mNFinalizeThreads = 0;                                         // number of threads for asynchronous finalization, 0 for synchronous one
+  bool mMergeOnClose = false;                                        // give the slots a container only when they get data
+  std::unique_ptr<SlotFinalizationQueue<Slot>> mFinalizationQueue;   //! asynchronous finalization state
+  std::unique_ptr<Container> mEmptyContainer;                        //! prototype of the slot containers in the merge-on-close mode
+  size_t mNFinalizedSlots = 0;                                       //! number of finalized slots
+  double mTotalFillTimeMS = 0.;               //! time spent in filling the finalized slots
+  double mTotalFinalizeTimeMS = 0.;           //! time spent in finalizeSlot
+  double mMaxFinalizeTimeMS = 0.;             //! max time spent in finalizeSlot for a single slot
+
+  ClassDef(TimeSlotCalibration, 2);
 };
 
 //_________________________________________________
@@ -300,13 +398,18 @@ bool TimeSlotCalibration<Container>::process(const DATA&... data)
       return false;
     }
   }
+  if (getNPendingFinalizations()) {
+    collectFinalizedSlots(false);
+  }
   auto& slotTF = getSlotForTF(tf);
-  using Cont_t = typename std::remove_pointer<decltype(slotTF.getContainer())>::type;
-  if constexpr (has_fill_method<Cont_t, void(const o2::dataformats::TFIDInfo&, const DATA&...)>::value) {
-    slotTF.getContainer()->fill(mCurrentTFInfo, data...);
+  auto* cont = getFillContainer(slotTF);
+  auto tStart = std::chrono::steady_clock::now();
+  if constexpr (has_fill_method<Container, void(const o2::dataformats::TFIDInfo&, const DATA&...)>::value) {
+    cont->fill(mCurrentTFInfo, data...);
   } else {
-    slotTF.getContainer()->fill(data...);
+    cont->fill(data...);
   }
+  slotTF.addFill(std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - tStart).count());
   if (tf > mMaxSeenTF) {
     mMaxSeenTF = tf; // keep track of the most recent TF processed
   }
@@ -344,7 +447,7 @@ void TimeSlotCalibration<Container>::checkSlotsToFinalize(TFType tf, int maxDela
         mSlots[0].setTFStart(mLastClosedTF);
         mSlots[0].setTFEnd(mMaxSeenTF);
         LOG(info) << "Finalizing slot for " << mSlots[0].getTFStart() << " <= TF <= " << mSlots[0].getTFEnd();
-        finalizeSlot(mSlots[0]);                  // will be removed after finalization
+        doFinalizeSlot(mSlots[0]);                // will be removed after finalization
         mLastClosedTF = mSlots[0].getTFEnd() < INFINITE_TF ? (mSlots[0].getTFEnd() + 1) : mSlots[0].getTFEnd() < INFINITE_TF; // will not accept any TF below this
         mSlots.erase(mSlots.begin());
         // creating a new slot if we are not at the end of run
@@ -352,6 +455,7 @@ void TimeSlotCalibration<Container>::checkSlotsToFinalize(TFType tf, int maxDela
           LOG(info) << "Creating new slot for " << mLastClosedTF << " <= TF <= " << INFINITE_TF;
           auto& sl = emplaceNewSlot(true, mLastClosedTF, INFINITE_TF);
           sl.setRunStartOrbit(getRunStartOrbit());
+          initNewSlot(sl);
         }
       } else {
         LOG(info) << "Not enough data to calibrate";
@@ -366,13 +470,14 @@ void TimeSlotCalibration<Container>::checkSlotsToFinalize(TFType tf, int maxDela
       uint64_t lim64 = uint64_t(maxDelay) + slot->getTFEnd();
       TFType tfLim = lim64 < INFINITE_TF ? TFType(lim64) : INFINITE_TF;
       if (tfLim < tf) {
+        attachContainer(*slot);
         if (hasEnoughData(*slot)) {
           LOG(debug) << "Finalizing slot for " << slot->getTFStart() << " <= TF <= " << slot->getTFEnd();
-          finalizeSlot(*slot); // will be removed after finalization
+          doFinalizeSlot(*slot); // will be removed after finalization
         } else if ((slot + 1) != mSlots.end()) {
           LOG(info) << "Merging underpopulated slot " << slot->getTFStart() << " <= TF <= " << slot->getTFEnd()
                     << " to slot " << (slot + 1)->getTFStart() << " <= TF <= " << (slot + 1)->getTFEnd();
-          (slot + 1)->mergeToPrevious(*slot);
+          (slot + 1)->mergeToPrevious(*slot); // in the merge-on-close mode the next slot may simply adopt the container
         } else {
           LOG(info) << "Discard underpopulated slot " << slot->getTFStart() << " <= TF <= " << slot->getTFEnd();
           break; // slot has no enough stat. and there is no other slot to merge it to
@@ -385,6 +490,9 @@ void TimeSlotCalibration<Container>::checkSlotsToFinalize(TFType tf, int maxDela
       }
     }
   }
+  if (tf == INFINITE_TF) { // end of stream: the output of all closed slots must be available
+    waitForFinalization();
+  }
 }
 
 //_________________________________________________
@@ -396,7 +504,8 @@ void TimeSlotCalibration<Container>::finalizeOldestSlot()
     LOG(warning) << "There are no slots defined";
     return;
   }
-  finalizeSlot(mSlots.front());
+  attachContainer(mSlots.front());
+  doFinalizeSlot(mSlots.front());
   mLastClosedTF = mSlots.front().getTFEnd() + 1; // do not accept any TF below this
   mSlots.erase(mSlots.begin());
 }
@@ -435,6 +544,7 @@ TimeSlot<Container>& TimeSlotCalibration<Container>::getSlotForTF(TFType tf)
       auto& sl = emplaceNewSlot(true, mFirstTF, tf);
       sl.setRunStartOrbit(getRunStartOrbit());
       sl.setStaticStartTimeMS(sl.getStartTimeMS());
+      initNewSlot(sl);
     }
     return mSlots.back();
   }
@@ -449,6 +559,7 @@ TimeSlot<Container>& TimeSlotCalibration<Container>::getSlotForTF(TFType tf)
       auto& sl = emplaceNewSlot(true, tfmn, tfmx);
       sl.setRunStartOrbit(getRunStartOrbit());
       sl.setStaticStartTimeMS(sl.getStartTimeMS());
+      initNewSlot(sl);
       if (!tfmn) {
         break;
       }
@@ -474,12 +585,107 @@ TimeSlot<Container>& TimeSlotCalibration<Container>::getSlotForTF(TFType tf)
     auto& sl = emplaceNewSlot(false, tfmn, tfmx);
     sl.setRunStartOrbit(getRunStartOrbit());
     sl.setStaticStartTimeMS(sl.getStartTimeMS());
+    initNewSlot(sl);
     tfmn = tft < o2::calibration::INFINITE_TF ? mSlots.back().getTFEnd() + 1 : tft;
   } while (tf > mSlots.back().getTFEnd());
 
   return mSlots.back();
 }
 
+//_________________________________________________
+template <typename Container>
+void TimeSlotCalibration<Container>::initNewSlot(Slot& slot)
+{
+  // in the merge-on-close mode the container created by the derived class is kept only as a prototype
+  if (useMergeOnClose()) {
+    if (!mEmptyContainer) {
+      mEmptyContainer = slot.releaseContainer();
+    } else {
+      slot.setContainer(nullptr);
+    }
+  }
+}
+
+//_________________________________________________
+template <typename Container>
+Container* TimeSlotCalibration<Container>::getFillContainer(Slot& slot)
+{
+  // in the merge-on-close mode the slot gets its container with its first TF
+  attachContainer(slot);
+  return slot.getContainer();
+}
+
+//_________________________________________________
+template <typename Container>
+void TimeSlotCalibration<Container>::attachContainer(Slot& slot)
+{
+  // give an empty container to a slot without one, i.e. in the merge-on-close mode with its first TF or at its closure
+  if (useMergeOnClose() && !slot.getContainer() && mEmptyContainer) {
+    if constexpr (std::is_copy_constructible_v<Container>) {
+      slot.setContainer(std::make_unique<Container>(*mEmptyContainer));
+    }
+  }
+}
+
+//_________________________________________________
+template <typename Container>
+void TimeSlotCalibration<Container>::doFinalizeSlot(Slot& slot)
+{
+  // finalize the slot directly or move it to the asynchronous finalization queue
+  if (!mNFinalizeThreads) {
+    auto tStart = std::chrono::steady_clock::now();
+    finalizeSlot(slot);
+    reportFinalizedSlot(slot, std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - tStart).count(), 0.);
+    return;
+  }
+  while (getNPendingFinalizations() >= mNFinalizeThreads) {
+    collectFinalizedSlots(true);
+  }
+  auto& pending = mFinalizationQueue->pending.emplace_back();
+  pending.slot = std::make_unique<Slot>(std::move(slot)); // the boundaries of the moved-from slot stay valid
+  pending.closed = std::chrono::steady_clock::now();
+  pending.done = std::async(std::launch::async, [this, sl = pending.slot.get()]() {
+    auto tStart = std::chrono::steady_clock::now();
+    finalizeSlot(*sl);
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - tStart).count();
+  });
+}
+
+//_________________________________________________
+template <typename Container>
+void TimeSlotCalibration<Container>::collectFinalizedSlots(bool wait)
+{
+  // release the asynchronously finalized slots; with wait = true block until all of them are done
+  if (!mFinalizationQueue) {
+    return;
+  }
+  auto& pendingSlots = mFinalizationQueue->pending;
+  for (auto it = pendingSlots.begin(); it != pendingSlots.end();) {
+    if (!wait && it->done.wait_for(std::chrono::seconds(0)) != std::future_status::ready) {
+      ++it;
+      continue;
+    }
+    double finalizeMS = it->done.get(); // rethrows the exception of finalizeSlot, if any
+    double waitMS = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - it->closed).count() - finalizeMS;
+    reportFinalizedSlot(*it->slot, finalizeMS, waitMS > 0. ? waitMS : 0.);
+    it = pendingSlots.erase(it);
+  }
+}
+
+//_________________________________________________
+template <typename Container>
+void TimeSlotCalibration<Container>::reportFinalizedSlot(const Slot& slot, double finalizeMS, double waitMS)
+{
+  mNFinalizedSlots++;
+  mTotalFillTimeMS += slot.getFillTimeMS();
+  mTotalFinalizeTimeMS += finalizeMS;
+  if (finalizeMS > mMaxFinalizeTimeMS) {
+    mMaxFinalizeTimeMS = finalizeMS;
+  }
+  LOGP(debug, "Slot {} <= TF <= {}: {} fills in {:.1f} ms, finalized in {:.1f} ms{}", slot.getTFStart(), slot.getTFEnd(), slot.getNFills(), slot.getFillTimeMS(), finalizeMS,
+       mNFinalizeThreads ? fmt::format(" after {:.1f} ms in queue", waitMS) : std::string{});
+}
+
 //_________________________________________________
 template <typename Container>
 void TimeSlotCalibration<Container>::print() const
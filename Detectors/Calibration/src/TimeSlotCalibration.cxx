@@ -10,5 +10,21 @@
 // or submit itself to any jurisdiction.
 
 #include "DetectorsCalibration/TimeSlotCalibration.h"
+#include "Framework/DataProcessingStats.h"
+#include "Framework/ServiceRegistryRef.h"
 
 using namespace o2::calibration;
+
+//_________________________________________________
+void o2::calibration::publishSlotStats(const o2::framework::ServiceRegistryRef& services, size_t nFinalizedSlots, double totalFillTimeMS,
+                                      double totalFinalizeTimeMS, double maxFinalizeTimeMS, int nPendingFinalizations)
+{
+  using o2::framework::DataProcessingStats;
+  using o2::framework::ProcessingStatsId;
+  auto& stats = services.get<DataProcessingStats>();
+  stats.updateStats({static_cast<short>(ProcessingStatsId::CALIB_FINALIZED_SLOTS), DataProcessingStats::Op::Set, (int64_t)nFinalizedSlots});
+  stats.updateStats({static_cast<short>(ProcessingStatsId::CALIB_SLOT_FILL_TIME_MS), DataProcessingStats::Op::Set, (int64_t)totalFillTimeMS});
+  stats.updateStats({static_cast<short>(ProcessingStatsId::CALIB_SLOT_FINALIZE_TIME_MS), DataProcessingStats::Op::Set, (int64_t)totalFinalizeTimeMS});
+  stats.updateStats({static_cast<short>(ProcessingStatsId::CALIB_SLOT_MAX_FINALIZE_TIME_MS), DataProcessingStats::Op::Set, (int64_t)maxFinalizeTimeMS});
+  stats.updateStats({static_cast<short>(ProcessingStatsId::CALIB_PENDING_FINALIZATIONS), DataProcessingStats::Op::Set, nPendingFinalizations});
+}
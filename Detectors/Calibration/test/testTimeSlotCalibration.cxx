@@ -0,0 +1,234 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+/// \file testTimeSlotCalibration.cxx
+/// \brief Asynchronous finalization and merge-on-close modes of the TimeSlotCalibration
+
+#define BOOST_TEST_MODULE Test TimeSlotCalibration
+#define BOOST_TEST_MAIN
+#define BOOST_TEST_DYN_LINK
+#include <boost/test/unit_test.hpp>
+
+#include "DetectorsCalibration/TimeSlotCalibration.h"
+#include <algorithm>
+#include <atomic>
+#include <thread>
+#include <tuple>
+#include <vector>
+
+namespace o2::calibration
+{
+
+namespace
+{
+constexpr TFType SlotLength = 10;
+
+/// sum of the values filled for the TFs of a slot
+struct Counter {
+  long sum = 0;
+  int entries = 0;
+
+  void fill(int value)
+  {
+    sum += value;
+    entries++;
+  }
+  void merge(const Counter* other)
+  {
+    sum += other->sum;
+    entries += other->entries;
+  }
+  void print() const {}
+};
+
+struct SlotResult {
+  TFType tfStart;
+  TFType tfEnd;
+  long sum;
+  int entries;
+  bool operator==(const SlotResult& o) const { return std::tie(tfStart, tfEnd, sum, entries) == std::tie(o.tfStart, o.tfEnd, o.sum, o.entries); }
+  bool operator<(const SlotResult& o) const { return tfStart < o.tfStart; }
+};
+
+class TestCalibrator final : public TimeSlotCalibration<Counter>
+{
+ public:
+  explicit TestCalibrator(int finalizeDelayMS = 0) : mFinalizeDelayMS(finalizeDelayMS) {}
+
+  void initOutput() final { mResults.clear(); }
+  bool hasEnoughData(const Slot& slot) const final { return slot.getContainer()->entries > 0; }
+  Slot& emplaceNewSlot(bool front, TFType tstart, TFType tend) final
+  {
+    auto& cont = getSlots();
+    auto& slot = front ? cont.emplace_front(tstart, tend) : cont.emplace_back(tstart, tend);
+    slot.setContainer(std::make_unique<Counter>());
+    return slot;
+  }
+  void finalizeSlot(Slot& slot) final
+  {
+    int running = ++mRunning;
+    int maxRunning = mMaxRunning;
+    while (running > maxRunning && !mMaxRunning.compare_exchange_weak(maxRunning, running)) {
+    }
+    std::this_thread::sleep_for(std::chrono::milliseconds(mFinalizeDelayMS));
+    const auto* cont = slot.getContainer();
+    {
+      std::lock_guard<std::mutex> lock(getOutputMutex());
+      mResults.push_back({slot.getTFStart(), slot.getTFEnd(), cont->sum, cont->entries});
+    }
+    --mRunning;
+  }
+
+  bool processTF(TFType tf, int value)
+  {
+    getCurrentTFInfo().tfCounter = tf;
+    getCurrentTFInfo().firstTForbit = tf * o2::base::GRPGeomHelper::getNHBFPerTF();
+    return process(value);
+  }
+
+  std::vector<SlotResult> getResults()
+  {
+    std::lock_guard<std::mutex> lock(getOutputMutex());
+    return mResults;
+  }
+  int getMaxRunning() const { return mMaxRunning; }
+
+ private:
+  int mFinalizeDelayMS = 0;
+  std::atomic<int> mRunning{0};
+  std::atomic<int> mMaxRunning{0};
+  std::vector<SlotResult> mResults;
+};
+
+/// process the TFs with the value tf + 1 and close all slots as done at the end of stream
+std::vector<SlotResult> runCalibration(TestCalibrator& calib, const std::vector<TFType>& tfs, float maxSlotsDelay = 0.f)
+{
+  calib.setSlotLength(SlotLength);
+  calib.setMaxSlotsDelay(maxSlotsDelay);
+  for (auto tf : tfs) {
+    calib.processTF(tf, tf + 1);
+  }
+  calib.checkSlotsToFinalize(TimeSlotCalibration<Counter>::INFINITE_TF); // also waits for the pending finalizations
+  return calib.getResults();
+}
+
+std::vector<TFType> makeTFs(TFType n)
+{
+  std::vector<TFType> tfs(n);
+  for (TFType i = 0; i < n; i++) {
+    tfs[i] = i;
+  }
+  return tfs;
+}
+} // namespace
+
+BOOST_AUTO_TEST_CASE(TimeSlotCalibrationAsyncFinalization)
+{
+  auto tfs = makeTFs(5 * SlotLength);
+  TestCalibrator syncCalib;
+  auto reference = runCalibration(syncCalib, tfs);
+  BOOST_REQUIRE_EQUAL(reference.size(), 5);
+  for (int i = 0; i < 5; i++) {
+    BOOST_CHECK_EQUAL(reference[i].tfStart, i * SlotLength);
+    BOOST_CHECK_EQUAL(reference[i].entries, SlotLength);
+  }
+
+  // a single worker keeps the order of the slots
+  {
+    TestCalibrator calib(5);
+    calib.setNFinalizeThreads(1);
+    auto results = runCalibration(calib, tfs);
+    BOOST_CHECK(results == reference);
+    BOOST_CHECK_EQUAL(calib.getMaxRunning(), 1);
+    BOOST_CHECK_EQUAL(calib.getNFinalizedSlots(), 5);
+  }
+
+  // several workers: all slots are finalized at the end of stream, not more than the workers at the same time
+  {
+    TestCalibrator calib(50);
+    calib.setNFinalizeThreads(3);
+    calib.setSlotLength(SlotLength);
+    calib.setMaxSlotsDelay(0);
+    for (auto tf : makeTFs(SlotLength + 1)) {
+      calib.processTF(tf, tf + 1);
+    }
+    // the first slot was closed by the last TF and is being finalized while the next TFs are processed
+    BOOST_CHECK_EQUAL(calib.getNPendingFinalizations(), 1);
+    BOOST_CHECK(calib.getResults().empty());
+    for (TFType tf = SlotLength + 1; tf < tfs.size(); tf++) {
+      calib.processTF(tf, tf + 1);
+    }
+    calib.checkSlotsToFinalize(TimeSlotCalibration<Counter>::INFINITE_TF);
+    BOOST_CHECK_EQUAL(calib.getNPendingFinalizations(), 0);
+    BOOST_CHECK_EQUAL(calib.getNFinalizedSlots(), 5);
+    BOOST_CHECK(calib.getMaxRunning() <= 3);
+    auto results = calib.getResults();
+    std::sort(results.begin(), results.end());
+    BOOST_CHECK(results == reference);
+  }
+}
+
+BOOST_AUTO_TEST_CASE(TimeSlotCalibrationMergeOnClose)
+{
+  auto tfs = makeTFs(5 * SlotLength);
+  TestCalibrator syncCalib;
+  auto reference = runCalibration(syncCalib, tfs);
+
+  // in-order TFs: same slots as with a container per slot
+  {
+    TestCalibrator calib;
+    calib.setMergeOnClose(true);
+    BOOST_CHECK(runCalibration(calib, tfs) == reference);
+  }
+  // together with the asynchronous finalization
+  {
+    TestCalibrator calib(5);
+    calib.setMergeOnClose(true);
+    calib.setNFinalizeThreads(2);
+    auto results = runCalibration(calib, tfs);
+    std::sort(results.begin(), results.end());
+    BOOST_CHECK(results == reference);
+  }
+
+  // a late TF of the first slot arriving within the max. delay of one slot, after the TFs of the second slot:
+  // each slot keeps only its own TFs, exactly as with a container per slot
+  auto lateTFs = tfs;
+  lateTFs.insert(lateTFs.begin() + SlotLength + 3, 5);
+  TestCalibrator perSlotCalib;
+  auto perSlot = runCalibration(perSlotCalib, lateTFs, 1.f);
+  TestCalibrator mergeCalib;
+  mergeCalib.setMergeOnClose(true);
+  auto merged = runCalibration(mergeCalib, lateTFs, 1.f);
+  BOOST_REQUIRE_EQUAL(perSlot.size(), 5);
+  BOOST_CHECK(merged == perSlot);
+  BOOST_CHECK_EQUAL(merged[0].entries, SlotLength + 1);
+  for (int i = 1; i < 5; i++) {
+    BOOST_CHECK_EQUAL(merged[i].tfStart, i * SlotLength);
+    BOOST_CHECK_EQUAL(merged[i].entries, SlotLength);
+  }
+
+  // an empty slot in the middle is merged to the next one
+  std::vector<TFType> gapTFs;
+  for (auto tf : tfs) {
+    if (tf < SlotLength || tf >= 2 * SlotLength) {
+      gapTFs.push_back(tf);
+    }
+  }
+  TestCalibrator gapCalib;
+  gapCalib.setMergeOnClose(true);
+  auto gap = runCalibration(gapCalib, gapTFs);
+  BOOST_REQUIRE_EQUAL(gap.size(), 4);
+  BOOST_CHECK_EQUAL(gap[1].tfStart, SlotLength);
+  BOOST_CHECK_EQUAL(gap[1].tfEnd, 3 * SlotLength - 1);
+  BOOST_CHECK_EQUAL(gap[1].entries, SlotLength);
+}
+
+} // namespace o2::calibration
@@ -55,6 +55,7 @@ void MeanVertexCalibDevice::run(o2::framework::ProcessingContext& pc)
   o2::base::TFIDInfoHelper::fillTFIDInfo(pc, mCalibrator->getCurrentTFInfo());
   LOG(debug) << "Processing TF " << mCalibrator->getCurrentTFInfo().tfCounter << " with " << data.size() << " vertices";
   mCalibrator->process(data);
+  mCalibrator->publishStats(pc.services());
   sendOutput(pc.outputs());
   const auto& infoVec = mCalibrator->getMeanVertexObjectInfoVector();
   LOG(detail) << "Processed TF " << mCalibrator->getCurrentTFInfo().tfCounter << " with " << data.size() << " vertices, for which we created " << infoVec.size() << " objects for TF " << mCalibrator->getCurrentTFInfo().tfCounter;
@@ -73,6 +74,7 @@ void MeanVertexCalibDevice::endOfStream(o2::framework::EndOfStreamContext& ec)
 
   LOG(info) << "Finalizing calibration";
   mCalibrator->checkSlotsToFinalize(o2::calibration::INFINITE_TF);
+  mCalibrator->publishStats(ec.services());
   sendOutput(ec.outputs());
 }
 
@@ -24,6 +24,9 @@
 #include <unordered_map>
 #include <functional>
 #include <string_view>
+#include <memory>
+#include <algorithm>
+#include <vector>
 #include <chrono>
 
 namespace o2h = o2::header;
@@ -47,15 +50,112 @@ using DPID = o2::dcs::DataPointIdentifier;
 using DPVAL = o2::dcs::DataPointValue;
 using DPCOM = o2::dcs::DataPointCompositeObject;
 
+/// Hash of the DPID alias which, unlike DPID::hash_code, does not create a temporary std::string
+struct DPIDAliasHash {
+  std::size_t operator()(const DPID& dpid) const noexcept
+  {
+    return std::hash<std::string_view>{}(std::string_view(dpid.get_alias()));
+  }
+};
+
+/// Routing of the DPs to the outputs precompiled from the DPID -> DataDescriptions configuration:
+/// every configured DPID gets a dense index, the latest value of each DP in the accumulation window is kept
+/// in a flat array and the list of outputs of each DP is stored in a flat array of output indices
+struct DPRoutingTable {
+  std::unordered_map<DPID, int, DPIDAliasHash> dpid2index; // dense index of each configured DPID
+  std::vector<o2h::DataDescription> descriptions;          // all outputs
+  std::vector<int> routeOffset;                            // outputs of the DP i are routes[routeOffset[i]:routeOffset[i+1]]
+  std::vector<int> routes;                                 // output indices
+  std::vector<DPCOM> latest;                               // latest value of each DP in the current window
+  std::vector<bool> updated;                               // DP was received in the current window
+  std::vector<int> updatedDPs;                             // indices of the DPs received in the current window
+  std::vector<size_t> nDPsPerOutput;                       // number of DPs of each output in the current window
+  std::vector<DPCOM*> outputCursor;                        // write position in the payload of each output, if any
+
+  explicit DPRoutingTable(const std::unordered_map<DPID, std::vector<o2h::DataDescription>>& dpid2group)
+  {
+    std::unordered_map<o2h::DataDescription, int> desc2index;
+    routeOffset.push_back(0);
+    for (const auto& [dpid, descs] : dpid2group) {
+      dpid2index.emplace(dpid, int(dpid2index.size()));
+      for (const auto& ds : descs) {
+        auto res = desc2index.emplace(ds, int(descriptions.size()));
+        if (res.second) {
+          descriptions.push_back(ds);
+        }
+        if (std::find(routes.begin() + routeOffset.back(), routes.end(), res.first->second) == routes.end()) {
+          routes.push_back(res.first->second);
+        }
+      }
+      routeOffset.push_back(routes.size());
+      latest.emplace_back(dpid, DPVAL{});
+    }
+    updated.resize(latest.size(), false);
+    updatedDPs.reserve(latest.size());
+    nDPsPerOutput.resize(descriptions.size(), 0);
+    outputCursor.resize(descriptions.size(), nullptr);
+  }
+
+  /// index of the DP or -1 if it is not routed anywhere
+  int find(const DPID& dpid) const
+  {
+    auto it = dpid2index.find(dpid);
+    return it == dpid2index.end() ? -1 : it->second;
+  }
+
+  void store(int idx, const DPCOM* src)
+  {
+    memcpy((void*)&latest[idx], src, sizeof(DPCOM)); // this is needed in case in the 1s window we get a new value for the same DP
+    if (!updated[idx]) {
+      updated[idx] = true;
+      updatedDPs.push_back(idx);
+    }
+  }
+
+  /// count the DPs of each output in the current window
+  void countPerOutput()
+  {
+    std::fill(nDPsPerOutput.begin(), nDPsPerOutput.end(), 0);
+    for (auto idx : updatedDPs) {
+      for (int ir = routeOffset[idx]; ir < routeOffset[idx + 1]; ir++) {
+        nDPsPerOutput[routes[ir]]++;
+      }
+    }
+  }
+
+  /// copy the DPs of the current window to the outputs with a cursor set, in a single pass
+  void fillOutputs()
+  {
+    for (auto idx : updatedDPs) {
+      for (int ir = routeOffset[idx]; ir < routeOffset[idx + 1]; ir++) {
+        auto& dest = outputCursor[routes[ir]];
+        if (dest) {
+          memcpy((void*)dest++, &latest[idx], sizeof(DPCOM));
+        }
+      }
+    }
+  }
+
+  void clearWindow()
+  {
+    for (auto idx : updatedDPs) {
+      updated[idx] = false;
+    }
+    updatedDPs.clear();
+    std::fill(outputCursor.begin(), outputCursor.end(), nullptr);
+  }
+};
+
 /// A callback function to retrieve the FairMQChannel name to be used for sending
 /// messages of the specified OutputSpec
 
 o2f::InjectorFunction dcs2dpl(std::unordered_map<DPID, std::vector<o2h::DataDescription>>& dpid2group, bool fbiFirst, bool verbose = false, int FBIPerInterval = 1)
 {
+  auto table = std::make_shared<DPRoutingTable>(dpid2group);
+  LOGP(info, "DCS routing table: {} DPs routed to {} outputs", table->latest.size(), table->descriptions.size());
 
-  return [dpid2group, fbiFirst, verbose, FBIPerInterval](o2::framework::TimingInfo& tinfo, framework::ServiceRegistryRef const& services, fair::mq::Parts& parts, o2f::ChannelRetriever channelRetriever, size_t newTimesliceId, bool& stop) -> bool {
+  return [table, fbiFirst, verbose, FBIPerInterval](o2::framework::TimingInfo& tinfo, framework::ServiceRegistryRef const& services, fair::mq::Parts& parts, o2f::ChannelRetriever channelRetriever, size_t newTimesliceId, bool& stop) -> bool {
     auto *device = services.get<framework::RawDeviceService>().device();
-    static std::unordered_map<DPID, DPCOM> cache; // will keep only the latest measurement in the 1-second wide window for each DPID
     static std::unordered_map<std::string, int> sentToChannel;
     static auto timer = std::chrono::high_resolution_clock::now();
     static auto timer0 = std::chrono::high_resolution_clock::now();
@@ -64,22 +164,22 @@ o2f::InjectorFunction dcs2dpl(std::unordered_map<DPID, std::vector<o2h::DataDesc
     static size_t nInp = 0, nInpFBI = 0;
     static size_t szInp = 0, szInpFBI = 0;
     if (verbose) {
-      LOG(info) << "In lambda function: ********* Size of unordered_map (--> number of defined groups) = " << dpid2group.size();
+      LOG(info) << "In lambda function: ********* Size of routing table (--> number of defined DPs) = " << table->latest.size();
     }
     // check if we got FBI (Master) or delta (MasterDelta)
     if (!parts.Size()) {
       LOGP(warn, "Empty input recieved at timeslice {}", tinfo.timeslice);
       return false;
     }
-    std::string firstName = std::string((char*)&(reinterpret_cast<const DPCOM*>(parts.At(0)->GetData()))->id);
+    std::string_view firstName((const char*)&(reinterpret_cast<const DPCOM*>(parts.At(0)->GetData()))->id);
 
     bool isFBI = false;
     nInp++;
-    if (o2::utils::Str::endsWith(firstName, "Master")) {
+    if (firstName.size() >= 6 && firstName.substr(firstName.size() - 6) == "Master") {
       isFBI = true;
       nInpFBI++;
       seenFBI = true;
-    } else if (o2::utils::Str::endsWith(firstName, "MasterDelta")) {
+    } else if (firstName.size() >= 11 && firstName.substr(firstName.size() - 11) == "MasterDelta") {
       isFBI = false;
     } else {
       LOGP(error, "Cannot determine if the map is FBI or Delta, 1st DP name is {}", firstName);
@@ -97,25 +197,26 @@ o2f::InjectorFunction dcs2dpl(std::unordered_map<DPID, std::vector<o2h::DataDesc
       }
       auto nDPCOM = sz / sizeof(DPCOM); // number of DPCOM in current part
       LOGP(debug, "sz={} szof={} -> /={} %={} | {} {}", sz, sizeof(DPCOM), nDPCOM, sz % sizeof(DPCOM), sizeof(o2::dcs::DataPointIdentifier), sizeof(o2::dcs::DataPointValue));
+      const auto* dpcoms = reinterpret_cast<const DPCOM*>(parts.At(i)->GetData());
+      DPID dpid;
       for (size_t j = 0; j < nDPCOM; j++) {
-        const auto* ptr = (reinterpret_cast<const DPCOM*>(parts.At(i)->GetData()) + j);
-        DPCOM src;
-        memcpy(&src, ptr, sizeof(DPCOM));
-        // do we want to check if this DP was requested ?
-        auto mapEl = dpid2group.find(src.id);
+        memcpy((void*)&dpid, &dpcoms[j].id, sizeof(DPID)); // the payload is not guaranteed to be aligned
+        int idx = table->find(dpid);
         if (verbose) {
           std::string dest;
-          if (mapEl == dpid2group.end()) {
+          if (idx < 0) {
             dest = "none";
           } else {
-            for (const auto& ds : mapEl->second) {
-              dest += fmt::format("{}, ", ds.as<std::string>());
+            for (int ir = table->routeOffset[idx]; ir < table->routeOffset[idx + 1]; ir++) {
+              dest += fmt::format("{}, ", table->descriptions[table->routes[ir]].as<std::string>());
             }
           }
+          DPCOM src;
+          memcpy((void*)&src, &dpcoms[j], sizeof(DPCOM));
           LOG(info) << "Received DP " << src.id << " (data = " << src.data << "), matched to output-> " << dest;
         }
-        if (mapEl != dpid2group.end()) {
-          cache[src.id] = src; // this is needed in case in the 1s window we get a new value for the same DP
+        if (idx >= 0) {
+          table->store(idx, &dpcoms[j]);
         }
       }
     }
@@ -134,31 +235,21 @@ o2f::InjectorFunction dcs2dpl(std::unordered_map<DPID, std::vector<o2h::DataDesc
     std::chrono::duration<double, std::ratio<1>> duration = timerNow - timer;
     bool didSendMessages = false;
     if (duration.count() > 1 && (seenFBI || !fbiFirst)) { // did we accumulate for 1 sec and have we seen FBI if it was requested?
-      std::unordered_map<o2h::DataDescription, pmr::vector<DPCOM>, std::hash<o2h::DataDescription>> outputs;
-      // in the cache we have the final values of the DPs that we should put in the output
-      // distribute DPs over the vectors for each requested output
-      for (auto& it : cache) {
-        auto mapEl = dpid2group.find(it.first);
-        if (mapEl != dpid2group.end()) {
-          for (const auto& ds : mapEl->second) {
-            outputs[ds].push_back(it.second);
-          }
-        }
-      }
+      // in the table we have the final values of the DPs that we should put in the output
+      table->countPerOutput();
       std::uint64_t creation = std::chrono::time_point_cast<std::chrono::milliseconds>(timerNow).time_since_epoch().count();
       std::unordered_map<std::string, std::unique_ptr<fair::mq::Parts>> messagesPerRoute;
       // create and send output messages
-      for (auto& it : outputs) { // distribute messages per routes
-        o2h::DataHeader hdr(it.first, "DCS", 0);
-        o2f::OutputSpec outsp{hdr.dataOrigin, hdr.dataDescription, hdr.subSpecification};
-        if (it.second.empty()) {
-          LOG(warning) << "No data for OutputSpec " << outsp;
+      for (int iout = 0; iout < int(table->descriptions.size()); iout++) { // distribute messages per routes
+        auto nDPs = table->nDPsPerOutput[iout];
+        if (!nDPs) {
           continue;
         }
+        o2h::DataHeader hdr(table->descriptions[iout], "DCS", 0);
+        o2f::OutputSpec outsp{hdr.dataOrigin, hdr.dataDescription, hdr.subSpecification};
         auto channel = channelRetriever(outsp, tinfo.timeslice);
         if (channel.empty()) {
           LOG(warning) << "No output channel found for OutputSpec " << outsp << ", discarding its data";
-          it.second.clear();
           continue;
         }
 
@@ -166,14 +257,14 @@ o2f::InjectorFunction dcs2dpl(std::unordered_map<DPID, std::vector<o2h::DataDesc
         hdr.payloadSerializationMethod = o2h::gSerializationMethodNone;
         hdr.splitPayloadParts = 1;
         hdr.splitPayloadIndex = 1;
-        hdr.payloadSize = it.second.size() * sizeof(DPCOM);
+        hdr.payloadSize = nDPs * sizeof(DPCOM);
         hdr.firstTForbit = 0; // this should be irrelevant for DCS
         o2h::Stack headerStack{hdr, o2::framework::DataProcessingHeader{tinfo.timeslice, 1, creation}};
         auto fmqFactory = device->GetChannel(channel).Transport();
         auto hdMessage = fmqFactory->CreateMessage(headerStack.size(), fair::mq::Alignment{64});
         auto plMessage = fmqFactory->CreateMessage(hdr.payloadSize, fair::mq::Alignment{64});
         memcpy(hdMessage->GetData(), headerStack.data(), headerStack.size());
-        memcpy(plMessage->GetData(), it.second.data(), hdr.payloadSize);
+        table->outputCursor[iout] = reinterpret_cast<DPCOM*>(plMessage->GetData()); // DPs are written directly to the payload
 
         fair::mq::Parts* parts2send = messagesPerRoute[channel].get(); // fair::mq::Parts*
         if (!parts2send) {
@@ -183,10 +274,10 @@ o2f::InjectorFunction dcs2dpl(std::unordered_map<DPID, std::vector<o2h::DataDesc
         parts2send->AddPart(std::move(hdMessage));
         parts2send->AddPart(std::move(plMessage));
         if (verbose) {
-          LOGP(info, "Pushing {} DPs to {} for TimeSlice {} at {}", it.second.size(), o2f::DataSpecUtils::describe(outsp), tinfo.timeslice, creation);
+          LOGP(info, "Pushing {} DPs to {} for TimeSlice {} at {}", nDPs, o2f::DataSpecUtils::describe(outsp), tinfo.timeslice, creation);
         }
-        it.second.clear();
       }
+      table->fillOutputs();
       // push output of every route
       for (auto& msgIt : messagesPerRoute) {
         if (verbose) {
@@ -197,7 +288,7 @@ o2f::InjectorFunction dcs2dpl(std::unordered_map<DPID, std::vector<o2h::DataDesc
         didSendMessages |= msgIt.second->Size() > 0;
       }
       timer = timerNow;
-      cache.clear();
+      table->clearWindow();
       if (!messagesPerRoute.empty()) {
         localTFCounter++;
       }
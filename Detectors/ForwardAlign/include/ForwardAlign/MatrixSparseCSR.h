@@ -0,0 +1,56 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+/// \file MatrixSparseCSR.h
+/// \brief Compressed sparse row snapshot of MatrixSparse for the parallel matrix * vector product
+
+#ifndef ALICEO2_FWDALIGN_MATRIXSPARSECSR_H
+#define ALICEO2_FWDALIGN_MATRIXSPARSECSR_H
+
+#include <vector>
+#include <Rtypes.h>
+
+namespace o2
+{
+namespace fwdalign
+{
+
+class MatrixSparse;
+
+/// \class MatrixSparseCSR
+/// Read-only copy of a MatrixSparse in CSR format. For a symmetric matrix both triangles are stored, so that
+/// every row of the product is computed independently and the rows can be distributed over threads.
+/// The snapshot must be rebuilt if the source matrix is modified.
+class MatrixSparseCSR
+{
+ public:
+  MatrixSparseCSR() = default;
+  explicit MatrixSparseCSR(const MatrixSparse& mat) { Build(mat); }
+
+  /// \brief fill the CSR arrays from the matrix, skipping zero elements
+  void Build(const MatrixSparse& mat);
+
+  Int_t GetSize() const { return fRowStart.empty() ? 0 : fRowStart.size() - 1; }
+  Long64_t GetNElems() const { return fElems.size(); }
+
+  /// \brief fill vecOut by matrix * vecIn using MatrixSq::GetNThreads() threads
+  void MultiplyByVec(const Double_t* vecIn, Double_t* vecOut) const;
+
+ private:
+  std::vector<Long64_t> fRowStart; ///< elements of the row i are in [fRowStart[i], fRowStart[i+1])
+  std::vector<Int_t> fColumns;     ///< column of each element
+  std::vector<Double_t> fElems;    ///< value of each element
+};
+
+} // namespace fwdalign
+} // namespace o2
+
+#endif
@@ -198,6 +198,8 @@ class MillePede2
   static void SetMinResMaxIter(const int val = 2000) { fgMinResMaxIter = val; }
   static void SetIterSolverType(const int val = MinResSolve::kSolMinRes) { fgIterSol = val; }
   static void SetNKrylovV(const int val = 60) { fgNKrylovV = val; }
+  /// number of threads for the global matrix operations and the iterative solvers
+  static void SetNThreads(const int n = 1) { MatrixSq::SetNThreads(n); }
 
   static bool GetInvChol() { return fgInvChol; }
   static int GetMinResPrecondType() { return fgMinResCondType; }
@@ -205,6 +207,7 @@ class MillePede2
   static int GetMinResMaxIter() { return fgMinResMaxIter; }
   static int GetIterSolverType() { return fgIterSol; }
   static int GetNKrylovV() { return fgNKrylovV; }
+  static int GetNThreads() { return MatrixSq::GetNThreads(); }
 
   /// \brief return error for parameter iPar
   double GetParError(int iPar) const;
@@ -16,6 +16,7 @@
 #ifndef ALICEO2_FWDALIGN_MINRESSOLVE_H
 #define ALICEO2_FWDALIGN_MINRESSOLVE_H
 
+#include <vector>
 #include <TObject.h>
 #include <TVectorD.h>
 #include <TString.h>
@@ -27,12 +28,14 @@ namespace fwdalign
 
 class MatrixSq;
 class MatrixSparse;
+class MatrixSparseCSR;
 class SymBDMatrix;
 
 /// \class MinResSolve
 /// \brief for solving large system of linear equations
 ///
-/// Includes MINRES, FGMRES methods as well as a few precondiotiong methods
+/// Includes MINRES, FGMRES methods as well as a few precondiotiong methods.
+/// The matrix * vector products and the ILU preconditioner use MatrixSq::GetNThreads() threads
 class MinResSolve : public TObject
 {
 
@@ -44,6 +47,7 @@ class MinResSolve : public TObject
   enum { kSolMinRes,
          kSolFGMRes,
          kNSolvers };
+  static constexpr int kMinRowsPerThread = 64; ///< min rows per thread of a level for the parallel triangular solves
 
  public:
   /// \brief default constructor
@@ -111,7 +115,19 @@ class MinResSolve : public TObject
   /// \brief ILUK preconditioner
   Int_t PreconILUKsymbDense(Int_t lofM);
 
+  /// \brief group the rows of the ILU factors in levels of independent rows for the parallel triangular solves
+  void BuildPreconILULevels();
+
  protected:
+  /// \brief fill vecOut by matrix * vecIn, using the CSR copy of the sparse matrix if available
+  void MultiplyByVec(const double* vecIn, double* vecOut) const;
+
+  /// \brief create CSR copy of the sparse matrix for the parallel product
+  void BuildMatrixCSR();
+
+  /// \brief assign the rows of the triangular matrix to levels: rows of the same level do not depend on each other
+  void BuildLevels(const MatrixSparse* mat, bool lower, std::vector<Int_t>& rows, std::vector<Int_t>& levelStart) const;
+
   Int_t fSize;       ///< dimension of the input matrix
   Int_t fPrecon;     ///< preconditioner type
   MatrixSq* fMatrix; ///< matrix defining the equations
@@ -132,6 +148,12 @@ class MinResSolve : public TObject
   MatrixSparse* fMatU; // aux. space
   SymBDMatrix* fMatBD; // aux. space
 
+  MatrixSparseCSR* fMatCSR = nullptr; //! CSR copy of the sparse matrix
+  std::vector<Int_t> fRowsL;          //! rows of L ordered by level
+  std::vector<Int_t> fLevelStartL;    //! first entry of each level in fRowsL
+  std::vector<Int_t> fRowsU;          //! rows of U ordered by level
+  std::vector<Int_t> fLevelStartU;    //! first entry of each level in fRowsU
+
   ClassDefOverride(MinResSolve, 0);
 };
 
@@ -0,0 +1,87 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+/// @file MatrixSparseCSR.cxx
+
+#include "ForwardAlign/MatrixSparseCSR.h"
+#include "ForwardAlign/MatrixSparse.h"
+
+#ifdef WITH_OPENMP
+#include <omp.h>
+#endif
+
+using namespace o2::fwdalign;
+
+//___________________________________________________________
+void MatrixSparseCSR::Build(const MatrixSparse& mat)
+{
+  const int sz = mat.GetSize();
+  const bool sym = mat.IsSymmetric();
+  // 1st pass: count elements per row, the lower triangle of the symmetric matrix contributes also to the transposed position
+  std::vector<Long64_t> nPerRow(sz + 1, 0);
+  for (int ir = 0; ir < sz; ir++) {
+    const VectorSparse* row = mat.GetRow(ir);
+    const UShort_t* ind = row->GetIndices();
+    const Double_t* elm = row->GetElems();
+    for (int iel = row->GetNElems(); iel--;) {
+      if (!elm[iel]) {
+        continue;
+      }
+      nPerRow[ir]++;
+      if (sym && ind[iel] != ir) {
+        nPerRow[ind[iel]]++;
+      }
+    }
+  }
+  fRowStart.resize(sz + 1);
+  fRowStart[0] = 0;
+  for (int ir = 0; ir < sz; ir++) {
+    fRowStart[ir + 1] = fRowStart[ir] + nPerRow[ir];
+  }
+  fColumns.resize(fRowStart[sz]);
+  fElems.resize(fRowStart[sz]);
+  // 2nd pass: fill, reusing nPerRow as the write position
+  std::copy(fRowStart.begin(), fRowStart.end() - 1, nPerRow.begin());
+  for (int ir = 0; ir < sz; ir++) {
+    const VectorSparse* row = mat.GetRow(ir);
+    const UShort_t* ind = row->GetIndices();
+    const Double_t* elm = row->GetElems();
+    for (int iel = 0; iel < row->GetNElems(); iel++) {
+      if (!elm[iel]) {
+        continue;
+      }
+      auto pos = nPerRow[ir]++;
+      fColumns[pos] = ind[iel];
+      fElems[pos] = elm[iel];
+      if (sym && ind[iel] != ir) {
+        pos = nPerRow[ind[iel]]++;
+        fColumns[pos] = ir;
+        fElems[pos] = elm[iel];
+      }
+    }
+  }
+}
+
+//___________________________________________________________
+void MatrixSparseCSR::MultiplyByVec(const Double_t* vecIn, Double_t* vecOut) const
+{
+  const int sz = GetSize();
+#ifdef WITH_OPENMP
+#pragma omp parallel for schedule(dynamic, 256) num_threads(MatrixSq::GetNThreads())
+#endif
+  for (int ir = 0; ir < sz; ir++) {
+    double vl = 0.;
+    for (auto iel = fRowStart[ir]; iel < fRowStart[ir + 1]; iel++) {
+      vl += fElems[iel] * vecIn[fColumns[iel]];
+    }
+    vecOut[ir] = vl;
+  }
+}
@@ -23,6 +23,8 @@ using namespace o2::fwdalign;
 
 ClassImp(MatrixSq);
 
+Int_t MatrixSq::fgNThreads = 1;
+
 //___________________________________________________________
 MatrixSq::MatrixSq(const MatrixSq& src)
   : TMatrixDBase(src),
@@ -11,6 +11,7 @@
 
 /// @file MinResSolve.cxx
 
+#include <algorithm>
 #include <iomanip>
 #include <TMath.h>
 #include <TStopwatch.h>
@@ -19,8 +20,13 @@
 #include "ForwardAlign/MinResSolve.h"
 #include "ForwardAlign/MatrixSq.h"
 #include "ForwardAlign/MatrixSparse.h"
+#include "ForwardAlign/MatrixSparseCSR.h"
 #include "ForwardAlign/SymBDMatrix.h"
 
+#ifdef WITH_OPENMP
+#include <omp.h>
+#endif
+
 using namespace o2::fwdalign;
 
 ClassImp(MinResSolve);
@@ -146,11 +152,11 @@ Int_t MinResSolve::BuildPrecon(Int_t prec)
   }
 
   if (fPrecon >= kPreconILU0 && fPrecon <= kPreconILU10) {
-    if (fMatrix->InheritsFrom("MatrixSparse")) {
-      return BuildPreconILUK(fPrecon - kPreconILU0);
-    } else {
-      return BuildPreconILUKDense(fPrecon - kPreconILU0);
+    int res = fMatrix->InheritsFrom("MatrixSparse") ? BuildPreconILUK(fPrecon - kPreconILU0) : BuildPreconILUKDense(fPrecon - kPreconILU0);
+    if (res >= 0) {
+      BuildPreconILULevels();
     }
+    return res;
   }
 
   return -1;
@@ -207,6 +213,7 @@ Bool_t MinResSolve::SolveFGMRES(double* VecSol, Int_t precon, int itnlim, double
       }
     }
   }
+  BuildMatrixCSR();
 
   if (!InitAuxFGMRES(nkrylov)) {
     return kFALSE;
@@ -222,7 +229,7 @@ Bool_t MinResSolve::SolveFGMRES(double* VecSol, Int_t precon, int itnlim, double
   while (1) {
 
     //-------------------- compute initial residual vector
-    fMatrix->MultiplyByVec(VecSol, fPvv[0]);
+    MultiplyByVec(VecSol, fPvv[0]);
     for (l = fSize; l--;) {
       fPvv[0][l] = fRHS[l] - fPvv[0][l]; //  fPvv[0]= initial residual
     }
@@ -263,7 +270,7 @@ Bool_t MinResSolve::SolveFGMRES(double* VecSol, Int_t precon, int itnlim, double
       }
 
       //-------------------- matvec operation w = A z_{j} = A M^{-1} v_{j}
-      fMatrix->MultiplyByVec(fPvz[i], fPvv[i1]);
+      MultiplyByVec(fPvz[i], fPvv[i1]);
 
       // modified gram - schmidt...
       // h_{i,j} = (w,v_{i})
@@ -340,14 +347,14 @@ Bool_t MinResSolve::SolveFGMRES(double* VecSol, Int_t precon, int itnlim, double
       timer.Stop();
       LOG(info) << "FGMRES converged in " << its
                 << " iterations, CPU time: "
-                << std::setprecision(1) << timer.CpuTime() << " sec";
+                << std::setprecision(1) << timer.CpuTime() << " sec, wall time: " << timer.RealTime() << " sec";
       break; // success
     }
 
     if (its >= itnlim) {
       timer.Stop();
       LOG(error) << itnlim << " iterations limit exceeded, CPU time: "
-                 << std::setprecision(1) << timer.CpuTime() << " sec";
+                 << std::setprecision(1) << timer.CpuTime() << " sec, wall time: " << timer.RealTime() << " sec";
       status = kFALSE;
       break;
     }
@@ -398,6 +405,7 @@ Bool_t MinResSolve::SolveMinRes(double* VecSol, Int_t precon, int itnlim, double
       }
     }
   }
+  BuildMatrixCSR();
   LOG(info) << "Solution by MinRes: Preconditioner #" << precon
             << " Max.iter.: " << itnlim << " Tol.: "
             << std::scientific << std::setprecision(3) << rtol;
@@ -489,7 +497,7 @@ Bool_t MinResSolve::SolveMinRes(double* VecSol, Int_t precon, int itnlim, double
     for (int i = fSize; i--;) {
       fPVecV[i] = s * fPVecY[i]; // v = vk if P = I
     }
-    fMatrix->MultiplyByVec(fPVecV, fPVecY); //      APROD (VecV, VecY);
+    MultiplyByVec(fPVecV, fPVecY); //      APROD (VecV, VecY);
 
     if (itn >= 2) {
       double btrat = beta / oldb;
@@ -636,14 +644,14 @@ Bool_t MinResSolve::SolveMinRes(double* VecSol, Int_t precon, int itnlim, double
 
   timer.Stop();
   LOG(info) << Form(
-    "Exit from MinRes: CPU time: %.2f sec\n"
+    "Exit from MinRes: CPU time: %.2f sec, wall time: %.2f sec\n"
     "Status    :  %2d\n"
     "Iterations:  %4d\n"
     "Norm      :  %+e\n"
     "Condition :  %+e\n"
     "Res.Norm  :  %+e\n"
     "Sol.Norm  :  %+e",
-    timer.CpuTime(), status, itn, normA, condA, rnorm, ynorm);
+    timer.CpuTime(), timer.RealTime(), status, itn, normA, condA, rnorm, ynorm);
 
   return status >= 0 && status <= 3;
 }
@@ -663,6 +671,41 @@ void MinResSolve::ApplyPrecon(const double* vecRHS, double* vecOut) const
     //    return;
   }
 
+  else if (fPrecon >= kPreconILU0 && fPrecon <= kPreconILU10 && !fLevelStartL.empty()) {
+    // same as below, the rows of each level are processed in parallel
+    const int nThreads = MatrixSq::GetNThreads();
+    for (size_t lev = 0; lev + 1 < fLevelStartL.size(); lev++) { // Block L solve
+      const int first = fLevelStartL[lev], last = fLevelStartL[lev + 1];
+#ifdef WITH_OPENMP
+#pragma omp parallel for num_threads(nThreads) if (last - first >= kMinRowsPerThread * nThreads)
+#endif
+      for (int k = first; k < last; k++) {
+        const int i = fRowsL[k];
+        VectorSparse& rowLi = *fMatL->GetRow(i);
+        double vl = vecRHS[i];
+        for (int j = 0; j < rowLi.GetNElems(); j++) {
+          vl -= vecOut[rowLi.GetIndex(j)] * rowLi.GetElem(j);
+        }
+        vecOut[i] = vl;
+      }
+    }
+    for (size_t lev = 0; lev + 1 < fLevelStartU.size(); lev++) { // Block -- U solve
+      const int first = fLevelStartU[lev], last = fLevelStartU[lev + 1];
+#ifdef WITH_OPENMP
+#pragma omp parallel for num_threads(nThreads) if (last - first >= kMinRowsPerThread * nThreads)
+#endif
+      for (int k = first; k < last; k++) {
+        const int i = fRowsU[k];
+        VectorSparse& rowUi = *fMatU->GetRow(i);
+        double vl = vecOut[i];
+        for (int j = 0; j < rowUi.GetNElems(); j++) {
+          vl -= vecOut[rowUi.GetIndex(j)] * rowUi.GetElem(j);
+        }
+        vecOut[i] = vl * fDiagLU[i];
+      }
+    }
+  }
+
   else if (fPrecon >= kPreconILU0 && fPrecon <= kPreconILU10) {
 
     for (int i = 0; i < fSize; i++) { // Block L solve
@@ -770,6 +813,88 @@ void MinResSolve::ClearAux()
     delete fMatBD;
   }
   fMatBD = nullptr;
+  delete fMatCSR;
+  fMatCSR = nullptr;
+  fRowsL.clear();
+  fLevelStartL.clear();
+  fRowsU.clear();
+  fLevelStartU.clear();
+}
+
+//___________________________________________________________
+void MinResSolve::MultiplyByVec(const double* vecIn, double* vecOut) const
+{
+  if (fMatCSR) {
+    fMatCSR->MultiplyByVec(vecIn, vecOut);
+  } else {
+    fMatrix->MultiplyByVec(vecIn, vecOut);
+  }
+}
+
+//___________________________________________________________
+void MinResSolve::BuildMatrixCSR()
+{
+  if (fMatCSR || !fMatrix->InheritsFrom("MatrixSparse")) {
+    return;
+  }
+  TStopwatch sw;
+  sw.Start();
+  fMatCSR = new MatrixSparseCSR(*(MatrixSparse*)fMatrix);
+  sw.Stop();
+  LOG(info) << "CSR copy of the matrix with " << fMatCSR->GetNElems() << " elements built in "
+            << std::setprecision(2) << sw.RealTime() << " sec, " << MatrixSq::GetNThreads() << " threads will be used";
+}
+
+//___________________________________________________________
+void MinResSolve::BuildPreconILULevels()
+{
+  if (MatrixSq::GetNThreads() < 2) {
+    return;
+  }
+  BuildLevels(fMatL, true, fRowsL, fLevelStartL);
+  BuildLevels(fMatU, false, fRowsU, fLevelStartU);
+  const int nLevels = std::max(fLevelStartL.size(), fLevelStartU.size()) - 1;
+  // synchronization at each level does not pay off if the levels are small
+  if (nLevels * kMinRowsPerThread * MatrixSq::GetNThreads() > fSize) {
+    LOG(info) << "ILU factors have " << nLevels << " levels for " << fSize << " rows, using sequential triangular solves";
+    fRowsL.clear();
+    fLevelStartL.clear();
+    fRowsU.clear();
+    fLevelStartU.clear();
+  } else {
+    LOG(info) << "ILU factors have " << nLevels << " levels for " << fSize << " rows, using parallel triangular solves";
+  }
+}
+
+//___________________________________________________________
+void MinResSolve::BuildLevels(const MatrixSparse* mat, bool lower, std::vector<Int_t>& rows, std::vector<Int_t>& levelStart) const
+{
+  // the row depends on the rows of its column indices: lower (upper) triangle rows are processed in increasing (decreasing) order
+  std::vector<Int_t> level(fSize, 0);
+  int nLevels = 0;
+  for (int n = 0; n < fSize; n++) {
+    const int i = lower ? n : fSize - 1 - n;
+    VectorSparse& row = *mat->GetRow(i);
+    int lev = 0;
+    for (int j = row.GetNElems(); j--;) {
+      lev = std::max(lev, level[row.GetIndex(j)] + 1);
+    }
+    level[i] = lev;
+    nLevels = std::max(nLevels, lev + 1);
+  }
+  levelStart.assign(nLevels + 1, 0);
+  for (int i = 0; i < fSize; i++) {
+    levelStart[level[i] + 1]++;
+  }
+  for (int lev = 0; lev < nLevels; lev++) {
+    levelStart[lev + 1] += levelStart[lev];
+  }
+  rows.resize(fSize);
+  std::vector<Int_t> pos(levelStart.begin(), levelStart.end() - 1);
+  for (int n = 0; n < fSize; n++) {
+    const int i = lower ? n : fSize - 1 - n;
+    rows[pos[level[i]]++] = i;
+  }
 }
 
 //___________________________________________________________
@@ -18,6 +18,10 @@
 #include "ForwardAlign/SymMatrix.h"
 #include "Framework/Logger.h"
 
+#ifdef WITH_OPENMP
+#include <omp.h>
+#endif
+
 using namespace o2::fwdalign;
 
 ClassImp(SymMatrix);
@@ -218,11 +222,17 @@ void SymMatrix::Print(Option_t* option) const
 //___________________________________________________________
 void SymMatrix::MultiplyByVec(const Double_t* vecIn, Double_t* vecOut) const
 {
-  for (int i = GetSizeUsed(); i--;) {
-    vecOut[i] = 0.0;
-    for (int j = GetSizeUsed(); j--;) {
-      vecOut[i] += vecIn[j] * GetEl(i, j);
+  // rows are independent
+  const int sz = GetSizeUsed();
+#ifdef WITH_OPENMP
+#pragma omp parallel for schedule(dynamic, 64) num_threads(fgNThreads)
+#endif
+  for (int i = 0; i < sz; i++) {
+    double vl = 0.0;
+    for (int j = sz; j--;) {
+      vl += vecIn[j] * GetEl(i, j);
     }
+    vecOut[i] = vl;
   }
 }
 
@@ -0,0 +1,114 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+/// \file benchmark_MinResSolve.cxx
+/// \brief Benchmark of the sparse matrix * vector product and of the iterative solution of the global equations
+
+#include "benchmark/benchmark.h"
+#include "ForwardAlign/MatrixSparse.h"
+#include "ForwardAlign/MatrixSparseCSR.h"
+#include "ForwardAlign/MinResSolve.h"
+#include <algorithm>
+#include <cmath>
+#include <memory>
+#include <random>
+#include <vector>
+
+using namespace o2::fwdalign;
+
+constexpr int MatSize = 20000;
+
+/// symmetric positive definite matrix with the structure of the alignment problem:
+/// blocks of correlated parameters of neighbouring sensors plus random couplings by tracks
+std::unique_ptr<MatrixSparse> generateMatrix(int size)
+{
+  std::mt19937 gen(12345);
+  std::uniform_real_distribution<double> val(-1., 1.);
+  std::uniform_int_distribution<int> col(0, size - 1);
+  auto mat = std::make_unique<MatrixSparse>(size);
+  mat->SetSymmetric(kTRUE);
+  for (int i = 0; i < size; i++) {
+    double offDiag = 0;
+    for (int j = std::max(0, i - 12); j < i; j++) {
+      double v = val(gen);
+      (*mat)(i, j) += v;
+      offDiag += std::abs(v);
+    }
+    for (int k = 0; k < 8; k++) {
+      int j = col(gen);
+      if (j < i) {
+        double v = 0.1 * val(gen);
+        (*mat)(i, j) += v;
+        offDiag += std::abs(v);
+      }
+    }
+    mat->DiagElem(i) += 2. * offDiag + 1.; // the column part is accounted for by the factor 2
+  }
+  return mat;
+}
+
+std::vector<double> generateVector(int size)
+{
+  std::mt19937 gen(54321);
+  std::uniform_real_distribution<double> val(-1., 1.);
+  std::vector<double> vec(size);
+  for (auto& v : vec) {
+    v = val(gen);
+  }
+  return vec;
+}
+
+static void BM_MultiplyByVecSparse(benchmark::State& state)
+{
+  auto mat = generateMatrix(MatSize);
+  auto vecIn = generateVector(MatSize);
+  std::vector<double> vecOut(MatSize);
+  for (auto _ : state) {
+    mat->MultiplyByVec(vecIn.data(), vecOut.data());
+    benchmark::DoNotOptimize(vecOut.data());
+  }
+  state.SetItemsProcessed(state.iterations() * MatSize);
+}
+
+static void BM_MultiplyByVecCSR(benchmark::State& state)
+{
+  MatrixSq::SetNThreads(state.range(0));
+  auto mat = generateMatrix(MatSize);
+  MatrixSparseCSR csr(*mat);
+  auto vecIn = generateVector(MatSize);
+  std::vector<double> vecOut(MatSize);
+  for (auto _ : state) {
+    csr.MultiplyByVec(vecIn.data(), vecOut.data());
+    benchmark::DoNotOptimize(vecOut.data());
+  }
+  state.SetItemsProcessed(state.iterations() * MatSize);
+  MatrixSq::SetNThreads(1);
+}
+
+static void BM_SolveMinRes(benchmark::State& state)
+{
+  MatrixSq::SetNThreads(state.range(1));
+  auto mat = generateMatrix(MatSize);
+  auto rhs = generateVector(MatSize);
+  std::vector<double> sol(MatSize);
+  for (auto _ : state) {
+    MinResSolve solver(mat.get(), rhs.data());
+    benchmark::DoNotOptimize(solver.SolveMinRes(sol.data(), state.range(0), 2000, 1e-12));
+  }
+  MatrixSq::SetNThreads(1);
+}
+
+BENCHMARK(BM_MultiplyByVecSparse);
+BENCHMARK(BM_MultiplyByVecCSR)->Arg(1)->Arg(4)->Arg(8);
+// no preconditioner and ILU0
+BENCHMARK(BM_SolveMinRes)->Args({0, 1})->Args({0, 8})->Args({MinResSolve::kPreconILU0, 1})->Args({MinResSolve::kPreconILU0, 8})->Unit(benchmark::kMillisecond);
+
+BENCHMARK_MAIN();
@@ -19,6 +19,7 @@
 #include "TFile.h"
 #include "TTree.h"
 #include "TGrid.h"
+#include "TStopwatch.h"
 #include "Framework/Task.h"
 #include "Framework/ConfigParamRegistry.h"
 #include "Framework/ControlService.h"
@@ -138,6 +139,7 @@ void TPCResidualReader::init(InitContext& ic)
   }
 
   mStoreBinnedResiduals = ic.options().get<bool>("store-binned");
+  mTrackResiduals.setNThreads(ic.options().get<int>("nthreads"));
 }
 
 void TPCResidualReader::run(ProcessingContext& pc)
@@ -221,6 +223,7 @@ void TPCResidualReader::run(ProcessingContext& pc)
     }
   }
 
+  TStopwatch swMap;
   for (int iSec = 0; iSec < SECTORSPERSIDE * SIDES; ++iSec) {
     if (mDoBinning) {
       // for each sector fill the vector of local residuals from the respective branch
@@ -247,6 +250,8 @@ void TPCResidualReader::run(ProcessingContext& pc)
     // do cleanup
     mTrackResiduals.clear();
   }
+  swMap.Stop();
+  LOGP(info, "Map extraction for {} sectors took {:.2f} s real / {:.2f} s CPU time with {} threads", SECTORSPERSIDE * SIDES, swMap.RealTime(), swMap.CpuTime(), mTrackResiduals.getNThreads());
 
   mTrackResiduals.closeOutputFile(); // FIXME remove when map output is handled properly
 
@@ -323,6 +328,7 @@ DataProcessorSpec getTPCResidualReaderSpec(bool doBinning, GID::mask_t src)
       {"outfile", VariantType::String, "debugVoxRes.root", {"Output file name"}},
       {"store-binned", VariantType::Bool, false, {"Store the binned residuals together with the voxel results"}},
       {"dont-check-file-access", VariantType::Bool, false, {"Deactivate check if all files are accessible before adding them to the list of files"}},
+      {"nthreads", VariantType::Int, 1, {"Number of threads used for the voxel processing of each sector"}},
     }};
 }
 
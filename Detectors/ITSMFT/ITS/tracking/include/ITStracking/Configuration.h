@@ -75,6 +75,8 @@ struct TrackingParameters {
   int ZBins{256};
   int PhiBins{128};
   int nROFsPerIterations = -1;
+  bool ReleaseSliceMemory = false;
+  bool UseArenaAllocator = false;
   bool UseDiamond = false;
   float Diamond[3] = {0.f, 0.f, 0.f};
 
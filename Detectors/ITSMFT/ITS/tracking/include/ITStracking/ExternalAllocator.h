@@ -16,6 +16,10 @@
 #ifndef TRACKINGITSU_INCLUDE_EXTERNALALLOCATOR_H_
 #define TRACKINGITSU_INCLUDE_EXTERNALALLOCATOR_H_
 
+#include <cstddef>
+#include <memory_resource>
+#include <vector>
+
 namespace o2::its
 {
 
@@ -25,6 +29,116 @@ class ExternalAllocator
   virtual void* allocate(size_t) = 0;
 };
 
+/// Monotonic CPU arena for the temporary containers of the tracker and of the vertexer.
+/// Memory is handed out by bumping a pointer and is released all at once by reset(): if more than
+/// one block was needed, the blocks are merged into a single one sized on the peak usage, so that in
+/// steady state every timeframe is served from one region without calls to the system allocator.
+/// The arena is not thread safe, allocations must come from serial sections or be serialised.
+class ArenaAllocator final : public ExternalAllocator, public std::pmr::memory_resource
+{
+ public:
+  explicit ArenaAllocator(size_t initialSize = 1ul << 24) : mBlockSize{initialSize} {}
+  ArenaAllocator(const ArenaAllocator&) = delete;
+  ArenaAllocator& operator=(const ArenaAllocator&) = delete;
+  ~ArenaAllocator() override { releaseBlocks(); }
+
+  void* allocate(size_t size) final { return do_allocate(size, alignof(std::max_align_t)); }
+  void reset();
+
+  size_t getUsedMemory() const { return mUsedMemory; }
+  size_t getPeakMemory() const { return mPeakMemory; }
+  size_t getCapacity() const;
+  size_t getNBlockAllocations() const { return mNBlockAllocations; }
+
+ private:
+  struct Block {
+    char* data = nullptr;
+    size_t size = 0;
+  };
+
+  void* do_allocate(size_t bytes, size_t alignment) final;
+  void do_deallocate(void*, size_t, size_t) final {} // memory is only given back by reset()
+  bool do_is_equal(const std::pmr::memory_resource& other) const noexcept final { return this == &other; }
+  void addBlock(size_t minSize);
+  void releaseBlocks();
+
+  std::vector<Block> mBlocks;
+  size_t mBlockSize = 0;   // size of the next block to be allocated
+  size_t mCurrBlock = 0;   // block currently used for the allocations
+  size_t mOffset = 0;      // first free byte in the current block
+  size_t mUsedMemory = 0;  // bytes handed out since the last reset
+  size_t mPeakMemory = 0;  // maximum of mUsedMemory over the resets
+  size_t mNBlockAllocations = 0;
+};
+
+inline size_t ArenaAllocator::getCapacity() const
+{
+  size_t capacity{0};
+  for (const auto& block : mBlocks) {
+    capacity += block.size;
+  }
+  return capacity;
+}
+
+inline void ArenaAllocator::addBlock(size_t minSize)
+{
+  size_t size = mBlockSize;
+  while (size < minSize) {
+    size <<= 1;
+  }
+  mBlocks.push_back(Block{static_cast<char*>(::operator new(size, std::align_val_t{alignof(std::max_align_t)})), size});
+  mBlockSize = size << 1;
+  mNBlockAllocations++;
+}
+
+inline void ArenaAllocator::releaseBlocks()
+{
+  for (auto& block : mBlocks) {
+    ::operator delete(block.data, std::align_val_t{alignof(std::max_align_t)});
+  }
+  mBlocks.clear();
+}
+
+inline void* ArenaAllocator::do_allocate(size_t bytes, size_t alignment)
+{
+  while (true) {
+    if (mCurrBlock < mBlocks.size()) {
+      auto& block = mBlocks[mCurrBlock];
+      size_t start = (reinterpret_cast<size_t>(block.data) + mOffset + alignment - 1) & ~(alignment - 1);
+      size_t end = start + bytes - reinterpret_cast<size_t>(block.data);
+      if (end <= block.size) {
+        mUsedMemory += end - mOffset;
+        mOffset = end;
+        return reinterpret_cast<void*>(start);
+      }
+      if (mCurrBlock + 1 < mBlocks.size()) {
+        mCurrBlock++;
+        mOffset = 0;
+        continue;
+      }
+    }
+    addBlock(bytes + alignment);
+    mCurrBlock = mBlocks.size() - 1;
+    mOffset = 0;
+  }
+}
+
+inline void ArenaAllocator::reset()
+{
+  mPeakMemory = mPeakMemory > mUsedMemory ? mPeakMemory : mUsedMemory;
+  if (mBlocks.size() > 1) { // merge into a single region, sized on the largest round so far with some headroom
+    releaseBlocks();
+    mBlockSize = mPeakMemory + mPeakMemory / 8;
+    addBlock(mBlockSize);
+  }
+  mCurrBlock = 0;
+  mOffset = 0;
+  mUsedMemory = 0;
+}
+
+template <typename T>
+using ArenaVector = std::pmr::vector<T>;
+
 } // namespace o2::its
 
 #endif
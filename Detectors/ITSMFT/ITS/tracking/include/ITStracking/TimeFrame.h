@@ -14,6 +14,8 @@
 #define TRACKINGITSU_INCLUDE_TIMEFRAME_H_
 
 #include <array>
+#include <memory>
+#include <memory_resource>
 #include <vector>
 #include <utility>
 #include <numeric>
@@ -180,8 +182,17 @@ class TimeFrame
   auto getNumberOfExtendedTracks() const { return mNExtendedTracks; }
   auto getNumberOfUsedExtendedClusters() const { return mNExtendedUsedClusters; }
 
-  bool checkMemory(unsigned long max) { return getArtefactsMemory() < max; }
+  bool checkMemory(unsigned long max)
+  {
+    updateArtefactsMemoryPeak();
+    return getArtefactsMemory() < max;
+  }
   unsigned long getArtefactsMemory();
+  unsigned long getArtefactsAllocatedMemory();
+  void updateArtefactsMemoryPeak() { mArtefactsMemoryPeak = std::max(mArtefactsMemoryPeak, getArtefactsAllocatedMemory()); }
+  unsigned long getArtefactsMemoryPeak() const { return mArtefactsMemoryPeak; }
+  void resetArtefactsMemoryPeak() { mArtefactsMemoryPeak = 0; }
+  void releaseArtefactsMemory();
   int getROFCutClusterMult() const { return mCutClusterMult; };
   int getROFCutVertexMult() const { return mCutVertexMult; };
   int getROFCutAllMult() const { return mCutClusterMult + mCutVertexMult; }
@@ -250,6 +261,17 @@ class TimeFrame
   void setExtAllocator(bool ext) { mExtAllocator = ext; }
   bool getExtAllocator() const { return mExtAllocator; }
 
+  /// CPU arena for the per-iteration temporaries of the tracker and of the vertexer
+  void useArenaAllocator(bool use);
+  void resetArena()
+  {
+    if (mArena) {
+      mArena->reset();
+    }
+  }
+  std::pmr::memory_resource* getMemoryResource() { return mArena ? static_cast<std::pmr::memory_resource*>(mArena.get()) : std::pmr::get_default_resource(); }
+  const ArenaAllocator* getArena() const { return mArena.get(); }
+
   /// Debug and printing
   void checkTrackletLUTs();
   void printROFoffsets();
@@ -285,6 +307,7 @@ class TimeFrame
   // State if memory will be externally managed.
   bool mExtAllocator = false;
   ExternalAllocator* mAllocator = nullptr;
+  std::unique_ptr<ArenaAllocator> mArena;
   std::vector<std::vector<Cluster>> mUnsortedClusters;
   std::vector<std::vector<Tracklet>> mTracklets;
   std::vector<std::vector<CellSeed>> mCells;
@@ -313,6 +336,7 @@ class TimeFrame
 
  private:
   void prepareClusters(const TrackingParameters& trkParam, const int maxLayers);
+  unsigned long mArtefactsMemoryPeak = 0; // peak allocated memory of the tracking artefacts in the current TF
   float mBz = 5.;
   unsigned int mNTotalLowPtVertices = 0;
   int mBeamPosWeight = 0;
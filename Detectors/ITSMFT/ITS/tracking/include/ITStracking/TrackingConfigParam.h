@@ -79,7 +79,9 @@ struct TrackerParamConfig : public o2::conf::ConfigurableParamHelper<TrackerPara
   int findShortTracks = -1;
   int nThreads = 1;                        // number of threads to perform the operations in parallel.
   int nROFsPerIterations = 0;              // size of the slice of ROFs to be processed at a time, preferably integer divisors of nROFs per TF, to balance the iterations.
-  int nOrbitsPerIterations = 0;            // not implemented: size of the slice of ROFs to be processed at a time, computed using the number of ROFs per orbit.
+  int nOrbitsPerIterations = 0;            // size of the slice of ROFs to be processed at a time, computed using the number of ROFs per orbit. Takes precedence over nROFsPerIterations.
+  bool releaseSliceMemory = false;         // release the tracklet, cell and neighbour buffers after each slice of ROFs, to bound the memory footprint.
+  bool useArenaAllocator = false;          // serve the per-iteration temporaries of the road finding and of the vertexer from a reusable CPU arena.
   bool perPrimaryVertexProcessing = false; // perform the full tracking considering the vertex hypotheses one at the time.
   bool saveTimeBenchmarks = false;         // dump metrics on file
   bool overrideBeamEstimation = false;     // use beam position from meanVertex CCDB object
@@ -466,6 +466,69 @@ unsigned long TimeFrame::getArtefactsMemory()
   return size + sizeof(Road<5>) * mRoads.size();
 }
 
+unsigned long TimeFrame::getArtefactsAllocatedMemory()
+{
+  unsigned long size{0};
+  for (auto& trkl : mTracklets) {
+    size += sizeof(Tracklet) * trkl.capacity();
+  }
+  for (auto& lbl : mTrackletLabels) {
+    size += sizeof(MCCompLabel) * lbl.capacity();
+  }
+  for (auto& cells : mCells) {
+    size += sizeof(CellSeed) * cells.capacity();
+  }
+  for (auto& lbl : mCellLabels) {
+    size += sizeof(MCCompLabel) * lbl.capacity();
+  }
+  for (auto& lut : mCellsLookupTable) {
+    size += sizeof(int) * lut.capacity();
+  }
+  for (auto& cellsN : mCellsNeighbours) {
+    size += sizeof(int) * cellsN.capacity();
+  }
+  for (auto& lut : mCellsNeighboursLUT) {
+    size += sizeof(int) * lut.capacity();
+  }
+  return size + sizeof(Road<5>) * mRoads.capacity();
+}
+
+void TimeFrame::releaseArtefactsMemory()
+{
+  // the tracklet lookup tables are sized on the clusters and kept, everything else is rebuilt for every ROF slice
+  for (auto& trkl : mTracklets) {
+    deepVectorClear(trkl);
+  }
+  for (auto& lbl : mTrackletLabels) {
+    deepVectorClear(lbl);
+  }
+  for (auto& cells : mCells) {
+    deepVectorClear(cells);
+  }
+  for (auto& lbl : mCellLabels) {
+    deepVectorClear(lbl);
+  }
+  for (auto& lut : mCellsLookupTable) {
+    deepVectorClear(lut);
+  }
+  for (auto& cellsN : mCellsNeighbours) {
+    deepVectorClear(cellsN);
+  }
+  for (auto& lut : mCellsNeighboursLUT) {
+    deepVectorClear(lut);
+  }
+  deepVectorClear(mRoads);
+}
+
+void TimeFrame::useArenaAllocator(bool use)
+{
+  if (!use) {
+    mArena.reset();
+  } else if (!mArena) {
+    mArena = std::make_unique<ArenaAllocator>();
+  }
+}
+
 void TimeFrame::fillPrimaryVerticesXandAlpha()
 {
   if (mPValphaX.size()) {
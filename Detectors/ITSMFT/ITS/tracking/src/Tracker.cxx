@@ -22,6 +22,8 @@
 #include "ITStracking/Tracklet.h"
 #include "ITStracking/TrackerTraits.h"
 #include "ITStracking/TrackingConfigParam.h"
+#include "ITSMFTBase/DPLAlpideParam.h"
+#include "CommonConstants/LHCConstants.h"
 
 #include "ReconstructionDataFormats/Track.h"
 #include <cassert>
@@ -50,6 +52,8 @@ void Tracker::clustersToTracks(std::function<void(std::string s)> logger, std::f
 {
   double total{0};
   mTraits->UpdateTrackingParameters(mTrkParams);
+  mTimeFrame->resetArtefactsMemoryPeak();
+  mTimeFrame->useArenaAllocator(mTrkParams[0].UseArenaAllocator);
   int maxNvertices{-1};
   if (mTrkParams[0].PerPrimaryVertexProcessing) {
     for (int iROF{0}; iROF < mTimeFrame->getNrof(); ++iROF) {
@@ -115,6 +119,11 @@ void Tracker::clustersToTracks(std::function<void(std::string s)> logger, std::f
         nNeighbours += mTimeFrame->getNumberOfNeighbours();
         timeRoads += evaluateTask(
           &Tracker::findRoads, "Road finding", [](std::string) {}, iteration);
+        mTimeFrame->updateArtefactsMemoryPeak();
+        // the artefacts of the last slice are still used by findShortPrimaries
+        if (mTrkParams[iteration].ReleaseSliceMemory && iROFs < nROFsIterations - 1) {
+          mTimeFrame->releaseArtefactsMemory();
+        }
       }
       iVertex++;
     } while (iVertex < maxNvertices && !dropTF);
@@ -137,6 +146,7 @@ void Tracker::clustersToTracks(std::function<void(std::string s)> logger, std::f
   }
 
   total += evaluateTask(&Tracker::findShortPrimaries, "Short primaries finding", logger);
+  logger(fmt::format(" - Peak memory allocated for tracking artefacts: {:.2f} GB", mTimeFrame->getArtefactsMemoryPeak() / GB));
 
   std::stringstream sstream;
   if constexpr (constants::DoTimeBenchmarks) {
@@ -492,7 +502,10 @@ void Tracker::getGlobalConfiguration()
   setNThreads(tc.nThreads);
   int nROFsPerIterations = tc.nROFsPerIterations > 0 ? tc.nROFsPerIterations : -1;
   if (tc.nOrbitsPerIterations > 0) {
-    /// code to be used when the number of ROFs per orbit is known, this gets priority over the number of ROFs per iteration
+    /// the number of ROFs per orbit is known from the Alpide parameters, this gets priority over the number of ROFs per iteration
+    const auto& alpParams = o2::itsmft::DPLAlpideParam<o2::detectors::DetID::ITS>::Instance();
+    int nROFsPerOrbit = alpParams.roFrameLengthInBC > 0 ? std::max(1, o2::constants::lhc::LHCMaxBunches / alpParams.roFrameLengthInBC) : 1;
+    nROFsPerIterations = tc.nOrbitsPerIterations * nROFsPerOrbit;
   }
   for (auto& params : mTrkParams) {
     if (params.NLayers == 7) {
@@ -512,6 +525,8 @@ void Tracker::getGlobalConfiguration()
     params.CellDeltaTanLambdaSigma *= tc.deltaTanLres > 0 ? tc.deltaTanLres : 1.f;
     params.TrackletMinPt *= tc.minPt > 0 ? tc.minPt : 1.f;
     params.nROFsPerIterations = nROFsPerIterations;
+    params.ReleaseSliceMemory = tc.releaseSliceMemory;
+    params.UseArenaAllocator = tc.useArenaAllocator;
     params.PerPrimaryVertexProcessing = tc.perPrimaryVertexProcessing;
     params.SaveTimeBenchmarks = tc.saveTimeBenchmarks;
     params.FataliseUponFailure = tc.fataliseUponFailure;
@@ -467,7 +467,7 @@ void TrackerTraits::findCellsNeighbours(const int iteration)
   }
 }
 
-void TrackerTraits::processNeighbours(int iLayer, int iLevel, const std::vector<CellSeed>& currentCellSeed, const std::vector<int>& currentCellId, std::vector<CellSeed>& updatedCellSeeds, std::vector<int>& updatedCellsIds)
+void TrackerTraits::processNeighbours(int iLayer, int iLevel, gsl::span<const CellSeed> currentCellSeed, gsl::span<const int> currentCellId, ArenaVector<CellSeed>& updatedCellSeeds, ArenaVector<int>& updatedCellsIds)
 {
   if (iLevel < 2 || iLayer < 1) {
     std::cout << "Error: layer " << iLayer << " or level " << iLevel << " cannot be processed by processNeighbours" << std::endl;
@@ -568,17 +568,25 @@ void TrackerTraits::processNeighbours(int iLayer, int iLevel, const std::vector<
 void TrackerTraits::findRoads(const int iteration)
 {
   CA_DEBUGGER(std::cout << "Finding roads, iteration " << iteration << std::endl);
+  mTimeFrame->resetArena(); /// the temporaries of the previous call are gone, recycle their memory
+  auto* resource = mTimeFrame->getMemoryResource();
+  /// the arena does not release memory before the next reset: the buffers are reused by all the levels and layers
+  ArenaVector<CellSeed> trackSeeds(resource), lastCellSeed(resource), updatedCellSeed(resource);
+  ArenaVector<int> lastCellId(resource), updatedCellId(resource);
+  ArenaVector<TrackITSExt> tracks(resource);
   for (int startLevel{mTrkParams[iteration].CellsPerRoad()}; startLevel >= mTrkParams[iteration].CellMinimumLevel(); --startLevel) {
     CA_DEBUGGER(std::cout << "\t > Processing level " << startLevel << std::endl);
     const int minimumLayer{startLevel - 1};
-    std::vector<CellSeed> trackSeeds;
+    trackSeeds.clear();
     for (int startLayer{mTrkParams[iteration].CellsPerRoad() - 1}; startLayer >= minimumLayer; --startLayer) {
       if ((mTrkParams[iteration].StartLayerMask & (1 << (startLayer + 2))) == 0) {
         continue;
       }
       CA_DEBUGGER(std::cout << "\t\t > Starting processing layer " << startLayer << std::endl);
-      std::vector<int> lastCellId, updatedCellId;
-      std::vector<CellSeed> lastCellSeed, updatedCellSeed;
+      lastCellId.clear();
+      updatedCellId.clear();
+      lastCellSeed.clear();
+      updatedCellSeed.clear();
 
       processNeighbours(startLayer, startLevel, mTimeFrame->getCells()[startLayer], lastCellId, updatedCellSeed, updatedCellId);
 
@@ -586,7 +594,7 @@ void TrackerTraits::findRoads(const int iteration)
       for (int iLayer{startLayer - 1}; iLayer > 0 && level > 2; --iLayer) {
         lastCellSeed.swap(updatedCellSeed);
         lastCellId.swap(updatedCellId);
-        std::vector<CellSeed>().swap(updatedCellSeed); /// tame the memory peaks
+        updatedCellSeed.clear();
         updatedCellId.clear();
         processNeighbours(iLayer, --level, lastCellSeed, lastCellId, updatedCellSeed, updatedCellId);
       }
@@ -598,7 +606,8 @@ void TrackerTraits::findRoads(const int iteration)
       }
     }
 
-    std::vector<TrackITSExt> tracks(trackSeeds.size());
+    tracks.clear();
+    tracks.resize(trackSeeds.size());
     std::atomic<size_t> trackIndex{0};
 #pragma omp parallel for num_threads(mNThreads)
     for (size_t seedId = 0; seedId < trackSeeds.size(); ++seedId) {
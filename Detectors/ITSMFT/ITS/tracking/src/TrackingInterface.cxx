@@ -180,6 +180,7 @@ void ITSTrackingInterface::run(framework::ProcessingContext& pc)
   int cutVertexMult{0}, cutUPCVertex{0}, cutRandomMult = int(trackROFvec.size()) - multEst.selectROFs(trackROFvec, compClusters, physTriggers, processingMask);
   processUPCMask.resize(processingMask.size(), false);
   mTimeFrame->setMultiplicityCutMask(processingMask);
+  mTimeFrame->useArenaAllocator(mTracker->getParameters()[0].UseArenaAllocator);
   float vertexerElapsedTime{0.f};
   if (mRunVertexer) {
     vertROFvec.reserve(trackROFvec.size());
@@ -324,6 +325,10 @@ void ITSTrackingInterface::run(framework::ProcessingContext& pc)
       }
     }
     LOGP(info, "ITSTracker pushed {} tracks and {} vertices", allTracks.size(), vertices.size());
+    LOGP(info, "ITSTracker peak memory of tracking artefacts: {:.2f} GB", mTimeFrame->getArtefactsMemoryPeak() / constants::GB);
+    if (mTimeFrame->getArena()) {
+      LOGP(info, "ITSTracker arena for temporaries: peak {:.2f} GB, capacity {:.2f} GB, {} block allocations", mTimeFrame->getArena()->getPeakMemory() / constants::GB, mTimeFrame->getArena()->getCapacity() / constants::GB, mTimeFrame->getArena()->getNBlockAllocations());
+    }
     if (mIsMC) {
       LOGP(info, "ITSTracker pushed {} track labels", allTrackLabels.size());
       LOGP(info, "ITSTracker pushed {} vertex labels", allVerticesLabels.size());
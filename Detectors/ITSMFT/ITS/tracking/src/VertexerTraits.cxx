@@ -406,14 +406,17 @@ void VertexerTraits::computeVertices(const int iteration)
 #ifdef VTX_DEBUG
   std::vector<std::vector<ClusterLines>> dbg_clusLines(mTimeFrame->getNrof());
 #endif
-  std::vector<int> noClustersVec(mTimeFrame->getNrof(), 0);
+  mTimeFrame->resetArena();
+  auto* resource = mTimeFrame->getMemoryResource();
+  ArenaVector<int> noClustersVec(mTimeFrame->getNrof(), 0, resource);
+  ArenaVector<bool> usedTracklets(resource); /// reused by all the ROFs
   for (int rofId{0}; rofId < mTimeFrame->getNrof(); ++rofId) {
     if (iteration && (int)mTimeFrame->getPrimaryVertices(rofId).size() > mVrtParams[iteration].vertPerRofThreshold) {
       continue;
     }
     const int numTracklets{static_cast<int>(mTimeFrame->getLines(rofId).size())};
 
-    std::vector<bool> usedTracklets(numTracklets, false);
+    usedTracklets.assign(numTracklets, false);
     for (int line1{0}; line1 < numTracklets; ++line1) {
       if (usedTracklets[line1]) {
         continue;
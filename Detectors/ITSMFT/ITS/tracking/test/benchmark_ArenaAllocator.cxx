@@ -0,0 +1,94 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+/// \file benchmark_ArenaAllocator.cxx
+/// \brief Benchmark of the road finding temporaries served by the arena vs the default allocator
+
+#include "benchmark/benchmark.h"
+#include "ITStracking/Cell.h"
+#include "ITStracking/ExternalAllocator.h"
+#include "DataFormatsITS/TrackITS.h"
+#include <random>
+#include <vector>
+
+using namespace o2::its;
+
+/// Same allocation pattern as TrackerTraits::findRoads: for each level and
+/// start layer the neighbours are followed inwards, swapping the seed buffers,
+/// then the surviving seeds are turned into tracks. The buffers are reused by
+/// all the levels and layers.
+template <typename Make>
+size_t findRoadsPattern(Make make, int nSeeds, std::mt19937& gen)
+{
+  size_t nTracks{0};
+  auto trackSeeds = make.template operator()<CellSeed>();
+  auto lastCellSeed = make.template operator()<CellSeed>();
+  auto updatedCellSeed = make.template operator()<CellSeed>();
+  auto lastCellId = make.template operator()<int>();
+  auto updatedCellId = make.template operator()<int>();
+  auto tracks = make.template operator()<TrackITSExt>();
+  for (int level{5}; level >= 3; --level) {
+    trackSeeds.clear();
+    for (int startLayer{4}; startLayer >= level - 1; --startLayer) {
+      lastCellSeed.clear();
+      updatedCellSeed.clear();
+      lastCellId.clear();
+      updatedCellId.clear();
+      int n = nSeeds + gen() % (nSeeds / 4 + 1);
+      for (int i{0}; i < n; ++i) {
+        updatedCellSeed.emplace_back();
+        updatedCellId.push_back(i);
+      }
+      for (int iLayer{startLayer - 1}; iLayer > 0; --iLayer) {
+        lastCellSeed.swap(updatedCellSeed);
+        lastCellId.swap(updatedCellId);
+        updatedCellSeed.clear();
+        updatedCellId.clear();
+        n = n * 3 / 4;
+        for (int i{0}; i < n; ++i) {
+          updatedCellSeed.push_back(lastCellSeed[i]);
+          updatedCellId.push_back(lastCellId[i]);
+        }
+      }
+      trackSeeds.insert(trackSeeds.end(), updatedCellSeed.begin(), updatedCellSeed.end());
+    }
+    tracks.clear();
+    tracks.resize(trackSeeds.size());
+    nTracks += tracks.size();
+  }
+  return nTracks;
+}
+
+static void BM_FindRoadsDefault(benchmark::State& state)
+{
+  std::mt19937 gen(12345);
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(findRoadsPattern([]<typename T>() { return std::vector<T>(); }, state.range(0), gen));
+  }
+}
+
+static void BM_FindRoadsArena(benchmark::State& state)
+{
+  std::mt19937 gen(12345);
+  ArenaAllocator arena;
+  for (auto _ : state) {
+    arena.reset();
+    benchmark::DoNotOptimize(findRoadsPattern([&arena]<typename T>() { return ArenaVector<T>(&arena); }, state.range(0), gen));
+  }
+  state.counters["peakMB"] = arena.getPeakMemory() / 1048576.;
+  state.counters["capacityMB"] = arena.getCapacity() / 1048576.;
+  state.counters["blocks"] = arena.getNBlockAllocations();
+}
+
+BENCHMARK(BM_FindRoadsDefault)->Arg(200)->Arg(2000)->Arg(20000)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_FindRoadsArena)->Arg(200)->Arg(2000)->Arg(20000)->Unit(benchmark::kMillisecond);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,148 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+/// \file testTrackerSliceMemory.cxx
+/// \brief Check that releasing the tracking artefacts after each ROF slice does not change the tracks
+
+#define BOOST_TEST_MODULE ITS Tracker slice memory
+#define BOOST_TEST_MAIN
+#define BOOST_TEST_DYN_LINK
+#include <boost/test/unit_test.hpp>
+
+#include "ITStracking/Configuration.h"
+#include "ITStracking/TimeFrame.h"
+#include "ITStracking/Tracker.h"
+#include "ITStracking/TrackerTraits.h"
+#include "ReconstructionDataFormats/Track.h"
+#include "DetectorsBase/Propagator.h"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <vector>
+
+namespace o2::its
+{
+
+namespace
+{
+constexpr float Bz = 5.f;
+constexpr int NROFs = 12;
+constexpr int NROFsPerSlice = 5; // the last slice is shorter than the others
+constexpr int NLongTracksPerROF = 10;
+constexpr int NShortTracksPerROF = 3; // only crossing the three innermost layers
+
+using TrackClusters = std::array<int, 8>; // ROF and cluster index on each layer
+
+void initPropagator()
+{
+  auto prop = o2::base::Propagator::Instance(true); // no field map or material needed for the Bz-only transport
+  prop->setNominalBz(Bz);
+}
+
+/// Fill @a tf with tracks from one vertex per ROF, crossing the layers at the
+/// nominal radii without any smearing.
+void fillTimeFrame(TimeFrame& tf, const TrackingParameters& params)
+{
+  int nClusters{0};
+  for (int rof{0}; rof < NROFs; ++rof) {
+    const float zVtx = -6.f + rof;
+    for (int iTrack{0}; iTrack < NLongTracksPerROF + NShortTracksPerROF; ++iTrack) {
+      const bool isShort = iTrack >= NLongTracksPerROF;
+      const float phi = 2.f * float(M_PI) * (iTrack + 0.5f * rof / NROFs) / (NLongTracksPerROF + NShortTracksPerROF);
+      const float tgl = -0.6f + 1.2f * iTrack / (NLongTracksPerROF + NShortTracksPerROF);
+      const float q2pt = (iTrack % 2 ? 1.f : -1.f) / (1.f + 0.2f * iTrack);
+      o2::track::TrackPar track{0.f, phi, {0.f, zVtx, 0.f, tgl, q2pt}};
+      for (int iLayer{0}; iLayer < (isShort ? 3 : params.NLayers); ++iLayer) {
+        float x{0.f};
+        bool ok{track.getXatLabR(params.LayerRadii[iLayer], x, Bz, o2::track::DirOutward)};
+        BOOST_REQUIRE(ok);
+        auto xyz = track.getXYZGloAt(x, Bz, ok);
+        BOOST_REQUIRE(ok);
+        const float alpha = std::atan2(xyz.y(), xyz.x());
+        const float sigma2 = params.LayerResolution[iLayer] * params.LayerResolution[iLayer];
+        tf.addTrackingFrameInfoToLayer(iLayer, xyz.x(), xyz.y(), xyz.z(), std::hypot(xyz.x(), xyz.y()), alpha,
+                                       std::array<float, 2>{0.f, xyz.z()}, std::array<float, 3>{sigma2, 0.f, sigma2});
+        tf.addClusterToLayer(iLayer, xyz.x(), xyz.y(), xyz.z(), tf.getUnsortedClusters()[iLayer].size());
+        tf.addClusterExternalIndexToLayer(iLayer, nClusters++);
+      }
+    }
+    for (int iLayer{0}; iLayer < params.NLayers; ++iLayer) {
+      tf.mNClustersPerROF[iLayer].push_back(tf.getUnsortedClusters()[iLayer].size() - tf.mROFramesClusters[iLayer].back());
+      tf.mROFramesClusters[iLayer].push_back(tf.getUnsortedClusters()[iLayer].size());
+    }
+    tf.mNrof++;
+  }
+
+  tf.setMultiplicityCutMask(std::vector<uint8_t>(NROFs, 1));
+  tf.getTotVertIteration().resize(1);
+  for (int rof{0}; rof < NROFs; ++rof) {
+    Vertex vertex{{0.f, 0.f, -6.f + rof}, {1.e-6f, 0.f, 1.e-6f, 0.f, 0.f, 1.e-6f}, NLongTracksPerROF + NShortTracksPerROF, 0.f};
+    vertex.setTimeStamp(o2::dataformats::TimeStamp<int>{rof});
+    tf.addPrimaryVertices(std::vector<Vertex>{vertex}, rof, 0);
+  }
+}
+
+std::vector<TrackClusters> runTracking(bool releaseSliceMemory)
+{
+  initPropagator();
+  TrackingParameters params;
+  params.nROFsPerIterations = NROFsPerSlice;
+  params.ReleaseSliceMemory = releaseSliceMemory;
+  params.FindShortTracks = true;
+  params.FataliseUponFailure = false;
+
+  TimeFrame tf;
+  tf.setBz(Bz);
+  fillTimeFrame(tf, params);
+  TrackerTraits traits;
+  Tracker tracker{&traits};
+  tracker.adoptTimeFrame(tf);
+  tracker.setParameters({params});
+  tracker.setBz(Bz);
+  tracker.clustersToTracks([](const std::string&) {}, [](const std::string& err) { BOOST_FAIL(err); });
+
+  std::vector<TrackClusters> tracks;
+  for (int rof{0}; rof < NROFs; ++rof) {
+    for (auto& track : tf.getTracks(rof)) {
+      TrackClusters clusters{rof};
+      for (int iLayer{0}; iLayer < params.NLayers; ++iLayer) {
+        clusters[iLayer + 1] = track.getClusterIndex(iLayer);
+      }
+      tracks.push_back(clusters);
+    }
+  }
+  std::sort(tracks.begin(), tracks.end());
+  return tracks;
+}
+
+int countShortTracks(const std::vector<TrackClusters>& tracks, int firstROF)
+{
+  return std::count_if(tracks.begin(), tracks.end(), [firstROF](const TrackClusters& t) {
+    return t[0] >= firstROF && t[4] == constants::its::UnusedIndex;
+  });
+}
+} // namespace
+
+BOOST_AUTO_TEST_CASE(TrackerReleaseSliceMemory)
+{
+  auto reference = runTracking(false);
+  auto released = runTracking(true);
+
+  BOOST_CHECK(!reference.empty());
+  // short tracks are found on the cells of the last slice
+  BOOST_CHECK(countShortTracks(reference, NROFsPerSlice * (NROFs / NROFsPerSlice)) > 0);
+  BOOST_CHECK_EQUAL(countShortTracks(released, 0), countShortTracks(reference, 0));
+  BOOST_CHECK_EQUAL(released.size(), reference.size());
+  BOOST_CHECK(released == reference);
+}
+
+} // namespace o2::its
@@ -129,6 +129,12 @@ class Clusterer
     int column2[SegmentationAlpide::NRows + 2];
     int* curr = nullptr; // pointer on the 1st row of currently processed columnsX
     int* prev = nullptr; // pointer on the 1st row of previously processed columnsX
+    // bitmaps of the rows filled in column1 and column2, used to reset only the touched entries of the column buffers
+    static constexpr int NColumnWords = SegmentationAlpide::NRows / 64;
+    uint64_t rowsUsed1[NColumnWords] = {};
+    uint64_t rowsUsed2[NColumnWords] = {};
+    uint64_t* currRowsUsed = nullptr; // bitmap of filled rows of the curr column buffer
+    uint64_t* prevRowsUsed = nullptr; // bitmap of filled rows of the prev column buffer
     // pixels[].first is the index of the next pixel of the same precluster in the pixels
     // pixels[].second is the index of the referred pixel in the ChipPixelData (element of mChips)
     std::vector<std::pair<int, uint32_t>> pixels;
@@ -145,11 +151,32 @@ class Clusterer
     MCTruth labels;
     std::vector<ThreadStat> stats; // statistics for each thread results, used at merging
     ///
-    ///< reset column buffer, for the performance reasons we use memset
-    void resetColumn(int* buff) { std::memset(buff, -1, sizeof(int) * SegmentationAlpide::NRows); }
+    ///< reset current column buffer, only the rows flagged in its bitmap were filled
+    void resetColumn()
+    {
+      for (int iw = 0; iw < NColumnWords; iw++) {
+        auto word = currRowsUsed[iw];
+        while (word) {
+          curr[(iw << 6) + __builtin_ctzll(word)] = -1;
+          word &= word - 1;
+        }
+        currRowsUsed[iw] = 0;
+      }
+    }
+
+    ///< assign precluster index to the row of the current column
+    void setCurrRow(uint16_t row, int preClusIndex)
+    {
+      curr[row] = preClusIndex;
+      currRowsUsed[row >> 6] |= uint64_t(1) << (row & 63);
+    }
 
     ///< swap current and previous column buffers
-    void swapColumnBuffers() { std::swap(prev, curr); }
+    void swapColumnBuffers()
+    {
+      std::swap(prev, curr);
+      std::swap(prevRowsUsed, currRowsUsed);
+    }
 
     ///< add cluster at row (entry ip in the ChipPixeData) to the precluster with given index
     void expandPreCluster(uint32_t ip, uint16_t row, int preClusIndex)
@@ -157,7 +184,7 @@ class Clusterer
       auto& firstIndex = preClusterHeads[preClusterIndices[preClusIndex]];
       pixels.emplace_back(firstIndex, ip);
       firstIndex = pixels.size() - 1;
-      curr[row] = preClusIndex;
+      setCurrRow(row, preClusIndex);
     }
 
     ///< add new precluster at given row of current column for the fired pixel with index ip in the ChipPixelData
@@ -168,7 +195,7 @@ class Clusterer
       pixels.emplace_back(-1, ip);
       int lastIndex = preClusterIndices.size();
       preClusterIndices.push_back(lastIndex);
-      curr[row] = lastIndex; // store index of the new precluster in the current column buffer
+      setCurrRow(row, lastIndex); // store index of the new precluster in the current column buffer
     }
 
     void fetchMCLabels(int digID, const ConstMCTruth* labelsDig, int& nfilled);
@@ -181,7 +208,7 @@ class Clusterer
     void process(uint16_t chip, uint16_t nChips, CompClusCont* compClusPtr, PatternCont* patternsPtr,
                  const ConstMCTruth* labelsDigPtr, MCTruth* labelsClPtr, const ROFRecord& rofPtr);
 
-    ClustererThread(Clusterer* par = nullptr, int _id = -1) : parent(par), id(_id), curr(column2 + 1), prev(column1 + 1)
+    ClustererThread(Clusterer* par = nullptr, int _id = -1) : parent(par), id(_id), curr(column2 + 1), prev(column1 + 1), currRowsUsed(rowsUsed2), prevRowsUsed(rowsUsed1)
     {
       std::fill(std::begin(column1), std::end(column1), -1);
       std::fill(std::begin(column2), std::end(column2), -1);
@@ -23,6 +23,8 @@
 #ifndef ALICEO2_ITSMFT_LOOKUP_H
 #define ALICEO2_ITSMFT_LOOKUP_H
 #include <array>
+#include <utility>
+#include <vector>
 #include "DataFormatsITSMFT/ClusterTopology.h"
 #include "DataFormatsITSMFT/TopologyDictionary.h"
 
@@ -46,8 +48,13 @@ class LookUp
   auto getDictionaty() const { return mDictionary; }
 
  private:
+  void buildHashTable();
+
   TopologyDictionary mDictionary;
   int mTopologiesOverThreshold;
+  /// open-addressing copy of mDictionary.mCommonMap (pairs of <hash, ID>, ID<0 for empty slots) for faster lookup
+  std::vector<std::pair<unsigned long, int>> mHashTable; //!
+  unsigned long mHashTableMask = 0;                     //!
 
   ClassDefNV(LookUp, 3);
 };
@@ -343,14 +343,16 @@ void Clusterer::ClustererThread::initChip(const ChipPixelData* curChipData, uint
   // init chip with the 1st unmasked pixel (entry "from" in the mChipData)
   prev = column1 + 1;
   curr = column2 + 1;
-  resetColumn(curr);
+  prevRowsUsed = rowsUsed1;
+  currRowsUsed = rowsUsed2;
+  resetColumn();
 
   pixels.clear();
   preClusterHeads.clear();
   preClusterIndices.clear();
   auto pix = curChipData->getData()[first];
   currCol = pix.getCol();
-  curr[pix.getRowDirect()] = 0; // can use getRowDirect since the pixel is not masked
+  setCurrRow(pix.getRowDirect(), 0); // can use getRowDirect since the pixel is not masked
   // start the first pre-cluster
   preClusterHeads.push_back(0);
   preClusterIndices.push_back(0);
@@ -365,7 +367,7 @@ void Clusterer::ClustererThread::updateChip(const ChipPixelData* curChipData, ui
   uint16_t row = pix.getRowDirect(); // can use getRowDirect since the pixel is not masked
   if (currCol != pix.getCol()) {     // switch the buffers
     swapColumnBuffers();
-    resetColumn(curr);
+    resetColumn();
     noLeftCol = false;
     if (pix.getCol() > currCol + 1) {
       // no connection with previous column, this pixel cannot belong to any of the
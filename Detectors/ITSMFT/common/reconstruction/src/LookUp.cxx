@@ -37,6 +37,7 @@ void LookUp::loadDictionary(std::string fileName)
 {
   mDictionary.readFromFile(fileName);
   mTopologiesOverThreshold = mDictionary.mCommonMap.size();
+  buildHashTable();
 }
 
 void LookUp::setDictionary(const TopologyDictionary* dict)
@@ -45,6 +46,26 @@ void LookUp::setDictionary(const TopologyDictionary* dict)
     mDictionary = *dict;
   }
   mTopologiesOverThreshold = mDictionary.mCommonMap.size();
+  buildHashTable();
+}
+
+void LookUp::buildHashTable()
+{
+  // the upper 32 bits of the complete hash come from the MurMur2 hash of the pattern and are used as slot index,
+  // the table is kept at most half full so that the linear probing sequence stays short
+  size_t capacity = 16;
+  while (capacity < 2 * mDictionary.mCommonMap.size()) {
+    capacity <<= 1;
+  }
+  mHashTableMask = capacity - 1;
+  mHashTable.assign(capacity, {0ul, -1});
+  for (const auto& [hash, id] : mDictionary.mCommonMap) {
+    auto slot = (hash >> 32) & mHashTableMask;
+    while (mHashTable[slot].second >= 0) {
+      slot = (slot + 1) & mHashTableMask;
+    }
+    mHashTable[slot] = {hash, id};
+  }
 }
 
 int LookUp::groupFinder(int nRow, int nCol)
@@ -76,9 +97,19 @@ int LookUp::findGroupID(int nRow, int nCol, const unsigned char patt[ClusterPatt
     }
   } else { // Big unique topology
     unsigned long hash = ClusterTopology::getCompleteHash(nRow, nCol, patt);
-    auto ret = mDictionary.mCommonMap.find(hash);
-    if (ret != mDictionary.mCommonMap.end()) {
-      return ret->second;
+    if (!mHashTable.empty()) {
+      auto slot = (hash >> 32) & mHashTableMask;
+      while (mHashTable[slot].second >= 0) {
+        if (mHashTable[slot].first == hash) {
+          return mHashTable[slot].second;
+        }
+        slot = (slot + 1) & mHashTableMask;
+      }
+    } else { // table not built, e.g. for the LookUp read from file
+      auto ret = mDictionary.mCommonMap.find(hash);
+      if (ret != mDictionary.mCommonMap.end()) {
+        return ret->second;
+      }
     }
   }
   if (!mDictionary.mGroupMap.empty()) { // rare valid topology group
@@ -30,6 +30,7 @@
 #include "CommonUtils/IRFrameSelector.h"
 #include "CCDB/BasicCCDBManager.h"
 #include <cassert>
+#include <optional>
 
 using namespace o2::framework;
 using namespace o2::itsmft;
@@ -129,7 +130,12 @@ void DigitReader::run(ProcessingContext& pc)
     std::vector<o2::itsmft::GBTCalibData> calibSel;
     std::vector<o2::itsmft::ROFRecord> digROFRecSel;
     std::vector<o2::itsmft::MC2ROFRecord> digMC2ROFsSel;
-    o2::dataformats::MCTruthContainer<o2::MCCompLabel> digitLabelsSel;
+    // the labels of the selected digits are written directly to the output buffer
+    using LabelBufferType = std::decay_t<decltype(pc.outputs().make<o2::dataformats::ConstMCTruthContainer<o2::MCCompLabel>>(Output{"", "", 0}))>;
+    std::optional<o2::dataformats::ConstMCTruthContainerBuilder<o2::MCCompLabel, LabelBufferType>> digitLabelsSel;
+    if (mUseMC) {
+      digitLabelsSel.emplace(pc.outputs().make<o2::dataformats::ConstMCTruthContainer<o2::MCCompLabel>>(Output{mOrigin, "DIGITSMCTR", 0}));
+    }
 
     if (irFrames.size()) { // we assume the IRFrames are in the increasing order
       if (ent < 0) {
@@ -169,8 +175,10 @@ void DigitReader::run(ProcessingContext& pc)
               int offs = digitsSel.size();
               digROFRecSel.back().setFirstEntry(offs);
               std::copy(mDigits.begin() + rof.getFirstEntry(), mDigits.begin() + rof.getFirstEntry() + rof.getNEntries(), std::back_inserter(digitsSel));
-              for (int id = 0; id < rof.getNEntries(); id++) { // copy MC info
-                digitLabelsSel.addElements(id + offs, mConstLabels.getLabels(id + rof.getFirstEntry()));
+              if (digitLabelsSel) {
+                for (int id = 0; id < rof.getNEntries(); id++) { // copy MC info
+                  digitLabelsSel->addElements(id + offs, mConstLabels.getLabels(id + rof.getFirstEntry()));
+                }
               }
               if (mCalib.size() >= size_t((irof + 1) * mNRUs)) {
                 std::copy(mCalib.begin() + irof * mNRUs, mCalib.begin() + (irof + 1) * mNRUs, std::back_inserter(calibSel));
@@ -215,8 +223,7 @@ void DigitReader::run(ProcessingContext& pc)
       pc.outputs().snapshot(Output{mOrigin, "PHYSTRIG", 0}, dummyTrig);
     }
     if (mUseMC) {
-      auto& sharedlabels = pc.outputs().make<o2::dataformats::ConstMCTruthContainer<o2::MCCompLabel>>(Output{mOrigin, "DIGITSMCTR", 0});
-      digitLabelsSel.flatten_to(sharedlabels);
+      digitLabelsSel->finalize();
       pc.outputs().snapshot(Output{mOrigin, "DIGITSMC2ROF", 0}, digMC2ROFsSel);
     }
 
@@ -239,15 +239,20 @@ void TFReaderSpec::run(o2f::ProcessingContext& ctx)
 
   while (1) {
     if (mTFQueue.size()) {
-      static o2f::RateLimiter limiter;
-      limiter.check(ctx, mInput.tfRateLimit, mInput.minSHM);
-
       auto tfPtr = std::move(mTFQueue.front());
       mTFQueue.pop();
       if (!tfPtr) {
         LOG(error) << "Builder provided nullptr TF pointer";
         continue;
       }
+      size_t tfSize = 0;
+      for (auto& msgIt : *tfPtr.get()) {
+        for (auto& part : *msgIt.second.get()) {
+          tfSize += part->GetSize();
+        }
+      }
+      static o2f::RateLimiter limiter;
+      limiter.check(ctx, mInput.tfRateLimit, mInput.minSHM, tfSize);
       setTimingInfo(*tfPtr.get());
       size_t nparts = 0, dataSize = 0;
       if (mInput.sendDummyForMissing) {
@@ -69,6 +69,7 @@ class Compressor
 
   void checkSummary();
   void resetCounters();
+  void mergeCounters(const Compressor& other);
 
   void setDecoderCONET(bool val)
   {
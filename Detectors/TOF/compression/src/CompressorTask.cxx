@@ -22,6 +22,10 @@
 #include "Framework/InputRecordWalker.h"
 #include "CommonUtils/VerbosityConfig.h"
 
+#ifdef WITH_OPENMP
+#include <omp.h>
+#endif
+
 using namespace o2::framework;
 
 namespace o2::tof
@@ -41,14 +45,35 @@ void CompressorTask<RDH, verbose, paranoid>::init(InitContext& ic)
   auto encoderVerbose = ic.options().get<bool>("tof-compressor-encoder-verbose");
   auto checkerVerbose = ic.options().get<bool>("tof-compressor-checker-verbose");
   mOutputBufferSize = ic.options().get<int>("tof-compressor-output-buffer-size");
-
-  mCompressor.setDecoderCONET(decoderCONET);
-  mCompressor.setDecoderVerbose(decoderVerbose);
-  mCompressor.setEncoderVerbose(encoderVerbose);
-  mCompressor.setCheckerVerbose(checkerVerbose);
+  mNThreads = std::max(1, ic.options().get<int>("tof-compressor-nthreads"));
+#ifndef WITH_OPENMP
+  if (mNThreads > 1) {
+    LOG(warning) << "Compressor built without OpenMP support, ignoring request for " << mNThreads << " threads";
+    mNThreads = 1;
+  }
+#endif
+  if (verbose && mNThreads > 1) {
+    LOG(info) << "Verbose compressor runs single-threaded to keep the printout readable";
+    mNThreads = 1;
+  }
+  LOG(info) << "Compressor running with " << mNThreads << " thread(s)";
+
+  mCompressors.clear();
+  for (int ithread = 0; ithread < mNThreads; ++ithread) {
+    auto& compressor = mCompressors.emplace_back(std::make_unique<Compressor<RDH, verbose, paranoid>>());
+    compressor->resetCounters();
+    compressor->setDecoderCONET(decoderCONET);
+    compressor->setDecoderVerbose(decoderVerbose);
+    compressor->setEncoderVerbose(encoderVerbose);
+    compressor->setCheckerVerbose(checkerVerbose);
+  }
 
   auto finishFunction = [this]() {
-    mCompressor.checkSummary();
+    for (int ithread = 1; ithread < mNThreads; ++ithread) {
+      mCompressors[0]->mergeCounters(*mCompressors[ithread]);
+      mCompressors[ithread]->resetCounters();
+    }
+    mCompressors[0]->checkSummary();
   };
 
   ic.services().get<CallbackService>().set<CallbackService::Id::Stop>(finishFunction);
@@ -111,11 +136,22 @@ void CompressorTask<RDH, verbose, paranoid>::run(ProcessingContext& pc)
     //  }
   }
 
-  /** loop over subspecs **/
+  /** prepare one output per subspec, the allocator must only be used from this thread **/
+  struct SubspecJob {
+    Output output;
+    o2::header::DataHeader headerOut;
+    const std::vector<o2::framework::DataRef>* parts;
+    long bufferSize;
+    long bufferSizeDouble;
+  };
+  std::vector<SubspecJob> jobs;
+  std::vector<o2::pmr::vector<char>> buffers;
+  jobs.reserve(subspecPartMap.size());
+  buffers.reserve(subspecPartMap.size());
   for (auto& subspecPartEntry : subspecPartMap) {
 
     auto subspec = subspecPartEntry.first;
-    auto parts = subspecPartEntry.second;
+    auto& parts = subspecPartEntry.second;
     auto& firstPart = parts.at(0);
 
     /** use the first part to define output headers **/
@@ -133,10 +169,27 @@ void CompressorTask<RDH, verbose, paranoid>::run(ProcessingContext& pc)
     // Better way of doing this would be to used an offset, so that we can resize the vector
     // as well. However, this should be good enough because bufferSize overestimates the size
     // of the payload.
-    auto bufferPointer = v.data();
+    buffers.emplace_back(std::move(v));
+    jobs.push_back(SubspecJob{std::move(output), headerOut, &parts, bufferSize, bufferSizeDouble});
+  }
+
+  /** loop over subspecs, each one is an independent CRU link and has its own output buffer **/
+  const int njobs = jobs.size();
+#ifdef WITH_OPENMP
+#pragma omp parallel for schedule(dynamic) num_threads(mNThreads)
+#endif
+  for (int ijob = 0; ijob < njobs; ++ijob) {
+    int ithread = 0;
+#ifdef WITH_OPENMP
+    ithread = omp_get_thread_num();
+#endif
+    auto& compressor = *mCompressors[ithread];
+    auto& job = jobs[ijob];
+    auto bufferPointer = buffers[ijob].data();
+    auto bufferSize = job.bufferSize;
 
     /** loop over subspec parts **/
-    for (const auto& ref : parts) {
+    for (const auto& ref : *job.parts) {
       /** input **/
       auto payloadIn = ref.payload;
       auto payloadInSize = DataRefUtils::getPayloadSize(ref);
@@ -147,25 +200,29 @@ void CompressorTask<RDH, verbose, paranoid>::run(ProcessingContext& pc)
       }
 
       /** prepare compressor **/
-      mCompressor.setDecoderBuffer(payloadIn);
-      mCompressor.setDecoderBufferSize(payloadInSize);
-      mCompressor.setEncoderBuffer(bufferPointer);
-      mCompressor.setEncoderBufferSize(bufferSize);
+      compressor.setDecoderBuffer(payloadIn);
+      compressor.setDecoderBufferSize(payloadInSize);
+      compressor.setEncoderBuffer(bufferPointer);
+      compressor.setEncoderBufferSize(bufferSize);
 
       /** run **/
-      mCompressor.run();
-      auto payloadOutSize = mCompressor.getEncoderByteCounter();
+      compressor.run();
+      auto payloadOutSize = compressor.getEncoderByteCounter();
       bufferPointer += payloadOutSize;
       bufferSize -= payloadOutSize;
-      headerOut.payloadSize += payloadOutSize;
+      job.headerOut.payloadSize += payloadOutSize;
     }
 
-    if (headerOut.payloadSize > bufferSizeDouble) {
-      headerOut.payloadSize = 0; // put payload to zero, otherwise it will trigger a crash
+    if (job.headerOut.payloadSize > job.bufferSizeDouble) {
+      job.headerOut.payloadSize = 0; // put payload to zero, otherwise it will trigger a crash
     }
+  }
 
-    v.resize(headerOut.payloadSize);
-    pc.outputs().adoptContainer(output, std::move(v));
+  /** ship outputs in subspec order **/
+  for (int ijob = 0; ijob < njobs; ++ijob) {
+    auto& v = buffers[ijob];
+    v.resize(jobs[ijob].headerOut.payloadSize);
+    pc.outputs().adoptContainer(jobs[ijob].output, std::move(v));
   }
 }
 
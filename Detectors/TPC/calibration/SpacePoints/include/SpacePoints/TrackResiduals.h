@@ -131,6 +131,11 @@ class TrackResiduals
   // -------------------------------------- settings --------------------------------------------------
   /// Sets a flag to print the memory usage at certain points in the program for performance studies.
   void setPrintMemoryUsage() { mPrintMem = true; }
+
+  /// Sets the number of threads used for the voxel fits and the smoothing within a sector
+  void setNThreads(int n) { mNThreads = n > 0 ? n : 1; }
+  int getNThreads() const { return mNThreads; }
+
   /// Sets the kernel type used for smoothing.
   /// \param kernel Kernel type (Epanechnikov / Gaussian)
   /// \param bwX Bin width in X
@@ -464,6 +469,7 @@ class TrackResiduals
   // status flags
   bool mIsInitialized{}; ///< initialize only once
   bool mPrintMem{};      ///< turn on to print memory usage at certain points
+  int mNThreads{1};      ///<! number of threads used to process the voxels of a sector
   // binning
   int mNXBins{param::NPadRows};                            ///< number of bins in radial direction
   int mNY2XBins{param::NY2XBins};                          ///< number of y/x bins per sector
@@ -492,7 +498,6 @@ class TrackResiduals
   std::array<int, VoxDim> mStepKern{};                             ///< N bins to consider with given kernel settings
   std::array<float, VoxDim> mKernelScaleEdge{};                    ///< optional scaling factors for kernel width on the edge
   std::array<float, VoxDim> mKernelWInv{};                         ///< inverse kernel width in bins
-  std::array<double, ResDim * sMaxSmtDim> mLastSmoothingRes{};     ///< results of last smoothing operation
   // calibrated parameters
   float mEffVdriftCorr{0.f}; ///< global correction factor for vDrift based on d(delta(z))/dz fit
   float mEffT0Corr{0.f};     ///< global correction for T0 shift from offset of d(delta(z))/dz fit
@@ -503,7 +508,7 @@ class TrackResiduals
   VoxRes mVoxelResultsOut{};                                                                ///< the results from mVoxelResults are copied in here to be able to stream them
   VoxRes* mVoxelResultsOutPtr{&mVoxelResultsOut};                                           ///< pointer to set the branch address to for the output
 
-  ClassDefNV(TrackResiduals, 3);
+  ClassDefNV(TrackResiduals, 4);
 };
 
 //_____________________________________________________
@@ -39,6 +39,10 @@
 
 #include <fairlogger/Logger.h>
 
+#ifdef WITH_OPENMP
+#include <omp.h>
+#endif
+
 using namespace o2::tpc;
 
 ///////////////////////////////////////////////////////////////////////////////
@@ -364,11 +368,13 @@ void TrackResiduals::fillStats(int iSec)
 //______________________________________________________________________________
 void TrackResiduals::processSectorResiduals(int iSec)
 {
-  LOGP(info, "Processing {} voxel residuals for sector {}", mLocalResidualsIn.size(), iSec);
+  LOGP(info, "Processing {} voxel residuals for sector {} with {} threads", mLocalResidualsIn.size(), iSec, mNThreads);
+  TStopwatch sw;
   initResultsContainer(iSec);
   // effective t0 correction changes sign between A-/C-side
   float effT0corr = (iSec < SECTORSPERSIDE) ? mEffT0Corr : -1. * mEffT0Corr;
   std::vector<size_t> binData;
+  binData.reserve(mLocalResidualsIn.size());
   for (const auto& res : mLocalResidualsIn) {
     binData.push_back(getGlbVoxBin(res.bvox));
   }
@@ -378,44 +384,44 @@ void TrackResiduals::processSectorResiduals(int iSec)
   // fill the voxel statistics into the results container
   std::vector<VoxRes>& secData = mVoxelResults[iSec];
 
-  // vectors holding the data for one voxel at a time
-  std::vector<float> dyVec;
-  std::vector<float> dzVec;
-  std::vector<float> tgVec;
-  // assuming we will always have around 1000 entries per voxel
-  dyVec.reserve(1e3);
-  dzVec.reserve(1e3);
-  tgVec.reserve(1e3);
-  size_t currVoxBin = -1;
-  unsigned int nPointsInVox = 0;
-  unsigned int nProcessed = 0;
-  while (nProcessed < binData.size()) {
-    // read all points, voxel by voxel
-    int idx = binIndices[nProcessed];
-    if (currVoxBin != binData[idx]) {
-      if (nPointsInVox) {
-        VoxRes& resVox = secData[currVoxBin];
-        processVoxelResiduals(dyVec, dzVec, tgVec, resVox);
-      }
-      currVoxBin = binData[idx];
-      nPointsInVox = 0;
+  // boundaries of the sorted residuals of each voxel, the voxels are processed independently
+  std::vector<size_t> voxFirst;
+  for (size_t i = 0; i < binIndices.size(); ++i) {
+    if (!i || binData[binIndices[i]] != binData[binIndices[i - 1]]) {
+      voxFirst.push_back(i);
+    }
+  }
+  const int nVoxWithData = voxFirst.size();
+  voxFirst.push_back(binIndices.size());
+
+#ifdef WITH_OPENMP
+#pragma omp parallel num_threads(mNThreads)
+#endif
+  {
+    // vectors holding the data for one voxel at a time, assuming we will always have around 1000 entries per voxel
+    std::vector<float> dyVec;
+    std::vector<float> dzVec;
+    std::vector<float> tgVec;
+    dyVec.reserve(1e3);
+    dzVec.reserve(1e3);
+    tgVec.reserve(1e3);
+#ifdef WITH_OPENMP
+#pragma omp for schedule(dynamic)
+#endif
+    for (int iVox = 0; iVox < nVoxWithData; ++iVox) {
+      size_t voxBin = binData[binIndices[voxFirst[iVox]]];
+      VoxRes& resVox = secData[voxBin];
       dyVec.clear();
       dzVec.clear();
       tgVec.clear();
+      for (size_t i = voxFirst[iVox]; i < voxFirst[iVox + 1]; ++i) {
+        const auto& res = mLocalResidualsIn[binIndices[i]];
+        dyVec.push_back(res.dy * param::MaxResid / 0x7fff);
+        dzVec.push_back(res.dz * param::MaxResid / 0x7fff - mEffVdriftCorr * resVox.stat[VoxZ] * resVox.stat[VoxX] - effT0corr);
+        tgVec.push_back(res.tgSlp * param::MaxTgSlp / 0x7fff);
+      }
+      processVoxelResiduals(dyVec, dzVec, tgVec, resVox);
     }
-    dyVec.push_back(mLocalResidualsIn[idx].dy * param::MaxResid / 0x7fff);
-    dzVec.push_back(mLocalResidualsIn[idx].dz * param::MaxResid / 0x7fff -
-                    mEffVdriftCorr * secData[currVoxBin].stat[VoxZ] * secData[currVoxBin].stat[VoxX] -
-                    effT0corr);
-    tgVec.push_back(mLocalResidualsIn[idx].tgSlp * param::MaxTgSlp / 0x7fff);
-
-    ++nPointsInVox;
-    ++nProcessed;
-  }
-  if (nPointsInVox) {
-    // process last voxel
-    VoxRes& resVox = secData[currVoxBin];
-    processVoxelResiduals(dyVec, dzVec, tgVec, resVox);
   }
   LOG(info) << "extracted residuals for sector " << iSec;
 
@@ -429,51 +435,45 @@ void TrackResiduals::processSectorResiduals(int iSec)
   }
 
   // process dispersions
-  dyVec.clear();
-  tgVec.clear();
-  currVoxBin = -1;
-  nProcessed = 0;
-  nPointsInVox = 0;
-  while (nProcessed < binData.size()) {
-    int idx = binIndices[nProcessed];
-    if (currVoxBin != binData[idx]) {
-      if (nPointsInVox) {
-        VoxRes& resVox = secData[currVoxBin];
-        if (!getXBinIgnored(iSec, resVox.bvox[VoxX])) {
-          processVoxelDispersions(tgVec, dyVec, resVox);
-        }
+#ifdef WITH_OPENMP
+#pragma omp parallel num_threads(mNThreads)
+#endif
+  {
+    std::vector<float> dyVec;
+    std::vector<float> tgVec;
+    dyVec.reserve(1e3);
+    tgVec.reserve(1e3);
+#ifdef WITH_OPENMP
+#pragma omp for schedule(dynamic)
+#endif
+    for (int iVox = 0; iVox < nVoxWithData; ++iVox) {
+      VoxRes& resVox = secData[binData[binIndices[voxFirst[iVox]]]];
+      if (getXBinIgnored(iSec, resVox.bvox[VoxX])) {
+        continue;
       }
-      currVoxBin = binData[idx];
-      nPointsInVox = 0;
       dyVec.clear();
       tgVec.clear();
-    }
-    dyVec.push_back(mLocalResidualsIn[idx].dy * param::MaxResid / 0x7fff);
-    tgVec.push_back(mLocalResidualsIn[idx].tgSlp * param::MaxTgSlp / 0x7fff);
-    ++nPointsInVox;
-    ++nProcessed;
-  }
-  if (nPointsInVox) {
-    // process last voxel
-    VoxRes& resVox = secData[currVoxBin];
-    if (!getXBinIgnored(iSec, resVox.bvox[VoxX])) {
+      for (size_t i = voxFirst[iVox]; i < voxFirst[iVox + 1]; ++i) {
+        const auto& res = mLocalResidualsIn[binIndices[i]];
+        dyVec.push_back(res.dy * param::MaxResid / 0x7fff);
+        tgVec.push_back(res.tgSlp * param::MaxTgSlp / 0x7fff);
+      }
       processVoxelDispersions(tgVec, dyVec, resVox);
     }
   }
   // smooth dispersions
-  for (int ix = 0; ix < mNXBins; ++ix) {
-    if (getXBinIgnored(iSec, ix)) {
+#ifdef WITH_OPENMP
+#pragma omp parallel for schedule(dynamic) num_threads(mNThreads)
+#endif
+  for (int voxBin = 0; voxBin < mNVoxPerSector; ++voxBin) {
+    VoxRes& resVox = secData[voxBin];
+    if (getXBinIgnored(iSec, resVox.bvox[VoxX])) {
       continue;
     }
-    for (int iz = 0; iz < mNZ2XBins; ++iz) {
-      for (int ip = 0; ip < mNY2XBins; ++ip) {
-        int voxBin = getGlbVoxBin(ix, ip, iz);
-        VoxRes& resVox = secData[voxBin];
-        getSmoothEstimate(iSec, resVox.stat[VoxX], resVox.stat[VoxF], resVox.stat[VoxZ], resVox.DS, 0x1 << VoxV);
-      }
-    }
+    getSmoothEstimate(iSec, resVox.stat[VoxX], resVox.stat[VoxF], resVox.stat[VoxZ], resVox.DS, 0x1 << VoxV);
   }
-  LOG(info) << "Done processing residuals for sector " << iSec;
+  sw.Stop();
+  LOGP(info, "Done processing residuals for sector {} in {:.2f} s real / {:.2f} s CPU time", iSec, sw.RealTime(), sw.CpuTime());
   dumpResults(iSec);
 }
 
@@ -689,22 +689,31 @@ int TrackResiduals::validateVoxels(int iSec)
 void TrackResiduals::smooth(int iSec)
 {
   std::vector<VoxRes>& secData = mVoxelResults[iSec];
-  for (int ix = 0; ix < mNXBins; ++ix) {
-    if (getXBinIgnored(iSec, ix)) {
+  // the estimates only read the flags of the neighbours, which are updated once all voxels are done
+  std::vector<char> smoothRes(mNVoxPerSector, 0);
+  int nFailed = 0;
+#ifdef WITH_OPENMP
+#pragma omp parallel for schedule(dynamic) num_threads(mNThreads) reduction(+ : nFailed)
+#endif
+  for (int voxBin = 0; voxBin < mNVoxPerSector; ++voxBin) {
+    VoxRes& resVox = secData[voxBin];
+    if (getXBinIgnored(iSec, resVox.bvox[VoxX])) {
       continue;
     }
-    for (int ip = 0; ip < mNY2XBins; ++ip) {
-      for (int iz = 0; iz < mNZ2XBins; ++iz) {
-        int voxBin = getGlbVoxBin(ix, ip, iz);
-        VoxRes& resVox = secData[voxBin];
-        resVox.flags &= ~SmoothDone;
-        bool res = getSmoothEstimate(resVox.bsec, resVox.stat[VoxX], resVox.stat[VoxF], resVox.stat[VoxZ], resVox.DS, (0x1 << VoxX | 0x1 << VoxF | 0x1 << VoxZ));
-        if (!res) {
-          mNSmoothingFailedBins[iSec]++;
-        } else {
-          resVox.flags |= SmoothDone;
-        }
-      }
+    smoothRes[voxBin] = getSmoothEstimate(resVox.bsec, resVox.stat[VoxX], resVox.stat[VoxF], resVox.stat[VoxZ], resVox.DS, (0x1 << VoxX | 0x1 << VoxF | 0x1 << VoxZ));
+    if (!smoothRes[voxBin]) {
+      ++nFailed;
+    }
+  }
+  mNSmoothingFailedBins[iSec] += nFailed;
+  for (int voxBin = 0; voxBin < mNVoxPerSector; ++voxBin) {
+    VoxRes& resVox = secData[voxBin];
+    if (getXBinIgnored(iSec, resVox.bvox[VoxX])) {
+      continue;
+    }
+    resVox.flags &= ~SmoothDone;
+    if (smoothRes[voxBin]) {
+      resVox.flags |= SmoothDone;
     }
   }
   // substract dX contribution to dZ
@@ -760,6 +769,7 @@ bool TrackResiduals::getSmoothEstimate(int iSec, float x, float p, float z, std:
   // cache
   // \todo maybe a 1-D cache would be more efficient?
   std::array<std::array<double, sMaxSmtDim*(sMaxSmtDim + 1) / 2>, ResDim> cmat;
+  std::array<double, ResDim * sMaxSmtDim> rhs;
   int maxNeighb = 10 * 10 * 10;
   std::vector<VoxRes*> currVox;
   currVox.reserve(maxNeighb);
@@ -774,7 +784,7 @@ bool TrackResiduals::getSmoothEstimate(int iSec, float x, float p, float z, std:
   std::array<int, VoxDim> trial{0};
 
   while (true) {
-    std::fill(mLastSmoothingRes.begin(), mLastSmoothingRes.end(), 0);
+    rhs.fill(0);
     memset(&cmat[0][0], 0, sizeof(cmat));
 
     int nbOK = 0; // accounted neighbours
@@ -960,7 +970,7 @@ bool TrackResiduals::getSmoothEstimate(int iSec, float x, float p, float z, std:
           wi /= (voxNb->E[iDim] * voxNb->E[iDim]);
         }
         std::array<double, sMaxSmtDim*(sMaxSmtDim + 1) / 2>& cmatD = cmat[iDim];
-        double* rhsD = &mLastSmoothingRes[iDim * sMaxSmtDim];
+        double* rhsD = &rhs[iDim * sMaxSmtDim];
         unsigned short iMat = 0;
         unsigned short iRhs = 0;
         // linear part
@@ -1026,7 +1036,7 @@ bool TrackResiduals::getSmoothEstimate(int iSec, float x, float p, float z, std:
       }
       matrix.Zero(); // reset matrix
       std::array<double, sMaxSmtDim*(sMaxSmtDim + 1) / 2>& cmatD = cmat[iDim];
-      double* rhsD = &mLastSmoothingRes[iDim * sMaxSmtDim];
+      double* rhsD = &rhs[iDim * sMaxSmtDim];
       short iMat = -1;
       short row = -1;
 
@@ -1240,7 +1250,8 @@ float TrackResiduals::roFunc(int nPoints, int offset, const std::vector<float>&
 {
   // calculate sum(x_i * sgn(y_i - a - b * x_i)) for given b
   // see numberical recipies paragraph 15.7.3
-  std::vector<float> vecTmp(nPoints);
+  thread_local std::vector<float> vecTmp; // called many times per fit, keep the buffer
+  vecTmp.resize(nPoints);
   float sum = 0.f;
   for (int j = nPoints; j-- > 0;) {
     vecTmp[j] = y[j + offset] - b * x[j + offset];
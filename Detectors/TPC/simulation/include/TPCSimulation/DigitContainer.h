@@ -17,6 +17,8 @@
 #define ALICEO2_TPC_DigitContainer_H_
 
 #include <deque>
+#include <vector>
+#include <memory>
 #include <algorithm>
 #include "TPCBase/CRU.h"
 #include "DataFormatsTPC/Defs.h"
@@ -35,7 +37,9 @@ class Digit;
 /// This is the base class of the intermediate Digit Containers, in which all incoming electrons from the hits are
 /// sorted into after amplification
 /// The structure assures proper sorting of the Digits when later on written out for further processing.
-/// This class holds the time bin containers.
+/// This class holds the time bin containers. Each of them is a dense array over all pads of the sector,
+/// and the flushed ones are recycled, so that the time bins form a ring of reusable pad arrays.
+/// The container is filled by a single thread, see Digitizer::process.
 
 class DigitContainer
 {
@@ -44,7 +48,7 @@ class DigitContainer
   DigitContainer();
 
   /// Destructor
-  ~DigitContainer() = default;
+  ~DigitContainer();
 
   /// Reset the container
   void reset();
@@ -78,16 +82,30 @@ class DigitContainer
   /// Get the size of the container for one event
   size_t size() const { return mTimeBins.size(); }
 
+  /// Get the number of time bin containers allocated so far, recycled ones included
+  size_t getNAllocatedTimeBins() const { return mNAllocatedTimeBins; }
+
+  /// Get the memory held by the allocated time bin containers
+  size_t getAllocatedMemory() const { return mNAllocatedTimeBins * sizeof(DigitTime); }
+
  private:
   TimeBin mFirstTimeBin = 0;                                  ///< First time bin to consider
   TimeBin mEffectiveTimeBin = 0;                              ///< Effective time bin of that digit
   TimeBin mTmaxTriggered = 0;                                 ///< Maximum time bin in case of triggered mode (hard cut at average drift speed with additional margin)
   TimeBin mOffset;                                            ///< Size of the container for one event
   std::deque<DigitTime*> mTimeBins;                           ///< Time bin Container for the ADC value
+  std::vector<std::unique_ptr<DigitTime>> mFreeTimeBins;      ///< Flushed time bin containers kept for recycling
+  size_t mNAllocatedTimeBins = 0;                             ///< Number of time bin containers allocated
   std::unique_ptr<DigitTime::PrevDigitInfoArray> mPrevDigArr; ///< Keep track of ToT and ion tail cumul from last time bin
   o2::utils::DebugStreamer mStreamer;                         ///< Debug streamer
 
   void reportSettings();
+
+  /// Get an empty time bin container, recycling a flushed one if available
+  DigitTime* getTimeBin();
+
+  /// Return a flushed time bin container to the pool
+  void releaseTimeBin(DigitTime* time);
 };
 
 inline DigitContainer::DigitContainer()
@@ -102,6 +120,32 @@ inline DigitContainer::DigitContainer()
   mTimeBins.resize(mOffset, nullptr);
 }
 
+inline DigitContainer::~DigitContainer()
+{
+  for (auto time : mTimeBins) {
+    delete time;
+  }
+}
+
+inline DigitTime* DigitContainer::getTimeBin()
+{
+  if (mFreeTimeBins.empty()) {
+    ++mNAllocatedTimeBins;
+    return new DigitTime();
+  }
+  auto time = mFreeTimeBins.back().release();
+  mFreeTimeBins.pop_back();
+  return time;
+}
+
+inline void DigitContainer::releaseTimeBin(DigitTime* time)
+{
+  if (time) {
+    time->clear();
+    mFreeTimeBins.emplace_back(time);
+  }
+}
+
 inline void DigitContainer::reset()
 {
   mFirstTimeBin = 0;
@@ -134,7 +178,7 @@ inline void DigitContainer::addDigit(const MCCompLabel& label, const CRU& cru, T
   }
 
   if (mTimeBins[mEffectiveTimeBin] == nullptr) {
-    mTimeBins[mEffectiveTimeBin] = new DigitTime();
+    mTimeBins[mEffectiveTimeBin] = getTimeBin();
   }
 
   mTimeBins[mEffectiveTimeBin]->addDigit(label, cru, globalPad, signal);
@@ -49,6 +49,10 @@ class DigitTime
   /// Resets the container
   void reset();
 
+  /// Brings the container back to its freshly constructed state, including digit IDs and labels,
+  /// such that it can be recycled for a new time bin
+  void clear();
+
   /// Get common mode for a given GEM stack
   /// \param gemstack GEM stack of the digit
   /// \return Common mode value in that time bin for a given GEM ROC
@@ -118,6 +122,17 @@ inline void DigitTime::reset()
   mCommonMode.fill(0.f);
 }
 
+inline void DigitTime::clear()
+{
+  for (auto& pad : mGlobalPads) {
+    pad.reset();
+    pad.setID(-1);
+  }
+  mCommonMode.fill(0.f);
+  mDigitCounter = 0;
+  mLabels.clear();
+}
+
 inline float DigitTime::getCommonMode(const GEMstack& gemstack) const
 {
   /// simple case when there is no external capacitance on the ROC
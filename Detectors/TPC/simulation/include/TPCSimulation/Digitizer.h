@@ -91,6 +91,9 @@ class Digitizer
     mDigitContainer.reset();
   }
 
+  /// Get the intermediate digit container, e.g. to monitor its memory footprint
+  const DigitContainer& getDigitContainer() const { return mDigitContainer; }
+
   /// Set the start time of the first event
   /// \param time Time of the first event
   void setStartTime(double time);
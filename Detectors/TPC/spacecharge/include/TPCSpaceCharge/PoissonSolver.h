@@ -100,7 +100,7 @@ class PoissonSolver
   const ParamSpaceCharge mParamGrid{mGrid3D.getParamSC()};           ///< parameters of the grid on which the calculations are performed
   inline static DataT sConvergenceError{1e-6};                       ///< Error tolerated
   static constexpr DataT INVTWOPI = 1. / o2::constants::math::TwoPI; ///< inverse of 2*pi
-  inline static int sNThreads{4};                                    ///< number of threads which are used during some of the calculations (increasing this number has no big impact)
+  inline static int sNThreads{4};                                    ///< number of threads which are used during some of the calculations (e.g. the red-black relaxation)
 
   /// \returns inverse grid size in phi (either 1/2Pi or NSECTORSPERSIDE/2Pi)
   static DataT getGridSizePhiInv();
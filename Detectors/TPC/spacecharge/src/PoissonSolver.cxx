@@ -993,9 +993,10 @@ void PoissonSolver<DataT>::residue3D(Vector& residue, const Vector& matricesCurr
 
     for (int j = 1; j < tnZColumn - 1; ++j) {
       for (int i = 1; i < tnRRow - 1; ++i) {
-        residue(i, j, m) = ih2 * (coefficient2[i] * matricesCurrentV(i - 1, j, m) + tempRatioZ * (matricesCurrentV(i, j - 1, m) + matricesCurrentV(i, j + 1, m)) + coefficient1[i] * matricesCurrentV(i + 1, j, m) +
-                                  coefficient3[i] * (signPlus * matricesCurrentV(i, j, mp1) + signMinus * matricesCurrentV(i, j, mm1)) - inverseCoefficient4[i] * matricesCurrentV(i, j, m)) +
-                           matricesCurrentCharge(i, j, m);
+        // the residue is a small difference of large terms: evaluated in double also for float storage
+        const double sum = coefficient2[i] * double(matricesCurrentV(i - 1, j, m)) + tempRatioZ * (double(matricesCurrentV(i, j - 1, m)) + matricesCurrentV(i, j + 1, m)) + coefficient1[i] * double(matricesCurrentV(i + 1, j, m)) +
+                           coefficient3[i] * (signPlus * double(matricesCurrentV(i, j, mp1)) + signMinus * double(matricesCurrentV(i, j, mm1))) - inverseCoefficient4[i] * double(matricesCurrentV(i, j, m));
+        residue(i, j, m) = ih2 * sum + matricesCurrentCharge(i, j, m);
       } // end cols
     }   // end mParamGrid.NRVertices
   }
@@ -1222,50 +1223,59 @@ void PoissonSolver<DataT>::relax3D(Vector& matricesCurrentV, const Vector& matri
 {
   // Gauss-Seidel (Read Black}
   if (MGParameters::relaxType == RelaxType::GaussSeidel) {
-    // for each slice
-    for (int iPass = 1; iPass <= 2; ++iPass) {
-      const int msw = (iPass % 2) ? 1 : 2;
-      for (int m = 0; m < iPhi; ++m) {
-        const int jsw = ((msw + m) % 2) ? 1 : 2;
-        int mp1 = m + 1;
-        int signPlus = 1;
-        int mm1 = m - 1;
-        int signMinus = 1;
-        // Reflection symmetry in phi (e.g. symmetry at sector boundaries, or half sectors, etc.)
-        if (symmetry == 1) {
-          if (mp1 > iPhi - 1) {
-            mp1 = iPhi - 2;
-          }
-          if (mm1 < 0) {
-            mm1 = 1;
-          }
+    // in each pass only the points of one colour are updated, using the points of the other colour only:
+    // the phi slices are independent and are processed in parallel
+    const auto relaxSlice = [&](const int m, const int msw) {
+      const int jsw = ((msw + m) % 2) ? 1 : 2;
+      int mp1 = m + 1;
+      int signPlus = 1;
+      int mm1 = m - 1;
+      int signMinus = 1;
+      // Reflection symmetry in phi (e.g. symmetry at sector boundaries, or half sectors, etc.)
+      if (symmetry == 1) {
+        if (mp1 > iPhi - 1) {
+          mp1 = iPhi - 2;
         }
-        // Anti-symmetry in phi
-        else if (symmetry == -1) {
-          if (mp1 > iPhi - 1) {
-            mp1 = iPhi - 2;
-            signPlus = -1;
-          }
-          if (mm1 < 0) {
-            mm1 = 1;
-            signMinus = -1;
-          }
-        } else { // No Symmetries in phi, no boundaries, the calculation is continuous across all phi
-          if (mp1 > iPhi - 1) {
-            mp1 = m + 1 - iPhi;
-          }
-          if (mm1 < 0) {
-            mm1 = m - 1 + iPhi;
-          }
+        if (mm1 < 0) {
+          mm1 = 1;
+        }
+      }
+      // Anti-symmetry in phi
+      else if (symmetry == -1) {
+        if (mp1 > iPhi - 1) {
+          mp1 = iPhi - 2;
+          signPlus = -1;
+        }
+        if (mm1 < 0) {
+          mm1 = 1;
+          signMinus = -1;
+        }
+      } else { // No Symmetries in phi, no boundaries, the calculation is continuous across all phi
+        if (mp1 > iPhi - 1) {
+          mp1 = m + 1 - iPhi;
+        }
+        if (mm1 < 0) {
+          mm1 = m - 1 + iPhi;
         }
-        int isw = jsw;
-        for (int j = 1; j < tnZColumn - 1; ++j, isw = 3 - isw) {
-          for (int i = isw; i < tnRRow - 1; i += 2) {
-            (matricesCurrentV)(i, j, m) = (coefficient2[i] * (matricesCurrentV)(i - 1, j, m) + tempRatioZ * ((matricesCurrentV)(i, j - 1, m) + (matricesCurrentV)(i, j + 1, m)) + coefficient1[i] * (matricesCurrentV)(i + 1, j, m) + coefficient3[i] * (signPlus * (matricesCurrentV)(i, j, mp1) + signMinus * (matricesCurrentV)(i, j, mm1)) + (h2 * (matricesCurrentCharge)(i, j, m))) * coefficient4[i];
-          } // end cols
-        }   // end mParamGrid.NRVertices
-      }     // end phi
-    }       // end sweep
+      }
+      int isw = jsw;
+      for (int j = 1; j < tnZColumn - 1; ++j, isw = 3 - isw) {
+        for (int i = isw; i < tnRRow - 1; i += 2) {
+          (matricesCurrentV)(i, j, m) = (coefficient2[i] * (matricesCurrentV)(i - 1, j, m) + tempRatioZ * ((matricesCurrentV)(i, j - 1, m) + (matricesCurrentV)(i, j + 1, m)) + coefficient1[i] * (matricesCurrentV)(i + 1, j, m) + coefficient3[i] * (signPlus * (matricesCurrentV)(i, j, mp1) + signMinus * (matricesCurrentV)(i, j, mm1)) + (h2 * (matricesCurrentCharge)(i, j, m))) * coefficient4[i];
+        } // end cols
+      }   // end mParamGrid.NRVertices
+    };
+
+    for (int iPass = 1; iPass <= 2; ++iPass) {
+      const int msw = (iPass % 2) ? 1 : 2;
+      // for an odd number of slices the first and the last slice wrapping around in phi have the same colour:
+      // the first slice is done before the others, as in the sequential order
+      relaxSlice(0, msw);
+#pragma omp parallel for num_threads(sNThreads)
+      for (int m = 1; m < iPhi; ++m) {
+        relaxSlice(m, msw);
+      } // end phi
+    }   // end sweep
   } else if (MGParameters::relaxType == RelaxType::Jacobi) {
     // for each slice
     for (int m = 0; m < iPhi; ++m) {
@@ -1477,7 +1487,7 @@ void PoissonSolver<DataT>::restrict2D(Vector& matricesCurrentCharge, const Vecto
 template <typename DataT>
 DataT PoissonSolver<DataT>::getConvergenceError(const Vector& matricesCurrentV, Vector& prevArrayV) const
 {
-  std::vector<DataT> errorArr(prevArrayV.getNphi());
+  std::vector<double> errorArr(prevArrayV.getNphi()); // accumulated in double also for float storage
 
   // subtract the two matrices
   std::transform(prevArrayV.begin(), prevArrayV.end(), matricesCurrentV.begin(), prevArrayV.begin(), std::minus<DataT>());
@@ -1488,7 +1498,7 @@ DataT PoissonSolver<DataT>::getConvergenceError(const Vector& matricesCurrentV,
     const auto phiStep = prevArrayV.getNr() * prevArrayV.getNz(); // number of points in one phi slice
     const auto start = prevArrayV.begin() + m * phiStep;
     const auto end = start + phiStep;
-    errorArr[m] = std::inner_product(start, end, start, DataT(0)); // inner product "Sum (matrix[a]*matrix[a])"
+    errorArr[m] = std::inner_product(start, end, start, double(0)); // inner product "Sum (matrix[a]*matrix[a])"
   }
   // return largest error
   return *std::max_element(std::begin(errorArr), std::end(errorArr));
@@ -0,0 +1,239 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+/// \file benchmark_SVertexerBulk.cxx
+/// \brief V0 and cascade finding of the SVertexer with per-pair fits vs DCAFitterN bulk processing
+
+#include "benchmark/benchmark.h"
+#include "DCAFitter/DCAFitterN.h"
+#include "DetectorsVertexing/SVertexerParams.h"
+#include "MathUtils/Utils.h"
+#include <algorithm>
+#include <cmath>
+#include <random>
+#include <vector>
+
+#ifdef WITH_OPENMP
+#include <omp.h>
+#endif
+
+using namespace o2::vertexing;
+using TrackParCov = o2::track::TrackParCov;
+
+namespace
+{
+constexpr float Bz = -5.f;
+constexpr int NV0s = 25;           // V0 decays per event, half of them with an extra bachelor (cascades)
+constexpr int NPrimaries = 100;    // primary tracks per event, giving the combinatorial background
+constexpr int NFakeV0s = 2 * NV0s; // background V0 candidates passed to the cascade finding
+
+/// Synthetic event: tracks from the primary vertex and from V0 and cascade decays at a few cm.
+struct Event {
+  std::vector<TrackParCov> tracks[2]; // positive and negative tracks, as the SVertexer pools
+
+  Event()
+  {
+    std::mt19937 gen(12345);
+    for (int i = 0; i < NPrimaries; i++) {
+      addTrack(gen, {0.f, 0.f, 0.f}, i % 2);
+    }
+    for (int i = 0; i < NV0s; i++) {
+      std::uniform_real_distribution<float> rnd(0.f, 1.f);
+      float phi = rnd(gen) * 2.f * M_PI, r = 2.f + 20.f * rnd(gen);
+      std::array<float, 3> vtx{r * std::cos(phi), r * std::sin(phi), 10.f * (rnd(gen) - 0.5f)};
+      addTrack(gen, vtx, 0, phi);
+      addTrack(gen, vtx, 1, phi);
+      if (i % 2) { // cascade bachelor from a vertex closer to the beam
+        std::array<float, 3> vtxC{0.5f * vtx[0], 0.5f * vtx[1], vtx[2]};
+        addTrack(gen, vtxC, i % 4 == 1, phi);
+      }
+    }
+  }
+
+  void addTrack(std::mt19937& gen, const std::array<float, 3>& vtx, int neg, float phiRef = -999.f)
+  {
+    std::uniform_real_distribution<float> rnd(0.f, 1.f);
+    std::normal_distribution<float> gaus(0.f, 1.f);
+    const float errYZ = 1e-2, errSlp = 1e-3, errQPT = 2e-2;
+    float phi = phiRef < -10.f ? rnd(gen) * 2.f * M_PI : phiRef + 0.3f * (rnd(gen) - 0.5f);
+    float pt = 0.2f + 2.f * rnd(gen);
+    float s, c, x;
+    std::array<float, 5> params;
+    o2::math_utils::sincos(phi, s, c);
+    o2::math_utils::rotateZInv(vtx[0], vtx[1], x, params[0], s, c);
+    params[0] += gaus(gen) * errYZ;
+    params[1] = vtx[2] + gaus(gen) * errYZ;
+    params[2] = gaus(gen) * errSlp;
+    params[3] = 0.8f * (rnd(gen) - 0.5f) + gaus(gen) * errSlp;
+    params[4] = (neg ? -1.f : 1.f) / pt;
+    std::array<float, 15> covm = {errYZ * errYZ, 0., errYZ * errYZ, 0, 0., errSlp * errSlp, 0., 0., 0., errSlp * errSlp,
+                                  0., 0., 0., 0., errQPT * errQPT * params[4] * params[4]};
+    tracks[neg].emplace_back(x, phi, params, covm);
+  }
+};
+
+const Event& getEvent()
+{
+  static Event ev;
+  return ev;
+}
+
+/// Fitter configured as in SVertexer::updateTimeDependentParams
+template <int N>
+DCAFitterN<N> makeFitter(float maxR)
+{
+  const auto& par = SVertexerParams::Instance();
+  DCAFitterN<N> fitter;
+  fitter.setBz(Bz);
+  fitter.setUseAbsDCA(par.useAbsDCA);
+  fitter.setPropagateToPCA(false);
+  fitter.setMaxR(maxR);
+  fitter.setMinParamChange(par.minParamChange);
+  fitter.setMinRelChi2Change(par.minRelChi2Change);
+  fitter.setMaxDZIni(par.maxDZIni);
+  fitter.setMaxDXYIni(par.maxDXYIni);
+  fitter.setMaxChi2(par.maxChi2);
+  fitter.setMaxStep(par.maxStep);
+  fitter.setMaxSnp(par.maxSnp);
+  fitter.setMinXSeed(par.minXSeed);
+  return fitter;
+}
+
+/// Flatten the pairs which would be passed to checkV0 (pos x neg) or to checkCascades (V0 x bachelor).
+void makePairs(const std::vector<TrackParCov>& outer, const std::vector<TrackParCov>& inner,
+               std::vector<TrackParCov>& tr0, std::vector<TrackParCov>& tr1)
+{
+  tr0.clear();
+  tr1.clear();
+  for (const auto& to : outer) {
+    for (const auto& ti : inner) {
+      tr0.push_back(to);
+      tr1.push_back(ti);
+    }
+  }
+}
+
+/// V0 candidates for the cascade finding: fits of the pairs made of the last tracks of the pools, mostly from the decays.
+const std::vector<TrackParCov>& getV0s()
+{
+  static std::vector<TrackParCov> v0s = [] {
+    const auto& ev = getEvent();
+    auto fitter = makeFitter<2>(SVertexerParams::Instance().maxRIni);
+    std::vector<TrackParCov> res;
+    size_t nPos = ev.tracks[0].size(), nNeg = ev.tracks[1].size();
+    for (size_t i = 0; i < std::min(nPos, nNeg) && int(res.size()) < NV0s + NFakeV0s; i++) {
+      if (fitter.process(ev.tracks[0][nPos - 1 - i], ev.tracks[1][nNeg - 1 - i]) && fitter.propagateTracksToVertex()) {
+        res.push_back(fitter.createParentTrackParCov());
+      }
+    }
+    return res;
+  }();
+  return v0s;
+}
+
+const std::vector<TrackParCov>& getBachelors()
+{
+  static std::vector<TrackParCov> bachelors = [] {
+    const auto& ev = getEvent();
+    std::vector<TrackParCov> res(ev.tracks[0]);
+    res.insert(res.end(), ev.tracks[1].begin(), ev.tracks[1].end());
+    return res;
+  }();
+  return bachelors;
+}
+
+/// Per-pair fits as done by SVertexer::process: one fitter per thread, threads share the outer loop.
+template <int N>
+int findScalar(std::vector<DCAFitterN<N>>& fitters, const std::vector<TrackParCov>& outer, const std::vector<TrackParCov>& inner)
+{
+  int nThreads = fitters.size(), nOuter = outer.size(), nInner = inner.size(), nGood = 0;
+#ifdef WITH_OPENMP
+  int dynGrp = std::min(4, std::max(1, nThreads / 2));
+#pragma omp parallel for schedule(dynamic, dynGrp) num_threads(nThreads) reduction(+ : nGood)
+#endif
+  for (int io = 0; io < nOuter; io++) {
+#ifdef WITH_OPENMP
+    auto& fitter = fitters[omp_get_thread_num()];
+#else
+    auto& fitter = fitters[0];
+#endif
+    for (int ii = 0; ii < nInner; ii++) {
+      nGood += fitter.process(outer[io], inner[ii]) > 0;
+    }
+  }
+  return nGood;
+}
+
+void BM_V0Scalar(benchmark::State& state)
+{
+  const auto& ev = getEvent();
+  std::vector<DCAFitterN<2>> fitters(state.range(0), makeFitter<2>(SVertexerParams::Instance().maxRIni));
+  int nGood = 0;
+  for (auto _ : state) {
+    nGood = findScalar(fitters, ev.tracks[0], ev.tracks[1]);
+  }
+  state.counters["pairs"] = ev.tracks[0].size() * ev.tracks[1].size();
+  state.counters["fitted"] = nGood;
+}
+
+void BM_V0Bulk(benchmark::State& state)
+{
+  const auto& ev = getEvent();
+  std::vector<TrackParCov> tr0, tr1;
+  std::vector<DCAFitResult> results;
+  auto fitter = makeFitter<2>(SVertexerParams::Instance().maxRIni);
+  int nGood = 0;
+  for (auto _ : state) {
+    makePairs(ev.tracks[0], ev.tracks[1], tr0, tr1);
+    processBulk(state.range(0), fitter, results, tr0, tr1);
+    nGood = std::count_if(results.begin(), results.end(), [](const DCAFitResult& r) { return r.nCand > 0; });
+  }
+  state.counters["pairs"] = ev.tracks[0].size() * ev.tracks[1].size();
+  state.counters["fitted"] = nGood;
+}
+
+void BM_CascadeScalar(benchmark::State& state)
+{
+  const auto& v0s = getV0s();
+  const auto& bachelors = getBachelors();
+  std::vector<DCAFitterN<2>> fitters(state.range(0), makeFitter<2>(SVertexerParams::Instance().maxRIniCasc));
+  int nGood = 0;
+  for (auto _ : state) {
+    nGood = findScalar(fitters, v0s, bachelors);
+  }
+  state.counters["pairs"] = v0s.size() * bachelors.size();
+  state.counters["fitted"] = nGood;
+}
+
+void BM_CascadeBulk(benchmark::State& state)
+{
+  const auto& v0s = getV0s();
+  const auto& bachelors = getBachelors();
+  std::vector<TrackParCov> tr0, tr1;
+  std::vector<DCAFitResult> results;
+  auto fitter = makeFitter<2>(SVertexerParams::Instance().maxRIniCasc);
+  int nGood = 0;
+  for (auto _ : state) {
+    makePairs(v0s, bachelors, tr0, tr1);
+    processBulk(state.range(0), fitter, results, tr0, tr1);
+    nGood = std::count_if(results.begin(), results.end(), [](const DCAFitResult& r) { return r.nCand > 0; });
+  }
+  state.counters["pairs"] = v0s.size() * bachelors.size();
+  state.counters["fitted"] = nGood;
+}
+} // namespace
+
+BENCHMARK(BM_V0Scalar)->Arg(1)->Arg(4)->Unit(benchmark::kMillisecond)->UseRealTime();
+BENCHMARK(BM_V0Bulk)->Arg(1)->Arg(4)->Unit(benchmark::kMillisecond)->UseRealTime();
+BENCHMARK(BM_CascadeScalar)->Arg(1)->Arg(4)->Unit(benchmark::kMillisecond)->UseRealTime();
+BENCHMARK(BM_CascadeBulk)->Arg(1)->Arg(4)->Unit(benchmark::kMillisecond)->UseRealTime();
+
+BENCHMARK_MAIN();
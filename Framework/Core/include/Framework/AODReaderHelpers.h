@@ -14,6 +14,8 @@
 
 #include "Framework/TableBuilder.h"
 #include "Framework/AlgorithmSpec.h"
+#include "Framework/ConcreteDataMatcher.h"
+#include "Framework/ConfigParamSpec.h"
 #include "Framework/Logger.h"
 #include "Framework/RootMessageContext.h"
 #include <uv.h>
@@ -26,6 +28,10 @@ struct AODReaderHelpers {
   static AlgorithmSpec rootFileReaderCallback();
   static AlgorithmSpec aodSpawnerCallback(std::vector<InputSpec>& requested);
   static AlgorithmSpec indexBuilderCallback(std::vector<InputSpec>& requested);
+  /// Whether the spawner (DYN) or the index builder (IDX) can produce the table
+  /// described by @a matcher. If so, @a sources is filled with the "input:"
+  /// metadata of the tables it is made from, as expected on the requesting inputs.
+  static bool derivedTableSources(ConcreteDataMatcher const& matcher, std::vector<ConfigParamSpec>& sources);
 };
 
 } // namespace o2::framework::readers
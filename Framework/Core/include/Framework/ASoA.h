@@ -812,6 +812,48 @@ using is_dynamic_t = std::conditional_t<is_dynamic_column<T>, std::true_type, st
 template <typename T>
 concept is_column = is_persistent_column<T> || is_dynamic_column<T> || is_indexing_column<T> || is_marker_column<T>;
 
+/// Values a dynamic column can be materialized to
+template <typename T>
+concept materializable_value = std::is_arithmetic_v<T>;
+
+template <typename F, typename... B>
+constexpr bool materializable_bindings(framework::pack<B...>)
+{
+  if constexpr (((is_persistent_column<B> && materializable_value<typename B::type>) && ...)) {
+    return std::invocable<F, typename B::type...>;
+  } else {
+    return false;
+  }
+}
+
+/// Dynamic columns which can be computed once per table with soa::Materialize:
+/// they must depend only on plain persistent columns, without free arguments,
+/// and return an arithmetic value.
+template <typename C>
+concept is_materializable_column = is_dynamic_column<C> &&
+                                   materializable_value<typename C::type> &&
+                                   materializable_bindings<decltype(C::callback_holder_t::getLambda())>(typename C::bindings_t{});
+
+/// Whether the values of the dynamic column C are provided by its materialized
+/// column among Cs, see soa::Materialize.
+template <typename C, typename... Cs>
+consteval bool isMaterializedIn(framework::pack<Cs...>)
+{
+  if constexpr (is_dynamic_column<C> && requires { typename C::materialized; }) {
+    return (std::same_as<typename C::materialized, Cs> || ...);
+  } else {
+    return false;
+  }
+}
+
+/// Drop the dynamic columns which were materialized: their materialized column
+/// has the same getter, which reads the stored values.
+template <typename... Cs>
+consteval auto dropMaterializedDynamicColumns(framework::pack<Cs...>)
+{
+  return framework::concatenated_pack_t<framework::pack<>, framework::pack<>, std::conditional_t<isMaterializedIn<Cs>(framework::pack<Cs...>{}), framework::pack<>, framework::pack<Cs>>...>{};
+}
+
 template <typename T>
 using is_indexing_t = std::conditional_t<is_indexing_column<T>, std::true_type, std::false_type>;
 
@@ -1655,7 +1697,7 @@ template <TableRef ref, typename... Ts>
   requires((sizeof...(Ts) > 0) && !(soa::is_column<Ts> || ...) && (ref.origin_hash != "CONC"_h))
 consteval auto getColumns()
 {
-  return framework::concatenated_pack_unique_t<typename Ts::columns_t...>{};
+  return dropMaterializedDynamicColumns(framework::concatenated_pack_unique_t<typename Ts::columns_t...>{});
 }
 
 template <TableRef ref, typename... Ts>
@@ -3029,6 +3071,30 @@ consteval auto getIndexTargets()
                                                                                                                            \
     using bindings_t = typename o2::framework::pack<Bindings...>;                                                          \
     std::tuple<o2::soa::ColumnIterator<typename Bindings::type> const*...> boundIterators;                                 \
+                                                                                                                           \
+    /* Values computed once by soa::Materialize, which replace the dynamic column in its rows */                           \
+    struct materialized : o2::soa::Column<type, materialized> {                                                            \
+      static constexpr const char* mLabel = "fMaterialized" #_Name_;                                                       \
+      using base = o2::soa::Column<type, materialized>;                                                                    \
+      using column_t = materialized;                                                                                       \
+      materialized(arrow::ChunkedArray const* column)                                                                      \
+        : o2::soa::Column<type, materialized>(o2::soa::ColumnIterator<type>(column))                                       \
+      {                                                                                                                    \
+      }                                                                                                                    \
+      materialized() = default;                                                                                            \
+      materialized(materialized const& other) = default;                                                                   \
+      materialized& operator=(materialized const& other) = default;                                                        \
+                                                                                                                           \
+      decltype(auto) get() const                                                                                           \
+      {                                                                                                                    \
+        return *(this->mColumnIterator);                                                                                   \
+      }                                                                                                                    \
+                                                                                                                           \
+      type _Getter_() const                                                                                                \
+      {                                                                                                                    \
+        return *(this->mColumnIterator);                                                                                   \
+      }                                                                                                                    \
+    };                                                                                                                     \
   }
 
 #define DECLARE_SOA_TABLE_METADATA(_Name_, _Desc_, _Version_, ...) \
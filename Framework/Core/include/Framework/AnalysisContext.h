@@ -36,8 +36,10 @@ struct AnalysisContext {
   std::vector<InputSpec> requestedDYNs;
   std::vector<OutputSpec> providedDYNs;
   std::vector<InputSpec> requestedIDXs;
+  std::vector<OutputSpec> providedIDXs;
   std::vector<OutputSpec> providedOutputObjHist;
   std::vector<InputSpec> spawnerInputs;
+  std::vector<InputSpec> builderInputs;
 
   // Needed to created the hist writer
   std::vector<OutputTaskInfo> outTskMap;
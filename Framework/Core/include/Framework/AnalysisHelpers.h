@@ -710,6 +710,31 @@ auto Attach(T const& table)
   using output_t = Join<T, o2::soa::Table<o2::aod::Hash<"JOIN"_h>, o2::aod::Hash<"JOIN/0"_h>, o2::aod::Hash<"JOIN"_h>, Cs...>>;
   return output_t{{table.asArrowTable()}, table.offset()};
 }
+
+/// Template function to compute once the dynamic columns Cs of a table, in a
+/// batch pass over it, rather than at every access (e.g. inside process()).
+/// The values are kept in Arrow columns joined to the table, which replace the
+/// dynamic columns in its rows, so that their getters return the stored values.
+/// Worth it when the columns are used repeatedly, e.g. in combinations.
+template <soa::is_table T, soa::is_materializable_column... Cs>
+auto Materialize(T const& table)
+{
+  using output_t = Join<T, o2::soa::Table<o2::aod::Hash<"JOIN"_h>, o2::aod::Hash<"JOIN/0"_h>, o2::aod::Hash<"JOIN"_h>, typename Cs::materialized...>>;
+  return output_t{{o2::framework::materializer(framework::pack<Cs...>{}, table.asArrowTable(), "dynamicMaterialization"), table.asArrowTable()}, table.offset()};
+}
+
+/// Expression node for the values of the dynamic column C materialized with
+/// soa::Materialize. The columns exist only in the table returned by it, so
+/// this can not be used in the Filters of a task, which are applied to the
+/// inputs before process(): the selection has to be built explicitly, e.g.
+/// with expressions::createSelection(materialized.asArrowTable(), filter).
+template <soa::is_materializable_column C>
+auto materialized()
+{
+  return framework::expressions::BindingNode{C::materialized::mLabel,
+                                             framework::TypeIdHelpers::uniqueId<typename C::materialized>(),
+                                             framework::expressions::selectArrowType<typename C::type>()};
+}
 }  // namespace o2::soa
 
 #endif  // o2_framework_AnalysisHelpers_H_DEFINED
@@ -339,6 +339,15 @@ static inline auto extractOriginals(ProcessingContext& pc)
   }(std::make_index_sequence<refs.size()>());
 }
 
+/// A derived table declared by several tasks is produced only once, by the spawner,
+/// the index builder or the first declaring task, and the others receive it as
+/// input (see WorkflowHelpers::shareDerivedTables).
+template <typename T>
+static inline bool isReceived(ProcessingContext& pc, T& what)
+{
+  return pc.inputs().getPos(what.spec().binding.value) >= 0;
+}
+
 template <is_spawnable T>
 struct OutputManager<Spawns<T>> {
   static bool appendOutput(std::vector<OutputSpec>& outputs, Spawns<T>& what, uint32_t)
@@ -356,13 +365,20 @@ struct OutputManager<Spawns<T>> {
       originalTable = makeEmptyTable<base_table_t>(o2::aod::label<metadata::extension_table_t::ref>());
     }
 
-    what.extension = std::make_shared<typename Spawns<T>::extension_t>(o2::framework::spawner<o2::aod::Hash<metadata::extension_table_t::ref.desc_hash>>(originalTable, o2::aod::label<metadata::extension_table_t::ref>()));
+    if (isReceived(pc, what)) {
+      what.extension = std::make_shared<typename Spawns<T>::extension_t>(pc.inputs().get<TableConsumer>(o2::aod::label<metadata::extension_table_t::ref>())->asArrowTable());
+    } else {
+      what.extension = std::make_shared<typename Spawns<T>::extension_t>(o2::framework::spawner<o2::aod::Hash<metadata::extension_table_t::ref.desc_hash>>(originalTable, o2::aod::label<metadata::extension_table_t::ref>()));
+    }
     what.table = std::make_shared<typename T::table_t>(soa::ArrowHelpers::joinTables({what.extension->asArrowTable(), originalTable}));
     return true;
   }
 
   static bool finalize(ProcessingContext& pc, Spawns<T>& what)
   {
+    if (isReceived(pc, what)) {
+      return true;
+    }
     pc.outputs().adopt(what.output(), what.asArrowTable());
     return true;
   }
@@ -400,12 +416,19 @@ struct OutputManager<Builds<T>> {
 
   static bool prepare(ProcessingContext& pc, Builds<T>& what)
   {
+    if (isReceived(pc, what)) {
+      what.table = std::make_shared<T>(pc.inputs().get<TableConsumer>(o2::aod::label<T::ref>())->asArrowTable());
+      return true;
+    }
     using metadata = o2::aod::MetadataTrait<o2::aod::Hash<T::ref.desc_hash>>::metadata;
     return what.template build<typename T::indexing_t>(what.pack(), extractOriginals<metadata::sources.size(), metadata::sources>(pc));
   }
 
   static bool finalize(ProcessingContext& pc, Builds<T>& what)
   {
+    if (isReceived(pc, what)) {
+      return true;
+    }
     pc.outputs().adopt(what.output(), what.asArrowTable());
     return true;
   }
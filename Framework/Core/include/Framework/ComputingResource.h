@@ -12,6 +12,7 @@
 #define O2_FRAMEWORK_COMPUTINGRESOURCE_H_
 
 #include <string>
+#include <vector>
 
 namespace o2::framework
 {
@@ -24,6 +25,13 @@ struct ComputingOffer {
   unsigned short rangeSize = 0;
 };
 
+/// How the driver places the devices it spawns on the cores of the local host.
+enum struct DevicePlacementPolicy : int {
+  None,  ///< left to the scheduler of the OS
+  Numa,  ///< each device bound to the cores and memory of one NUMA node
+  Cores, ///< in addition, the cores of each node are split between its devices
+};
+
 /// A computing resource which can be offered to run a device
 struct ComputingResource {
   ComputingResource() = default;
@@ -42,6 +50,10 @@ struct ComputingResource {
   unsigned short startPort = 0;
   unsigned short lastPort = 0;
   unsigned short usedPorts = 0;
+  /// NUMA node the device is bound to, -1 if not bound
+  int numaNode = -1;
+  /// Cores the device and all its threads are bound to, empty if not bound
+  std::vector<int> cpus;
 };
 
 } // namespace o2::framework
@@ -23,6 +23,7 @@
 #include "Framework/TypeTraits.h"
 #include "Framework/Traits.h"
 #include "Framework/SerializationMethods.h"
+#include "Framework/FlatSerialization.h"
 #include "Framework/ServiceRegistry.h"
 #include "Framework/RuntimeError.h"
 #include "Framework/RouteState.h"
@@ -313,6 +314,7 @@ class DataAllocator
   /// - std::vector of messageable types
   /// - std::vector of pointers of messageable type
   /// - types with ROOT dictionary and implementing the ROOT ClassDef interface
+  /// - types wrapped in @a FlatSerialized, see FlatSerialization.h
   ///
   /// Note: for many use cases, especially for the messageable types, the `make` interface
   /// might be better suited as the objects are allocated directly in the underlying
@@ -384,6 +386,13 @@ class DataAllocator
         target += elementSizeInBytes;
       }
       serializationType = o2::header::gSerializationMethodNone;
+    } else if constexpr (is_specialization_v<T, FlatSerialized> == true) {
+      // Serialize a snapshot of an object made of plain structures, strings and vectors
+      // in a single buffer, without going through the ROOT streamers
+      auto const& wrapped = object();
+      payloadMessage = proxy.createOutputMessage(routeIndex, FlatSerialization::size(wrapped));
+      FlatSerialization::serialize(static_cast<char*>(payloadMessage->GetData()), payloadMessage->GetSize(), wrapped);
+      serializationType = o2::header::gSerializationMethodFlat;
     } else if constexpr (has_root_dictionary<T>::value == true || is_specialization_v<T, ROOTSerialized> == true) {
       // Serialize a snapshot of an object with root dictionary
       payloadMessage = proxy.createOutputMessage(routeIndex);
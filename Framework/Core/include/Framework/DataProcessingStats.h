@@ -65,6 +65,20 @@ enum struct ProcessingStatsId : short {
   RESOURCES_MISSING,
   RESOURCES_INSUFFICIENT,
   RESOURCES_SATISFACTORY,
+  OUTPUT_BUFFER_POOL_HITS,
+  OUTPUT_BUFFER_POOL_MISSES,
+  OUTPUT_BUFFER_POOL_FALLBACKS,
+  OUTPUT_BUFFER_POOL_HIT_RATE,
+  OUTPUT_BUFFER_POOL_IN_USE,
+  OUTPUT_BUFFER_POOL_IDLE,
+  OUTPUT_BUFFER_POOL_FRAGMENTATION,
+  CALIB_FINALIZED_SLOTS,
+  CALIB_SLOT_FILL_TIME_MS,
+  CALIB_SLOT_FINALIZE_TIME_MS,
+  CALIB_SLOT_MAX_FINALIZE_TIME_MS,
+  CALIB_PENDING_FINALIZATIONS,
+  NUMA_NODE,
+  BOUND_CPUS,
   AVAILABLE_MANAGED_SHM_BASE = 512,
 };
 
@@ -46,6 +46,26 @@ struct DeviceMetricsHelper {
   /// Helper function to parse a metric string.
   static bool parseMetric(std::string_view const s, ParsedMetricMatch& results);
 
+  /// First byte of a binary encoded metric. Text metrics start with '['.
+  static constexpr char BINARY_METRIC_MARKER = '\x01';
+
+  /// Encode a single valued metric in the binary format used between the
+  /// devices and the driver:
+  ///
+  /// <marker><type><name size><name><timestamp><value>
+  ///
+  /// where type and name size are one byte, the timestamp and the numeric values
+  /// are in native byte order and string values take the rest of the message.
+  /// @return the size of the encoded metric, 0 if it does not fit in @a size bytes.
+  static size_t encodeBinaryMetric(char* buffer, size_t size, std::string_view name, int value, size_t timestamp);
+  static size_t encodeBinaryMetric(char* buffer, size_t size, std::string_view name, float value, size_t timestamp);
+  static size_t encodeBinaryMetric(char* buffer, size_t size, std::string_view name, uint64_t value, size_t timestamp);
+  static size_t encodeBinaryMetric(char* buffer, size_t size, std::string_view name, std::string_view value, size_t timestamp);
+
+  /// Parse a metric encoded with encodeBinaryMetric. The resulting match
+  /// points into @a s, like for the text ones.
+  static bool parseBinaryMetric(std::string_view const s, ParsedMetricMatch& results);
+
   /// Processes a parsed metric and stores in the backend store.
   ///
   /// @matches is the regexp_matches from the metric identifying regex
@@ -58,6 +78,16 @@ struct DeviceMetricsHelper {
   static size_t metricIdxByName(std::string_view const name,
                                 const DeviceMetricsInfo& info);
 
+  /// Accumulate @a value in the downsampled history of the metric at @a metricIndex.
+  /// Samples older than the last bucket are accounted in the last bucket.
+  static void updateHistory(DeviceMetricsInfo& info, size_t metricIndex, float value, size_t timestamp);
+
+  /// Append to @a buckets the history of the metric at @a metricIndex for
+  /// the given @a resolution, from the oldest to the newest bucket.
+  /// @return the number of buckets appended.
+  static size_t getHistory(DeviceMetricsInfo const& info, size_t metricIndex,
+                           MetricResolution resolution, std::vector<MetricBucket>& buckets);
+
   template <std::same_as<int> T>
   static auto& getMetricsStore(DeviceMetricsInfo& metrics)
   {
@@ -145,6 +175,7 @@ struct DeviceMetricsHelper {
     return [metricIndex](DeviceMetricsInfo& metrics, T value, size_t timestamp) {
       MetricInfo& metric = metrics.metrics[metricIndex];
       updateNumericInfo(metrics, metricIndex, (float)value, timestamp);
+      updateHistory(metrics, metricIndex, (float)value, timestamp);
 
       auto& store = getMetricsStore<T>(metrics);
       auto& timestamps = getTimestampsStore<T>(metrics);
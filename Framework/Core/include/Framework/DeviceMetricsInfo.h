@@ -143,6 +143,38 @@ using MetricsStorage = std::array<T, metricStorageSize<T>()>;
 template <typename T>
 using TimestampsStorage = std::array<size_t, metricStorageSize<T>()>;
 
+/// Resolutions at which the numeric metrics are downsampled, on top
+/// of the raw values kept in the circular buffers.
+enum struct MetricResolution : int {
+  Second = 0,
+  Minute = 1,
+};
+
+/// Aggregated values of a metric over one bucket of time.
+struct MetricBucket {
+  uint32_t index = 0; // Beginning of the bucket, in units of its width since the epoch
+  uint32_t count = 0;
+  float min = 0;
+  float max = 0;
+  float sum = 0;
+
+  [[nodiscard]] float average() const { return count ? sum / count : 0.f; }
+};
+
+/// Downsampled history of a numeric metric. Each resolution is a circular
+/// buffer of buckets which grows up to its capacity as the buckets are filled,
+/// so that metrics which are rarely updated stay cheap.
+struct MetricHistory {
+  static constexpr int RESOLUTIONS = 2;
+  // Width of the buckets in ms
+  static constexpr std::array<size_t, RESOLUTIONS> BUCKET_WIDTH = {1000, 60000};
+  // 10 minutes at 1 s, 6 hours at 1 min.
+  static constexpr std::array<size_t, RESOLUTIONS> CAPACITY = {600, 360};
+  std::array<std::vector<MetricBucket>, RESOLUTIONS> buckets;
+  // Number of buckets ever opened, the last one is at (pos - 1) % CAPACITY
+  std::array<size_t, RESOLUTIONS> pos = {0, 0};
+};
+
 /// This struct hold information about device metrics when running
 /// in standalone mode. It's position in the holding vector is
 /// the same as the DeviceSpec in its own vector.
@@ -170,6 +202,8 @@ struct DeviceMetricsInfo {
   std::vector<MetricPrefixIndex> metricLabelsPrefixesSortedIdx;
   std::vector<MetricInfo> metrics;
   std::vector<bool> changed;
+  // Downsampled history, indexed like metrics. Only filled for numeric metrics.
+  std::vector<MetricHistory> history;
 };
 
 struct DeviceMetricsInfoHelpers {
@@ -215,6 +249,7 @@ struct DeviceMetricsInfoHelpers {
       info.metricLabelsPrefixesSortedIdx.clear();
       info.metrics.clear();
       info.changed.clear();
+      info.history.clear();
     }
   }
   static size_t metricsStorageSize(gsl::span<DeviceMetricsInfo const> infos)
@@ -243,6 +278,12 @@ struct DeviceMetricsInfoHelpers {
       totalSize += info.metricLabelsPrefixesSortedIdx.size() * sizeof(MetricPrefixIndex);
       totalSize += info.metrics.size() * sizeof(MetricInfo);
       totalSize += info.changed.size() * sizeof(bool);
+      for (auto& history : info.history) {
+        totalSize += sizeof(MetricHistory);
+        for (auto& buckets : history.buckets) {
+          totalSize += buckets.capacity() * sizeof(MetricBucket);
+        }
+      }
     }
 
     return totalSize;
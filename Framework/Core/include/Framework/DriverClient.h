@@ -43,6 +43,10 @@ class DriverClient
     tell(msg.data(), msg.size(), flush);
   };
 
+  /// Whether the metrics can be sent in the binary format of
+  /// DeviceMetricsHelper::encodeBinaryMetric, rather than as text.
+  [[nodiscard]] virtual bool acceptsBinaryMetrics() const { return false; }
+
   /// Request action on some @a eventType notified by the driver
   void observe(char const* eventType, std::function<void(std::string_view)> callback);
 
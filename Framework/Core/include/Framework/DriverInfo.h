@@ -23,6 +23,7 @@
 #include "Framework/ProcessingPolicies.h"
 #include "Framework/CallbacksPolicy.h"
 #include "Framework/CompletionPolicy.h"
+#include "Framework/ComputingResource.h"
 #include "Framework/DispatchPolicy.h"
 #include "Framework/DeviceMetricsInfo.h"
 #include "Framework/LogParsingHelpers.h"
@@ -151,6 +152,8 @@ struct DriverInfo {
   unsigned short resourcesMonitoringInterval = 0;
   /// Metrics gathering dump to disk interval
   unsigned short resourcesMonitoringDumpInterval = 0;
+  /// How to bind the spawned devices to the cores of the host
+  DevicePlacementPolicy devicePlacement = DevicePlacementPolicy::None;
   /// Port used by the websocket control. 0 means not initialised.
   unsigned short port = 0;
   /// The minimum level after which the device will exit with 1
@@ -19,6 +19,7 @@
 #include "Framework/OutputRoute.h"
 #include "Framework/InputRoute.h"
 #include "Framework/ForwardRoute.h"
+#include "Framework/MessageBufferPool.h"
 #include <fairmq/FwdDecls.h>
 #include <vector>
 
@@ -78,6 +79,14 @@ class FairMQDeviceProxy
   [[nodiscard]] std::unique_ptr<fair::mq::Message> createOutputMessage(RouteIndex routeIndex) const;
   [[nodiscard]] std::unique_ptr<fair::mq::Message> createOutputMessage(RouteIndex routeIndex, const size_t size) const;
 
+  /// Serve the sized output messages from a MessageBufferPool of @a bytesPerTransport bytes,
+  /// shared by all the routes using the same transport and placed on @a numaNode if not
+  /// negative. Takes effect at the next bind.
+  void setOutputBufferPool(size_t bytesPerTransport, int numaNode = -1);
+  /// Sum of the statistics of the output buffer pools of all the transports.
+  /// Returns false if the output buffer pools are not enabled.
+  bool getOutputBufferPoolStats(MessageBufferPool::Stats& stats) const;
+
   [[nodiscard]] std::unique_ptr<fair::mq::Message> createInputMessage(RouteIndex routeIndex) const;
   [[nodiscard]] std::unique_ptr<fair::mq::Message> createInputMessage(RouteIndex routeIndex, const size_t size) const;
 
@@ -95,6 +104,10 @@ class FairMQDeviceProxy
   std::vector<RouteState> mOutputRoutes;
   std::vector<OutputChannelInfo> mOutputChannelInfos;
   std::vector<OutputChannelState> mOutputChannelStates;
+  size_t mOutputBufferPoolSize = 0;
+  int mOutputBufferPoolNumaNode = -1;
+  std::vector<std::unique_ptr<MessageBufferPool>> mOutputBufferPools;
+  std::vector<size_t> mOutputRouteBufferPools; // index of the pool of each output route
 
   std::vector<InputRoute> mInputs;
   std::vector<RouteState> mInputRoutes;
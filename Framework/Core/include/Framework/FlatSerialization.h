@@ -0,0 +1,337 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+#ifndef O2_FRAMEWORK_FLATSERIALIZATION_H_
+#define O2_FRAMEWORK_FLATSERIALIZATION_H_
+
+/// @file FlatSerialization.h
+/// @brief ROOT-free serialization of plain aggregates, vectors and spans in a single flat buffer
+
+#include "Framework/TypeTraits.h"
+#include "Framework/StructToTuple.h"
+#include "Framework/RuntimeError.h"
+
+#include <gsl/span>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace o2::framework
+{
+
+/// Header at the beginning of each flat serialized payload.
+struct FlatSerializationHeader {
+  static constexpr uint32_t Magic = 0x54414c46; // "FLAT"
+  static constexpr uint32_t CurrentFormatVersion = 1;
+  uint32_t magic = Magic;
+  uint32_t formatVersion = CurrentFormatVersion;
+  /// Taken from T::FlatSchemaVersion, or from the one of the elements for vectors and spans,
+  /// when defined, 0 otherwise. It needs to be increased whenever the members of T, or of
+  /// the types it contains, change.
+  uint32_t schemaVersion = 0;
+  /// Size of the serialized type, or of its elements for vectors and spans, as an additional
+  /// consistency check of the schema.
+  uint32_t typeSize = 0;
+};
+
+/// Serialization of types which are recursively composed of:
+/// - messageable types (trivially copyable, non-polymorphic), copied as they are
+/// - std::string
+/// - std::vector and gsl::span of any of the supported types
+/// - aggregates (no base class, no user constructors) of any of the supported types
+///
+/// The payload is the FlatSerializationHeader followed by the members in declaration order,
+/// each aligned to its natural alignment (up to 8 bytes) with respect to the start of the
+/// buffer. Vectors and strings are written as their 64 bit size followed by the elements.
+/// Vectors of messageable types are therefore stored contiguously and can be read in place
+/// with readSpan or, when they are the top level object, with span().
+struct FlatSerialization {
+  static constexpr size_t MaxAlignment = 8;
+
+  template <typename T>
+  static constexpr size_t alignment()
+  {
+    return alignof(T) < MaxAlignment ? alignof(T) : MaxAlignment;
+  }
+
+  static constexpr size_t align(size_t offset, size_t alignment)
+  {
+    return (offset + alignment - 1) & ~(alignment - 1);
+  }
+
+  /// gsl::span of any element type, including const ones
+  template <typename T>
+  static constexpr bool isSpan()
+  {
+    if constexpr (requires { typename T::element_type; }) {
+      return std::is_same_v<T, gsl::span<typename T::element_type>>;
+    } else {
+      return false;
+    }
+  }
+
+  /// Whether T can be flat serialized, checking recursively the members of aggregates.
+  /// Self-referencing aggregates are not supported.
+  template <typename T>
+  static constexpr bool isSupported()
+  {
+    if constexpr (is_messageable<T>::value || std::is_same_v<T, std::string>) {
+      return true;
+    } else if constexpr (is_specialization_v<T, std::vector> || isSpan<T>()) {
+      return !std::is_same_v<T, std::vector<bool>> && isSupported<std::remove_const_t<typename T::value_type>>();
+    } else if constexpr (std::is_aggregate_v<T> && std::is_class_v<T>) {
+      return membersSupported<T>(std::make_index_sequence<brace_constructible_size<T>()>{});
+    } else {
+      return false;
+    }
+  }
+
+  /// Converts only to the supported types. An aggregate can be brace initialized with one
+  /// of these per member only if all its members are supported. The deleted conversion
+  /// stops the brace elision, which would otherwise initialize the first member of an
+  /// unsupported aggregate member instead.
+  struct SupportedMember {
+    template <typename M>
+      requires(isSupported<M>())
+    operator M() const;
+    template <typename M>
+      requires(!isSupported<M>())
+    operator M() const = delete;
+  };
+
+  template <typename T, size_t... Is>
+  static constexpr bool membersSupported(std::index_sequence<Is...>)
+  {
+    return requires { T{(void(Is), SupportedMember{})...}; };
+  }
+
+  /// Schema version of T or, for vectors and spans, of their elements
+  template <typename T>
+  static constexpr uint32_t schemaVersion()
+  {
+    if constexpr (is_specialization_v<T, std::vector> || isSpan<T>()) {
+      return schemaVersion<std::remove_const_t<typename T::value_type>>();
+    } else if constexpr (requires { T::FlatSchemaVersion; }) {
+      return T::FlatSchemaVersion;
+    } else {
+      return 0;
+    }
+  }
+
+  template <typename T>
+  static constexpr uint32_t typeSize()
+  {
+    if constexpr (is_specialization_v<T, std::vector> || isSpan<T>()) {
+      return sizeof(typename T::value_type);
+    } else {
+      return sizeof(T);
+    }
+  }
+
+  /// Computes the size of the buffer, without writing it.
+  struct Sizer {
+    size_t offset = 0;
+    void write(void const*, size_t size, size_t alignment)
+    {
+      offset = align(offset, alignment) + size;
+    }
+  };
+
+  struct Writer {
+    char* buffer = nullptr;
+    size_t size = 0;
+    size_t offset = 0;
+    void write(void const* data, size_t bytes, size_t alignment)
+    {
+      auto start = align(offset, alignment);
+      if (start + bytes > size) {
+        throw runtime_error_f("Flat serialization buffer too small: %zu bytes, at least %zu needed", size, start + bytes);
+      }
+      memset(buffer + offset, 0, start - offset);
+      if (bytes) {
+        memcpy(buffer + start, data, bytes);
+      }
+      offset = start + bytes;
+    }
+  };
+
+  struct Reader {
+    char const* buffer = nullptr;
+    size_t size = 0;
+    size_t offset = 0;
+
+    /// Pointer to the next @a bytes bytes, which are then skipped
+    char const* next(size_t bytes, size_t alignment)
+    {
+      auto start = align(offset, alignment);
+      if (start + bytes > size) {
+        throw runtime_error_f("Flat serialized payload truncated: %zu bytes, at least %zu expected", size, start + bytes);
+      }
+      offset = start + bytes;
+      return buffer + start;
+    }
+
+    template <typename T>
+    void read(T& object)
+    {
+      FlatSerialization::read(*this, object);
+    }
+
+    /// Read a vector or a span of messageable types in place.
+    template <typename T>
+      requires is_messageable<T>::value
+    gsl::span<T const> readSpan()
+    {
+      uint64_t count;
+      memcpy(&count, next(sizeof(count), alignment<uint64_t>()), sizeof(count));
+      auto* data = next(count * sizeof(T), alignment<T>());
+      if (reinterpret_cast<uintptr_t>(data) % alignof(T)) {
+        throw runtime_error_f("Flat serialized array at offset %zu is not aligned for in place access", data - buffer);
+      }
+      return {reinterpret_cast<T const*>(data), count};
+    }
+  };
+
+  template <typename S, typename T>
+  static void write(S& sink, T const& object)
+  {
+    if constexpr (is_messageable<T>::value) {
+      sink.write(&object, sizeof(T), alignment<T>());
+    } else if constexpr (std::is_same_v<T, std::string> || is_specialization_v<T, std::vector> || isSpan<T>()) {
+      using ValueType = std::remove_const_t<typename T::value_type>;
+      static_assert(!std::is_same_v<T, std::vector<bool>>, "std::vector<bool> is not supported by the flat serialization");
+      uint64_t count = object.size();
+      sink.write(&count, sizeof(count), alignment<uint64_t>());
+      if constexpr (is_messageable<ValueType>::value) {
+        sink.write(object.data(), count * sizeof(ValueType), alignment<ValueType>());
+      } else {
+        for (auto const& element : object) {
+          write(sink, element);
+        }
+      }
+    } else if constexpr (std::is_aggregate_v<T> && std::is_class_v<T>) {
+      homogeneous_apply_refs([&sink](auto const& member) {
+        write(sink, member);
+        return true;
+      },
+                             object);
+    } else {
+      static_assert(always_static_assert_v<T>, "type not supported by the flat serialization, supported types:"
+                                               "\n - messageable types (trivially copyable, non-polymorphic structures)"
+                                               "\n - std::string, std::vector and gsl::span of supported types"
+                                               "\n - aggregates of supported types");
+    }
+  }
+
+  template <typename T>
+  static void read(Reader& reader, T& object)
+  {
+    if constexpr (is_messageable<T>::value) {
+      memcpy(&object, reader.next(sizeof(T), alignment<T>()), sizeof(T));
+    } else if constexpr (std::is_same_v<T, std::string> || is_specialization_v<T, std::vector>) {
+      using ValueType = typename T::value_type;
+      uint64_t count;
+      memcpy(&count, reader.next(sizeof(count), alignment<uint64_t>()), sizeof(count));
+      if constexpr (is_messageable<ValueType>::value) {
+        auto* data = reader.next(count * sizeof(ValueType), alignment<ValueType>());
+        object.resize(count);
+        if (count) {
+          memcpy(object.data(), data, count * sizeof(ValueType));
+        }
+      } else {
+        object.resize(count);
+        for (auto& element : object) {
+          read(reader, element);
+        }
+      }
+    } else if constexpr (std::is_aggregate_v<T> && std::is_class_v<T>) {
+      homogeneous_apply_refs([&reader](auto& member) {
+        read(reader, member);
+        return true;
+      },
+                             object);
+    } else {
+      static_assert(always_static_assert_v<T>, "type not supported by the flat deserialization, gsl::span members can not be deserialized");
+    }
+  }
+
+  /// Size of the buffer needed to serialize @a object
+  template <typename T>
+  static size_t size(T const& object)
+  {
+    Sizer sizer{sizeof(FlatSerializationHeader)};
+    write(sizer, object);
+    return sizer.offset;
+  }
+
+  /// Serialize @a object to @a buffer, which needs to be at least size(object) bytes
+  template <typename T>
+  static size_t serialize(char* buffer, size_t bufferSize, T const& object)
+  {
+    FlatSerializationHeader header;
+    header.schemaVersion = schemaVersion<T>();
+    header.typeSize = typeSize<T>();
+    Writer writer{buffer, bufferSize};
+    writer.write(&header, sizeof(header), alignment<FlatSerializationHeader>());
+    write(writer, object);
+    return writer.offset;
+  }
+
+  /// Check the header of a flat serialized buffer and return a reader positioned
+  /// at the beginning of the serialized @a T
+  template <typename T>
+  static Reader reader(char const* buffer, size_t size)
+  {
+    FlatSerializationHeader header;
+    if (size < sizeof(header)) {
+      throw runtime_error_f("Flat serialized payload too small: %zu bytes", size);
+    }
+    memcpy(&header, buffer, sizeof(header));
+    if (header.magic != FlatSerializationHeader::Magic || header.formatVersion != FlatSerializationHeader::CurrentFormatVersion) {
+      throw runtime_error_f("Payload is not flat serialized or has unsupported format version %u", header.formatVersion);
+    }
+    if (header.schemaVersion != schemaVersion<T>() || header.typeSize != typeSize<T>()) {
+      throw runtime_error_f("Flat serialized payload with schema version %u and type size %u, expected %u and %u",
+                            header.schemaVersion, header.typeSize, schemaVersion<T>(), typeSize<T>());
+    }
+    return Reader{buffer, size, sizeof(header)};
+  }
+
+  template <typename T>
+  static void deserialize(char const* buffer, size_t size, T& object)
+  {
+    auto in = reader<T>(buffer, size);
+    read(in, object);
+  }
+
+  template <typename T>
+  static std::unique_ptr<T> deserialize(char const* buffer, size_t size)
+  {
+    auto object = std::make_unique<T>();
+    deserialize(buffer, size, *object);
+    return object;
+  }
+
+  /// In place access to a serialized vector or span of messageable types
+  template <typename T>
+  static gsl::span<T const> span(char const* buffer, size_t size)
+  {
+    return reader<gsl::span<T const>>(buffer, size).template readSpan<T>();
+  }
+};
+
+} // namespace o2::framework
+
+#endif // O2_FRAMEWORK_FLATSERIALIZATION_H_
@@ -13,6 +13,7 @@
 
 #include "Framework/DataRef.h"
 #include "Framework/DataRefUtils.h"
+#include "Framework/FlatSerialization.h"
 #include "Framework/InputRoute.h"
 #include "Framework/TypeTraits.h"
 #include "Framework/TableConsumer.h"
@@ -63,10 +64,11 @@ class CallbackService;
 ///       this is meant for C-style strings which are 0 terminated, there is no length
 ///       information
 /// - (d) @ref TableConsumer
-/// - (f) span over messageable type T
+/// - (f) span over messageable type T, also in place for flat serialized vectors
 /// - (g) std::vector of messageable type or type with ROOT dictionary
 /// - (h) messageable type T
 /// - (i) pointer type T* for types with ROOT dictionary or messageable types
+/// Objects sent wrapped in @ref FlatSerialized are retrieved with (g) and (i) as well.
 ///
 /// \par The return type of get<T>(binding) is:
 /// - (a) @ref DataRef object
@@ -286,6 +288,10 @@ class InputRecord
       static_assert(is_messageable<typename T::value_type>::value, "span can only be created for messageable types");
       auto header = DataRefUtils::getHeader<header::DataHeader*>(ref);
       assert(header);
+      if (header->payloadSerializationMethod == o2::header::gSerializationMethodFlat) {
+        // the elements of a flat serialized vector or span are accessed in place
+        return FlatSerialization::span<typename T::value_type>(reinterpret_cast<char const*>(ref.payload), DataRefUtils::getPayloadSize(ref));
+      }
       if (sizeof(typename T::value_type) > 1 && header->payloadSerializationMethod != o2::header::gSerializationMethodNone) {
         throw runtime_error("Inconsistent serialization method for extracting span");
       }
@@ -332,6 +338,15 @@ class InputRecord
           } else {
             throw runtime_error("No supported conversion function for ROOT serialized message");
           }
+        } else if (method == o2::header::gSerializationMethodFlat) {
+          using NonConstT = typename std::remove_const<T>::type;
+          if constexpr (FlatSerialization::isSupported<NonConstT>()) {
+            NonConstT container;
+            FlatSerialization::deserialize(reinterpret_cast<char const*>(ref.payload), payloadSize, container);
+            return container;
+          } else {
+            throw runtime_error("No supported conversion function for flat serialized message");
+          }
         } else {
           throw runtime_error("Attempt to extract object from message with unsupported serialization type");
         }
@@ -360,7 +375,8 @@ class InputRecord
                          (is_messageable<PointerLessValueT>::value ||
                           has_root_dictionary<PointerLessValueT>::value ||
                           (is_specialization_v<PointerLessValueT, std::vector> && has_messageable_value_type<PointerLessValueT>::value) ||
-                          (has_root_dictionary_mapped_type<PointerLessValueT>::value))) {
+                          (has_root_dictionary_mapped_type<PointerLessValueT>::value) ||
+                          FlatSerialization::isSupported<std::remove_const_t<PointerLessValueT>>())) {
       // extract a messageable type or object with ROOT dictionary by pointer
       // return unique_ptr to message content with custom deleter
       using ValueT = PointerLessValueT;
@@ -436,6 +452,14 @@ class InputRecord
         LOGP(info, "Replacing cached entry {} with {} for {} ({})", oldId.value, id.value, path, obj);
         oldId.value = id.value;
         return result;
+      } else if (method == o2::header::gSerializationMethodFlat) {
+        // the flat serialized object is copied, use a span for in place access to vectors
+        if constexpr (FlatSerialization::isSupported<std::remove_const_t<ValueT>>()) {
+          std::unique_ptr<ValueT const, Deleter<ValueT const>> result(FlatSerialization::deserialize<std::remove_const_t<ValueT>>(reinterpret_cast<char const*>(ref.payload), payloadSize).release());
+          return result;
+        } else {
+          throw runtime_error("No supported conversion function for flat serialized message");
+        }
       } else {
         throw runtime_error("Attempt to extract object from message with unsupported serialization type");
       }
@@ -462,6 +486,13 @@ class InputRecord
         // return type with owning Deleter instance, forwarding to default_deleter
         std::unique_ptr<T const, Deleter<T const>> result(DataRefUtils::as<ROOTSerialized<T>>(ref).release());
         return result;
+      } else if (method == o2::header::gSerializationMethodFlat) {
+        if constexpr (FlatSerialization::isSupported<T>()) {
+          std::unique_ptr<T const, Deleter<T const>> result(FlatSerialization::deserialize<T>(reinterpret_cast<char const*>(ref.payload), DataRefUtils::getPayloadSize(ref)).release());
+          return result;
+        } else {
+          throw runtime_error("No supported conversion function for flat serialized message");
+        }
       } else {
         throw runtime_error("Attempt to extract object from message with unsupported serialization type");
       }
@@ -0,0 +1,92 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+#ifndef O2_FRAMEWORK_MESSAGEBUFFERPOOL_H_
+#define O2_FRAMEWORK_MESSAGEBUFFERPOOL_H_
+
+#include <fairmq/FwdDecls.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace o2::framework
+{
+
+/// Pool of payload buffers for the output messages of one transport.
+///
+/// The buffers are carved out of an unmanaged region of the transport, created
+/// on the first allocation. When the consumers release a message, the region
+/// callback puts its buffer back in a free list for its size class, so that
+/// outputs of recurring sizes reuse the same buffers instead of going through
+/// the allocate / free of the shared memory segment every timeframe. A request
+/// takes the smallest idle buffer which is large enough. When none is idle and
+/// the region has no free space left for a new buffer, the idle buffers are
+/// given back to the region and merged with their free neighbours, also while
+/// other buffers are in flight. Requests below the minimum size, or which do
+/// not fit anymore in the region, are served by the transport as usual.
+class MessageBufferPool
+{
+ public:
+  struct Stats {
+    uint64_t hits = 0;      /// allocations served by a released buffer
+    uint64_t misses = 0;    /// allocations which needed a new buffer from the region
+    uint64_t fallbacks = 0; /// allocations which did not fit in the region
+    size_t capacity = 0;    /// size of the region
+    size_t carved = 0;      /// bytes of the region assigned to buffers
+    size_t inUse = 0;       /// bytes of buffers currently held by messages
+    size_t idle = 0;        /// bytes of released buffers waiting in the free lists
+  };
+
+  /// @a numaNode < 0 leaves the placement of the region to the kernel
+  MessageBufferPool(fair::mq::TransportFactory* transport, size_t capacity, int numaNode = -1);
+  ~MessageBufferPool();
+  MessageBufferPool(MessageBufferPool const&) = delete;
+
+  /// Message of @a size bytes, aligned to 64 bytes
+  std::unique_ptr<fair::mq::Message> createMessage(size_t size);
+
+  /// Size of the buffers used for messages of @a size bytes. Classes are spaced by
+  /// one eighth of the power of two below the size, to bound the internal waste.
+  static size_t sizeClass(size_t size);
+
+  [[nodiscard]] Stats stats() const;
+  [[nodiscard]] fair::mq::TransportFactory* transport() const { return mTransport; }
+
+  /// Below this size the messages are taken directly from the transport
+  static constexpr size_t MinPooledSize = 4096;
+
+ private:
+  void release(char* buffer, size_t sizeClass);
+  /// Create the region, returns false if this is not possible with the current transport
+  bool createRegion();
+  /// Offset of a new buffer of @a size bytes in the free space of the region, or -1
+  int64_t carve(size_t size);
+  /// Give the buffer back to the free space of the region, merging it with its neighbours
+  void uncarve(size_t offset, size_t size);
+
+  fair::mq::TransportFactory* mTransport = nullptr;
+  size_t mCapacity = 0;
+  int mNumaNode = -1;
+  bool mRegionFailed = false;
+  std::unique_ptr<fair::mq::UnmanagedRegion> mRegion;
+  char* mRegionData = nullptr; /// start of the region, also valid while it is being destroyed
+  mutable std::mutex mMutex;
+  std::map<size_t, std::vector<size_t>> mFreeBuffers; /// offsets of the idle buffers, by size class
+  std::map<size_t, size_t> mFreeSpace;                /// size of the free ranges of the region, by offset
+  Stats mStats;
+};
+
+} // namespace o2::framework
+
+#endif // O2_FRAMEWORK_MESSAGEBUFFERPOOL_H_
@@ -13,6 +13,7 @@
 #define O2_FRAMERWORK_CORE_RATELIMITER_H
 
 #include "Framework/ProcessingContext.h"
+#include "Framework/TimeframeCostModel.h"
 #include <cstddef>
 #include <cstdint>
 #include <chrono>
@@ -23,7 +24,13 @@ namespace o2::framework
 class RateLimiter
 {
  public:
-  int check(ProcessingContext& ctx, int maxInFlight, size_t minSHM);
+  /// Wait until a new timeframe can be injected, i.e. until there are less than
+  /// @a maxInFlight timeframes being processed and more than @a minSHM bytes of
+  /// shared memory free. With DPL_ADAPTIVE_RATE_LIMITING=1, the memory which the
+  /// timeframe is expected to take is added to @a minSHM and the injection is
+  /// paced at the rate the chain drains, according to a TimeframeCostModel.
+  /// @a timeframeSize is the size of the timeframe about to be injected, 0 if unknown.
+  int check(ProcessingContext& ctx, int maxInFlight, size_t minSHM, size_t timeframeSize = 0);
 
  private:
   int64_t mConsumedTimeframes = 0;
@@ -33,6 +40,9 @@ class RateLimiter
   std::chrono::time_point<std::chrono::system_clock> mLastTime, mFirstTime;
   int64_t mTimeCountingSince = 0;
   float mSmothDelay = 0.f;
+
+  TimeframeCostModel mCostModel;
+  uint64_t mLastInjection = 0;
 };
 } // namespace o2::framework
 
@@ -90,5 +90,34 @@ class CCDBSerialized
   hint_type* mHint; // optional hint e.g. class info or class name
 };
 
+/// @class FlatSerialized
+/// Enforce the ROOT-free flat serialization for a type, see FlatSerialization.h
+/// for the supported types.
+///
+/// Usage: (with 'output' being the DataAllocator of the ProcessingContext)
+///   output.snapshot(Output{}, FlatSerialized<decltype(object)>(object));
+///
+/// On the consumer side the object is retrieved as for the ROOT serialized
+/// objects, i.e. by pointer or by value for std::vector. A vector of messageable
+/// types can also be accessed in place with gsl::span.
+template <typename T>
+class FlatSerialized
+{
+ public:
+  using non_messageable = o2::framework::MarkAsNonMessageable;
+  using wrapped_type = T;
+
+  static_assert(std::is_pointer<T>::value == false, "wrapped type can not be a pointer");
+
+  FlatSerialized() = delete;
+  FlatSerialized(wrapped_type& ref) : mRef(ref) {}
+
+  T& operator()() { return mRef; }
+  T const& operator()() const { return mRef; }
+
+ private:
+  wrapped_type& mRef;
+};
+
 } // namespace o2::framework
 #endif // O2_FRAMEWORK_SERIALIZATIONMETHODS_H_
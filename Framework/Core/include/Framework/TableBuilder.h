@@ -26,6 +26,7 @@
 #include <arrow/stl.h>
 #include <arrow/type_traits.h>
 #include <arrow/table.h>
+#include <arrow/record_batch.h>
 #include <arrow/builder.h>
 
 #include <vector>
@@ -921,6 +922,75 @@ auto spawner(framework::pack<C...> columns, std::vector<std::shared_ptr<arrow::T
   return spawnerHelper(fullTable, new_schema, sizeof...(C), projectors.data(), fields, name);
 }
 
+template <soa::is_persistent_column B>
+auto materializerBinding(arrow::RecordBatch const& batch, const char* name)
+{
+  auto array = batch.GetColumnByName(B::columnLabel());
+  if (array == nullptr) {
+    throw runtime_error_f("Cannot find column %s needed to materialize %s", B::columnLabel(), name);
+  }
+  return std::static_pointer_cast<soa::arrow_array_for_t<typename B::type>>(array);
+}
+
+/// Evaluate the dynamic column C on all the rows of @a batch, in a single loop
+/// over the arrays of its bindings.
+template <soa::is_materializable_column C, typename... B>
+std::shared_ptr<arrow::Array> materializeBatch(arrow::RecordBatch const& batch, framework::pack<B...>, const char* name)
+{
+  auto arrays = std::make_tuple(materializerBinding<B>(batch, name)...);
+  auto callback = C::callback_holder_t::getLambda();
+  typename arrow::CTypeTraits<typename C::type>::BuilderType builder;
+  auto status = builder.Reserve(batch.num_rows());
+  if (!status.ok()) {
+    throw runtime_error_f("Cannot reserve %lld rows to materialize %s", (long long)batch.num_rows(), name);
+  }
+  std::apply([&builder, &callback, n = batch.num_rows()](auto const&... array) {
+    for (int64_t i = 0; i < n; ++i) {
+      builder.UnsafeAppend(callback(array->Value(i)...));
+    }
+  },
+             arrays);
+  std::shared_ptr<arrow::Array> result;
+  status = builder.Finish(&result);
+  if (!status.ok()) {
+    throw runtime_error_f("Cannot materialize %s: %s", name, status.ToString().c_str());
+  }
+  return result;
+}
+
+/// Batch evaluation of the dynamic columns C for all the rows of @a fullTable,
+/// producing a table with their values which can be joined to it. Like for the
+/// spawner, the source is processed one record batch at the time.
+template <soa::is_materializable_column... C>
+auto materializer(framework::pack<C...>, std::shared_ptr<arrow::Table> const& fullTable, const char* name)
+{
+  static auto fields = o2::soa::createFieldsFromColumns(framework::pack<typename C::materialized...>{});
+  static auto new_schema = std::make_shared<arrow::Schema>(fields);
+  std::array<arrow::ArrayVector, sizeof...(C)> chunks;
+
+  arrow::TableBatchReader reader(*fullTable);
+  std::shared_ptr<arrow::RecordBatch> batch;
+  while (true) {
+    auto s = reader.ReadNext(&batch);
+    if (!s.ok()) {
+      throw runtime_error_f("Cannot read batches from source table to materialize %s: %s", name, s.ToString().c_str());
+    }
+    if (batch == nullptr) {
+      break;
+    }
+    size_t ci = 0;
+    ((chunks[ci++].emplace_back(materializeBatch<C>(*batch, typename C::bindings_t{}, name))), ...);
+  }
+
+  std::vector<std::shared_ptr<arrow::ChunkedArray>> arrays;
+  for (size_t ci = 0; ci < sizeof...(C); ++ci) {
+    arrays.push_back(std::make_shared<arrow::ChunkedArray>(chunks[ci], fields[ci]->type()));
+  }
+  auto schema = new_schema;
+  addLabelToSchema(schema, name);
+  return arrow::Table::Make(schema, arrays);
+}
+
 template <typename... T>
 using iterator_tuple_t = std::tuple<typename T::iterator...>;
 } // namespace o2::framework
@@ -0,0 +1,87 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+#ifndef O2_FRAMEWORK_TIMEFRAMECOSTMODEL_H_
+#define O2_FRAMEWORK_TIMEFRAMECOSTMODEL_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+
+namespace o2::framework
+{
+
+/// Online estimate of what a timeframe costs to the processing chain
+/// downstream of the device injecting it, as a linear function of its size:
+///
+/// - the time from its injection to the moment it is done everywhere,
+/// - the shared memory held by the chain while it is in flight.
+///
+/// The size can be in any unit proportional to the amount of data, e.g. bytes,
+/// or 1 for every timeframe when it is not known. The fits weight the samples
+/// exponentially, so that the model follows the changes of the data taking
+/// conditions.
+class TimeframeCostModel
+{
+ public:
+  /// @a decay is the weight of a new sample with respect to the history
+  explicit TimeframeCostModel(double decay = 0.05);
+
+  /// Timeframe @a timeslice of @a size was injected at @a now (in ns)
+  void injected(int64_t timeslice, size_t size, uint64_t now);
+  /// All the timeframes before @a oldestPossible are done at @a now (in ns)
+  void consumed(int64_t oldestPossible, uint64_t now);
+  /// @a freeMemory was observed with the current timeframes in flight
+  void memorySample(size_t freeMemory);
+
+  /// Expected time (in ns) between injection and completion of a timeframe of @a size
+  [[nodiscard]] double latency(size_t size) const;
+  /// Expected shared memory taken by a timeframe of @a size while in flight. It is 0 until
+  /// MinSamples memory samples were taken, and at most the largest usage observed so far.
+  [[nodiscard]] double memory(size_t size) const;
+  /// Time (in ns) to wait after the previous injection before injecting a timeframe
+  /// of @a size, so that the chain is fed at the rate it drains while keeping
+  /// at most @a maxInFlight timeframes in flight (Little's law).
+  [[nodiscard]] uint64_t pacing(size_t size, int maxInFlight) const;
+
+  /// Whether there are enough completed timeframes for the predictions to be meaningful
+  [[nodiscard]] bool ready() const { return mLatencyFit.samples >= MinSamples; }
+  [[nodiscard]] size_t inFlight() const { return mInFlight.size(); }
+  [[nodiscard]] size_t inFlightSize() const { return mInFlightSize; }
+
+  static constexpr int MinSamples = 4;
+
+ private:
+  /// Exponentially weighted least squares fit of y = slope * x + intercept
+  struct Fit {
+    double w = 0, x = 0, y = 0, xx = 0, xy = 0;
+    int samples = 0;
+    void add(double sx, double sy, double decay);
+    [[nodiscard]] double slope() const;
+    [[nodiscard]] double predict(double sx) const;
+  };
+  struct InFlight {
+    int64_t timeslice;
+    size_t size;
+    uint64_t injected;
+  };
+
+  double mDecay;
+  std::deque<InFlight> mInFlight;
+  size_t mInFlightSize = 0;
+  Fit mLatencyFit;
+  Fit mMemoryFit;
+  size_t mMaxFreeMemory = 0;
+  size_t mMaxUsedMemory = 0;
+};
+
+} // namespace o2::framework
+
+#endif // O2_FRAMEWORK_TIMEFRAMECOSTMODEL_H_
@@ -85,6 +85,97 @@ static inline auto extractOriginals(ProcessingContext& pc)
   }(std::make_index_sequence<refs.size()>());
 }
 
+/// Calls @a f with the metadata of the index table the index builder can produce
+/// for @a description, returns false if there is none.
+template <typename F>
+static bool visitIndexTable(header::DataDescription const& description, F&& f)
+{
+  if (description == header::DataDescription{"MA_RN2_EX"}) {
+    f(o2::aod::Run2MatchedExclusiveMetadata{});
+  } else if (description == header::DataDescription{"MA_RN2_SP"}) {
+    f(o2::aod::Run2MatchedSparseMetadata{});
+  } else if (description == header::DataDescription{"MA_RN3_EX"}) {
+    f(o2::aod::Run3MatchedExclusiveMetadata{});
+  } else if (description == header::DataDescription{"MA_RN3_SP"}) {
+    f(o2::aod::Run3MatchedSparseMetadata{});
+  } else if (description == header::DataDescription{"MA_BCCOL_EX"}) {
+    f(o2::aod::MatchedBCCollisionsExclusiveMetadata{});
+  } else if (description == header::DataDescription{"MA_BCCOL_SP"}) {
+    f(o2::aod::MatchedBCCollisionsSparseMetadata{});
+  } else if (description == header::DataDescription{"MA_BCCOLS_EX"}) {
+    f(o2::aod::MatchedBCCollisionsExclusiveMultiMetadata{});
+  } else if (description == header::DataDescription{"MA_BCCOLS_SP"}) {
+    f(o2::aod::MatchedBCCollisionsSparseMultiMetadata{});
+  } else if (description == header::DataDescription{"MA_RN3_BC_SP"}) {
+    f(o2::aod::Run3MatchedToBCSparseMetadata{});
+  } else if (description == header::DataDescription{"MA_RN3_BC_EX"}) {
+    f(o2::aod::Run3MatchedToBCExclusiveMetadata{});
+  } else if (description == header::DataDescription{"MA_RN2_BC_SP"}) {
+    f(o2::aod::Run2MatchedToBCSparseMetadata{});
+  } else {
+    return false;
+  }
+  return true;
+}
+
+/// Calls @a f with the hash of the extended table the spawner can produce
+/// for @a description and @a version, returns false if there is none.
+template <typename F>
+static bool visitSpawnable(header::DataDescription const& description, uint32_t version, F&& f)
+{
+  if (description == header::DataDescription{"EXTRACK"}) {
+    f.template operator()<o2::aod::Hash<"EXTRACK/0"_h>>();
+  } else if (description == header::DataDescription{"EXTRACK_IU"}) {
+    f.template operator()<o2::aod::Hash<"EXTRACK_IU/0"_h>>();
+  } else if (description == header::DataDescription{"EXTRACKCOV"}) {
+    f.template operator()<o2::aod::Hash<"EXTRACKCOV/0"_h>>();
+  } else if (description == header::DataDescription{"EXTRACKCOV_IU"}) {
+    f.template operator()<o2::aod::Hash<"EXTRACKCOV_IU/0"_h>>();
+  } else if (description == header::DataDescription{"EXTRACKEXTRA"}) {
+    if (version == 0U) {
+      f.template operator()<o2::aod::Hash<"EXTRACKEXTRA/0"_h>>();
+    } else if (version == 1U) {
+      f.template operator()<o2::aod::Hash<"EXTRACKEXTRA/1"_h>>();
+    } else if (version == 2U) {
+      f.template operator()<o2::aod::Hash<"EXTRACKEXTRA/2"_h>>();
+    } else {
+      return false;
+    }
+  } else if (description == header::DataDescription{"EXMFTTRACK"}) {
+    if (version == 0U) {
+      f.template operator()<o2::aod::Hash<"EXMFTTRACK/0"_h>>();
+    } else if (version == 1U) {
+      f.template operator()<o2::aod::Hash<"EXMFTTRACK/1"_h>>();
+    } else {
+      return false;
+    }
+  } else if (description == header::DataDescription{"EXFWDTRACK"}) {
+    f.template operator()<o2::aod::Hash<"EXFWDTRACK/0"_h>>();
+  } else if (description == header::DataDescription{"EXFWDTRACKCOV"}) {
+    f.template operator()<o2::aod::Hash<"EXFWDTRACKCOV/0"_h>>();
+  } else if (description == header::DataDescription{"EXMCPARTICLE"}) {
+    if (version == 0U) {
+      f.template operator()<o2::aod::Hash<"EXMCPARTICLE/0"_h>>();
+    } else if (version == 1U) {
+      f.template operator()<o2::aod::Hash<"EXMCPARTICLE/1"_h>>();
+    } else {
+      return false;
+    }
+  } else {
+    return false;
+  }
+  return true;
+}
+
+/// The "input:" metadata of the source tables @a refs, as attached to the inputs of the tasks
+template <size_t N, std::array<soa::TableRef, N> refs>
+static inline auto sourcesMetadata()
+{
+  return []<size_t... Is>(std::index_sequence<Is...>) -> std::vector<ConfigParamSpec> {
+    return {soa::tableRef2ConfigParamSpec<refs[Is]>()...};
+  }(std::make_index_sequence<refs.size()>());
+}
+
 AlgorithmSpec AODReaderHelpers::indexBuilderCallback(std::vector<InputSpec>& requested)
 {
   return AlgorithmSpec::InitCallback{[requested](InitContext& ic) {
@@ -109,29 +200,7 @@ AlgorithmSpec AODReaderHelpers::indexBuilderCallback(std::vector<InputSpec>& req
           }
         };
 
-        if (description == header::DataDescription{"MA_RN2_EX"}) {
-          outputs.adopt(Output{origin, description, version}, maker(o2::aod::Run2MatchedExclusiveMetadata{}));
-        } else if (description == header::DataDescription{"MA_RN2_SP"}) {
-          outputs.adopt(Output{origin, description, version}, maker(o2::aod::Run2MatchedSparseMetadata{}));
-        } else if (description == header::DataDescription{"MA_RN3_EX"}) {
-          outputs.adopt(Output{origin, description, version}, maker(o2::aod::Run3MatchedExclusiveMetadata{}));
-        } else if (description == header::DataDescription{"MA_RN3_SP"}) {
-          outputs.adopt(Output{origin, description, version}, maker(o2::aod::Run3MatchedSparseMetadata{}));
-        } else if (description == header::DataDescription{"MA_BCCOL_EX"}) {
-          outputs.adopt(Output{origin, description, version}, maker(o2::aod::MatchedBCCollisionsExclusiveMetadata{}));
-        } else if (description == header::DataDescription{"MA_BCCOL_SP"}) {
-          outputs.adopt(Output{origin, description, version}, maker(o2::aod::MatchedBCCollisionsSparseMetadata{}));
-        } else if (description == header::DataDescription{"MA_BCCOLS_EX"}) {
-          outputs.adopt(Output{origin, description, version}, maker(o2::aod::MatchedBCCollisionsExclusiveMultiMetadata{}));
-        } else if (description == header::DataDescription{"MA_BCCOLS_SP"}) {
-          outputs.adopt(Output{origin, description, version}, maker(o2::aod::MatchedBCCollisionsSparseMultiMetadata{}));
-        } else if (description == header::DataDescription{"MA_RN3_BC_SP"}) {
-          outputs.adopt(Output{origin, description, version}, maker(o2::aod::Run3MatchedToBCSparseMetadata{}));
-        } else if (description == header::DataDescription{"MA_RN3_BC_EX"}) {
-          outputs.adopt(Output{origin, description, version}, maker(o2::aod::Run3MatchedToBCExclusiveMetadata{}));
-        } else if (description == header::DataDescription{"MA_RN2_BC_SP"}) {
-          outputs.adopt(Output{origin, description, version}, maker(o2::aod::Run2MatchedToBCSparseMetadata{}));
-        } else {
+        if (!visitIndexTable(description, [&](auto metadata) { outputs.adopt(Output{origin, description, version}, maker(metadata)); })) {
           throw std::runtime_error("Not an index table");
         }
       }
@@ -153,39 +222,7 @@ AlgorithmSpec AODReaderHelpers::aodSpawnerCallback(std::vector<InputSpec>& reque
           return o2::framework::spawner<D>(extractOriginals<sources.size(), sources>(pc), input.binding.c_str());
         };
 
-        if (description == header::DataDescription{"EXTRACK"}) {
-          outputs.adopt(Output{origin, description, version}, maker.template operator()<o2::aod::Hash<"EXTRACK/0"_h>>());
-        } else if (description == header::DataDescription{"EXTRACK_IU"}) {
-          outputs.adopt(Output{origin, description, version}, maker.template operator()<o2::aod::Hash<"EXTRACK_IU/0"_h>>());
-        } else if (description == header::DataDescription{"EXTRACKCOV"}) {
-          outputs.adopt(Output{origin, description, version}, maker.template operator()<o2::aod::Hash<"EXTRACKCOV/0"_h>>());
-        } else if (description == header::DataDescription{"EXTRACKCOV_IU"}) {
-          outputs.adopt(Output{origin, description, version}, maker.template operator()<o2::aod::Hash<"EXTRACKCOV_IU/0"_h>>());
-        } else if (description == header::DataDescription{"EXTRACKEXTRA"}) {
-          if (version == 0U) {
-            outputs.adopt(Output{origin, description, version}, maker.template operator()<o2::aod::Hash<"EXTRACKEXTRA/0"_h>>());
-          } else if (version == 1U) {
-            outputs.adopt(Output{origin, description, version}, maker.template operator()<o2::aod::Hash<"EXTRACKEXTRA/1"_h>>());
-          } else if (version == 2U) {
-            outputs.adopt(Output{origin, description, version}, maker.template operator()<o2::aod::Hash<"EXTRACKEXTRA/2"_h>>());
-          }
-        } else if (description == header::DataDescription{"EXMFTTRACK"}) {
-          if (version == 0U) {
-            outputs.adopt(Output{origin, description, version}, maker.template operator()<o2::aod::Hash<"EXMFTTRACK/0"_h>>());
-          } else if (version == 1U) {
-            outputs.adopt(Output{origin, description, version}, maker.template operator()<o2::aod::Hash<"EXMFTTRACK/1"_h>>());
-          }
-        } else if (description == header::DataDescription{"EXFWDTRACK"}) {
-          outputs.adopt(Output{origin, description, version}, maker.template operator()<o2::aod::Hash<"EXFWDTRACK/0"_h>>());
-        } else if (description == header::DataDescription{"EXFWDTRACKCOV"}) {
-          outputs.adopt(Output{origin, description, version}, maker.template operator()<o2::aod::Hash<"EXFWDTRACKCOV/0"_h>>());
-        } else if (description == header::DataDescription{"EXMCPARTICLE"}) {
-          if (version == 0U) {
-            outputs.adopt(Output{origin, description, version}, maker.template operator()<o2::aod::Hash<"EXMCPARTICLE/0"_h>>());
-          } else if (version == 1U) {
-            outputs.adopt(Output{origin, description, version}, maker.template operator()<o2::aod::Hash<"EXMCPARTICLE/1"_h>>());
-          }
-        } else {
+        if (!visitSpawnable(description, version, [&]<o2::aod::is_aod_hash D>() { outputs.adopt(Output{origin, description, version}, maker.template operator()<D>()); })) {
           throw runtime_error("Not an extended table");
         }
       }
@@ -193,4 +230,21 @@ AlgorithmSpec AODReaderHelpers::aodSpawnerCallback(std::vector<InputSpec>& reque
   }};
 }
 
+bool AODReaderHelpers::derivedTableSources(ConcreteDataMatcher const& matcher, std::vector<ConfigParamSpec>& sources)
+{
+  if (matcher.origin == header::DataOrigin{"DYN"}) {
+    return visitSpawnable(matcher.description, matcher.subSpec, [&sources]<o2::aod::is_aod_hash D>() {
+      using metadata_t = o2::aod::MetadataTrait<D>::metadata;
+      sources = sourcesMetadata<metadata_t::sources.size(), metadata_t::sources>();
+    });
+  }
+  if (matcher.origin == header::DataOrigin{"IDX"}) {
+    return visitIndexTable(matcher.description, [&sources](auto metadata) {
+      using metadata_t = decltype(metadata);
+      sources = sourcesMetadata<metadata_t::sources.size(), metadata_t::sources>();
+    });
+  }
+  return false;
+}
+
 } // namespace o2::framework::readers
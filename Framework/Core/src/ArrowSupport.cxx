@@ -432,6 +432,7 @@ o2::framework::ServiceSpec ArrowSupport::arrowBackendSpec()
       if (builder != workflow.end()) {
         // collect currently requested IDXs
         ac.requestedIDXs.clear();
+        ac.providedIDXs.clear();
         for (auto& d : workflow) {
           if (d.name == builder->name) {
             continue;
@@ -442,14 +443,25 @@ o2::framework::ServiceSpec ArrowSupport::arrowBackendSpec()
               DataSpecUtils::updateInputList(ac.requestedIDXs, std::move(copy));
             }
           }
+          for (auto const& o : d.outputs) {
+            if (DataSpecUtils::partialMatch(o, header::DataOrigin{"IDX"})) {
+              ac.providedIDXs.emplace_back(o);
+            }
+          }
+        }
+        ac.builderInputs.clear();
+        for (auto& input : ac.requestedIDXs) {
+          if (std::none_of(ac.providedIDXs.begin(), ac.providedIDXs.end(), [&input](auto const& x) { return DataSpecUtils::match(input, x); })) {
+            ac.builderInputs.emplace_back(input);
+          }
         }
         // recreate inputs and outputs
         builder->inputs.clear();
         builder->outputs.clear();
         // replace AlgorithmSpec
         //  FIXME: it should be made more generic, so it does not need replacement...
-        builder->algorithm = readers::AODReaderHelpers::indexBuilderCallback(ac.requestedIDXs);
-        AnalysisSupportHelpers::addMissingOutputsToBuilder(ac.requestedIDXs, ac.requestedAODs, ac.requestedDYNs, *builder);
+        builder->algorithm = readers::AODReaderHelpers::indexBuilderCallback(ac.builderInputs);
+        AnalysisSupportHelpers::addMissingOutputsToBuilder(ac.builderInputs, ac.requestedAODs, ac.requestedDYNs, *builder);
       }
 
       if (spawner != workflow.end()) {
@@ -45,6 +45,13 @@ o2::framework::ServiceSpec CommonMessageBackends::fairMQDeviceProxy()
     .name = "fairmq-device-proxy",
     .init = [](ServiceRegistryRef, DeviceState&, fair::mq::ProgOptions& options) -> ServiceHandle {
       auto* proxy = new FairMQDeviceProxy();
+      if (options.Count("output-buffer-pool-size")) {
+        auto poolSizeMB = std::stoll(options.GetProperty<std::string>("output-buffer-pool-size"));
+        auto numaNode = std::stoi(options.GetProperty<std::string>("output-buffer-pool-numa-node"));
+        if (poolSizeMB > 0) {
+          proxy->setOutputBufferPool(poolSizeMB << 20, numaNode);
+        }
+      }
       return ServiceHandle{.hash = TypeIdHelpers::uniqueId<FairMQDeviceProxy>(), .instance = proxy, .kind = ServiceKind::Serial};
     },
     .start = [](ServiceRegistryRef services, void* instance) {
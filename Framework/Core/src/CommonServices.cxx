@@ -18,6 +18,7 @@
 #include "Framework/TimesliceIndex.h"
 #include "Framework/DataTakingContext.h"
 #include "Framework/DataSender.h"
+#include "Framework/FairMQDeviceProxy.h"
 #include "Framework/ServiceRegistryRef.h"
 #include "Framework/DeviceSpec.h"
 #include "Framework/LocalRootFileService.h"
@@ -30,6 +31,7 @@
 #include "Framework/DanglingContext.h"
 #include "Framework/DataProcessingHelpers.h"
 #include "InputRouteHelpers.h"
+#include "ComputingResourceHelpers.h"
 #include "Framework/EndOfStreamContext.h"
 #include "Framework/RawDeviceService.h"
 #include "Framework/RunningWorkflowInfo.h"
@@ -799,6 +801,19 @@ auto sendRelayerMetrics(ServiceRegistryRef registry, DataProcessingStats& stats)
 
   stats.updateStats({static_cast<short>(ProcessingStatsId::TOTAL_RATE_IN_MB_S), DataProcessingStats::Op::InstantaneousRate, totalBytesIn / 1000000});
   stats.updateStats({static_cast<short>(ProcessingStatsId::TOTAL_RATE_OUT_MB_S), DataProcessingStats::Op::InstantaneousRate, totalBytesOut / 1000000});
+
+  MessageBufferPool::Stats poolStats;
+  if (registry.get<FairMQDeviceProxy>().getOutputBufferPoolStats(poolStats)) {
+    auto allocations = poolStats.hits + poolStats.misses + poolStats.fallbacks;
+    stats.updateStats({static_cast<short>(ProcessingStatsId::OUTPUT_BUFFER_POOL_HITS), DataProcessingStats::Op::Set, (int64_t)poolStats.hits});
+    stats.updateStats({static_cast<short>(ProcessingStatsId::OUTPUT_BUFFER_POOL_MISSES), DataProcessingStats::Op::Set, (int64_t)poolStats.misses});
+    stats.updateStats({static_cast<short>(ProcessingStatsId::OUTPUT_BUFFER_POOL_FALLBACKS), DataProcessingStats::Op::Set, (int64_t)poolStats.fallbacks});
+    // hit rate in percent, fragmentation as the per mille of the carved buffers which are idle
+    stats.updateStats({static_cast<short>(ProcessingStatsId::OUTPUT_BUFFER_POOL_HIT_RATE), DataProcessingStats::Op::Set, allocations ? (int64_t)(100 * poolStats.hits / allocations) : 0});
+    stats.updateStats({static_cast<short>(ProcessingStatsId::OUTPUT_BUFFER_POOL_IN_USE), DataProcessingStats::Op::Set, (int64_t)poolStats.inUse});
+    stats.updateStats({static_cast<short>(ProcessingStatsId::OUTPUT_BUFFER_POOL_IDLE), DataProcessingStats::Op::Set, (int64_t)poolStats.idle});
+    stats.updateStats({static_cast<short>(ProcessingStatsId::OUTPUT_BUFFER_POOL_FRAGMENTATION), DataProcessingStats::Op::Set, poolStats.carved ? (int64_t)(1000 * poolStats.idle / poolStats.carved) : 0});
+  }
 };
 
 auto flushStates(ServiceRegistryRef registry, DataProcessingStates& states) -> void
@@ -886,6 +901,7 @@ o2::framework::ServiceSpec CommonServices::dataProcessingStats()
 #else
       bool enableDebugMetrics = true;
 #endif
+      bool outputBufferPoolMetrics = options.Count("output-buffer-pool-size") && std::stoll(options.GetProperty<std::string>("output-buffer-pool-size")) > 0;
       bool arrowAndResourceLimitingMetrics = false;
       if (!DefaultsHelpers::onlineDeploymentMode() && DefaultsHelpers::deploymentMode() != DeploymentMode::FST) {
         arrowAndResourceLimitingMetrics = true;
@@ -901,6 +917,16 @@ o2::framework::ServiceSpec CommonServices::dataProcessingStats()
         enableCPUUsageFraction = false;
       }
 
+      // The placement chosen by the driver (--device-placement) is inherited from
+      // the fork, so it is the one of the current process: the allowed cores and,
+      // when they all belong to the same one, the NUMA node.
+      auto topology = ComputingResourceHelpers::getLocalhostTopology();
+      int64_t numaNode = topology.size() == 1 ? topology[0].id : -1;
+      int64_t boundCpus = 0;
+      for (auto& node : topology) {
+        boundCpus += node.cpus.size();
+      }
+
       std::vector<DataProcessingStats::MetricSpec> metrics = {
         MetricSpec{.name = "errors",
                    .metricId = (int)ProcessingStatsId::ERROR_COUNT,
@@ -1101,6 +1127,63 @@ o2::framework::ServiceSpec CommonServices::dataProcessingStats()
                    .scope = Scope::DPL,
                    .minPublishInterval = 0,
                    .maxRefreshLatency = 10000,
+                   .sendInitialValue = true},
+        MetricSpec{.name = "output-buffer-pool-hits",
+                   .enabled = outputBufferPoolMetrics,
+                   .metricId = static_cast<short>(ProcessingStatsId::OUTPUT_BUFFER_POOL_HITS),
+                   .kind = Kind::UInt64,
+                   .minPublishInterval = quickUpdateInterval},
+        MetricSpec{.name = "output-buffer-pool-misses",
+                   .enabled = outputBufferPoolMetrics,
+                   .metricId = static_cast<short>(ProcessingStatsId::OUTPUT_BUFFER_POOL_MISSES),
+                   .kind = Kind::UInt64,
+                   .minPublishInterval = quickUpdateInterval},
+        MetricSpec{.name = "output-buffer-pool-fallbacks",
+                   .enabled = outputBufferPoolMetrics,
+                   .metricId = static_cast<short>(ProcessingStatsId::OUTPUT_BUFFER_POOL_FALLBACKS),
+                   .kind = Kind::UInt64,
+                   .minPublishInterval = quickUpdateInterval},
+        MetricSpec{.name = "output-buffer-pool-hit-rate",
+                   .enabled = outputBufferPoolMetrics,
+                   .metricId = static_cast<short>(ProcessingStatsId::OUTPUT_BUFFER_POOL_HIT_RATE),
+                   .kind = Kind::Int,
+                   .minPublishInterval = quickUpdateInterval},
+        MetricSpec{.name = "output-buffer-pool-in-use",
+                   .enabled = outputBufferPoolMetrics,
+                   .metricId = static_cast<short>(ProcessingStatsId::OUTPUT_BUFFER_POOL_IN_USE),
+                   .kind = Kind::UInt64,
+                   .minPublishInterval = quickUpdateInterval},
+        MetricSpec{.name = "output-buffer-pool-idle",
+                   .enabled = outputBufferPoolMetrics,
+                   .metricId = static_cast<short>(ProcessingStatsId::OUTPUT_BUFFER_POOL_IDLE),
+                   .kind = Kind::UInt64,
+                   .minPublishInterval = quickUpdateInterval},
+        MetricSpec{.name = "output-buffer-pool-fragmentation",
+                   .enabled = outputBufferPoolMetrics,
+                   .metricId = static_cast<short>(ProcessingStatsId::OUTPUT_BUFFER_POOL_FRAGMENTATION),
+                   .kind = Kind::Int,
+                   .minPublishInterval = quickUpdateInterval},
+        // only updated by the calibration devices using TimeSlotCalibration::publishStats
+        MetricSpec{.name = "calib-finalized-slots", .metricId = static_cast<short>(ProcessingStatsId::CALIB_FINALIZED_SLOTS), .kind = Kind::UInt64, .scope = Scope::Online, .minPublishInterval = quickUpdateInterval},
+        MetricSpec{.name = "calib-slot-fill-time-ms", .metricId = static_cast<short>(ProcessingStatsId::CALIB_SLOT_FILL_TIME_MS), .kind = Kind::UInt64, .scope = Scope::Online, .minPublishInterval = quickUpdateInterval},
+        MetricSpec{.name = "calib-slot-finalize-time-ms", .metricId = static_cast<short>(ProcessingStatsId::CALIB_SLOT_FINALIZE_TIME_MS), .kind = Kind::UInt64, .scope = Scope::Online, .minPublishInterval = quickUpdateInterval},
+        MetricSpec{.name = "calib-slot-max-finalize-time-ms", .metricId = static_cast<short>(ProcessingStatsId::CALIB_SLOT_MAX_FINALIZE_TIME_MS), .kind = Kind::UInt64, .scope = Scope::Online, .minPublishInterval = quickUpdateInterval},
+        MetricSpec{.name = "calib-pending-finalizations", .metricId = static_cast<short>(ProcessingStatsId::CALIB_PENDING_FINALIZATIONS), .kind = Kind::Int, .scope = Scope::Online, .minPublishInterval = quickUpdateInterval},
+        MetricSpec{.name = "numa-node",
+                   .metricId = static_cast<short>(ProcessingStatsId::NUMA_NODE),
+                   .kind = Kind::Int,
+                   .scope = Scope::Online,
+                   .defaultValue = numaNode,
+                   .minPublishInterval = quickUpdateInterval,
+                   .maxRefreshLatency = onlineRefreshLatency,
+                   .sendInitialValue = true},
+        MetricSpec{.name = "bound-cpus",
+                   .metricId = static_cast<short>(ProcessingStatsId::BOUND_CPUS),
+                   .kind = Kind::UInt64,
+                   .scope = Scope::Online,
+                   .defaultValue = boundCpus,
+                   .minPublishInterval = quickUpdateInterval,
+                   .maxRefreshLatency = onlineRefreshLatency,
                    .sendInitialValue = true}};
 
       for (auto& metric : metrics) {
@@ -9,10 +9,21 @@
 // granted to it by virtue of its status as an Intergovernmental Organization
 // or submit itself to any jurisdiction.
 #include "ComputingResourceHelpers.h"
+#include "Framework/DeviceSpec.h"
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+#include <map>
 #include <thread>
+#include <unordered_map>
 #include <unistd.h>
 #include <sstream>
 
+#ifdef __linux__
+#include <sched.h>
+#include <sys/syscall.h>
+#endif
+
 namespace o2::framework
 {
 long getTotalNumberOfBytes()
@@ -52,4 +63,237 @@ std::vector<ComputingResource> ComputingResourceHelpers::parseResources(std::str
   return resources;
 }
 
+std::vector<int> ComputingResourceHelpers::parseCpuList(std::string const& cpuList)
+{
+  std::vector<int> cpus;
+  std::istringstream str{cpuList};
+  std::string range;
+  while (std::getline(str, range, ',')) {
+    int first = 0;
+    int last = 0;
+    char dash = 0;
+    std::istringstream in{range};
+    if (!(in >> first)) {
+      continue;
+    }
+    last = first;
+    if (in >> dash && dash == '-') {
+      in >> last;
+    }
+    for (int cpu = first; cpu <= last; ++cpu) {
+      cpus.push_back(cpu);
+    }
+  }
+  return cpus;
+}
+
+std::string ComputingResourceHelpers::formatCpuList(std::vector<int> const& cpus)
+{
+  std::string result;
+  for (size_t i = 0; i < cpus.size();) {
+    size_t j = i;
+    while (j + 1 < cpus.size() && cpus[j + 1] == cpus[j] + 1) {
+      ++j;
+    }
+    if (!result.empty()) {
+      result += ",";
+    }
+    result += std::to_string(cpus[i]);
+    if (j != i) {
+      result += "-" + std::to_string(cpus[j]);
+    }
+    i = j + 1;
+  }
+  return result;
+}
+
+std::vector<NumaNodeInfo> ComputingResourceHelpers::getLocalhostTopology(std::string const& sysfsNodes)
+{
+  std::vector<int> allowed;
+#ifdef __linux__
+  cpu_set_t set;
+  CPU_ZERO(&set);
+  if (sched_getaffinity(0, sizeof(set), &set) == 0) {
+    for (int cpu = 0; cpu < CPU_SETSIZE; ++cpu) {
+      if (CPU_ISSET(cpu, &set)) {
+        allowed.push_back(cpu);
+      }
+    }
+  }
+#endif
+  if (allowed.empty()) {
+    for (int cpu = 0; cpu < (int)std::thread::hardware_concurrency(); ++cpu) {
+      allowed.push_back(cpu);
+    }
+  }
+
+  std::vector<NumaNodeInfo> nodes;
+  std::error_code ec;
+  for (auto const& entry : std::filesystem::directory_iterator(sysfsNodes, ec)) {
+    auto name = entry.path().filename().string();
+    if (name.rfind("node", 0) != 0 || name.size() == 4 || name.find_first_not_of("0123456789", 4) != std::string::npos) {
+      continue;
+    }
+    std::ifstream in(entry.path() / "cpulist");
+    std::string cpuList;
+    std::getline(in, cpuList);
+    NumaNodeInfo node{std::stoi(name.substr(4)), {}};
+    for (auto cpu : parseCpuList(cpuList)) {
+      if (std::binary_search(allowed.begin(), allowed.end(), cpu)) {
+        node.cpus.push_back(cpu);
+      }
+    }
+    if (!node.cpus.empty()) {
+      nodes.push_back(node);
+    }
+  }
+  if (nodes.empty()) {
+    nodes.push_back(NumaNodeInfo{0, allowed});
+  }
+  std::sort(nodes.begin(), nodes.end(), [](auto const& a, auto const& b) { return a.id < b.id; });
+  return nodes;
+}
+
+void ComputingResourceHelpers::placeDevices(std::vector<DeviceSpec>& devices, std::vector<NumaNodeInfo> const& topology, DevicePlacementPolicy policy)
+{
+  for (auto& device : devices) {
+    device.resource.numaNode = -1;
+    device.resource.cpus.clear();
+  }
+  if (policy == DevicePlacementPolicy::None || devices.empty() || topology.empty()) {
+    return;
+  }
+
+  // The number of routes between two devices is our proxy for how much
+  // they talk to each other.
+  std::unordered_map<std::string, size_t> consumerByChannel;
+  for (size_t di = 0; di < devices.size(); ++di) {
+    for (auto& channel : devices[di].inputChannels) {
+      consumerByChannel[channel.name] = di;
+    }
+  }
+  std::vector<std::map<size_t, size_t>> links(devices.size());
+  auto addLink = [&](size_t producer, std::string const& channel) {
+    auto consumer = consumerByChannel.find(channel);
+    if (consumer == consumerByChannel.end() || consumer->second == producer) {
+      return;
+    }
+    links[producer][consumer->second]++;
+    links[consumer->second][producer]++;
+  };
+  for (size_t di = 0; di < devices.size(); ++di) {
+    for (auto& route : devices[di].outputs) {
+      addLink(di, route.channel);
+    }
+    for (auto& route : devices[di].forwards) {
+      addLink(di, route.channel);
+    }
+  }
+
+  // Each node takes a share of the devices proportional to its cores.
+  size_t totalCpus = 0;
+  for (auto& node : topology) {
+    totalCpus += node.cpus.size();
+  }
+  std::vector<size_t> capacity(topology.size());
+  std::vector<size_t> load(topology.size(), 0);
+  for (size_t ni = 0; ni < topology.size(); ++ni) {
+    capacity[ni] = (devices.size() * topology[ni].cpus.size() + totalCpus - 1) / totalCpus;
+  }
+
+  // Visit the devices breadth first along the links, so that whole
+  // connected chains tend to be placed before the node fills up.
+  std::vector<size_t> order;
+  std::vector<bool> visited(devices.size(), false);
+  for (size_t start = 0; start < devices.size(); ++start) {
+    if (visited[start]) {
+      continue;
+    }
+    visited[start] = true;
+    order.push_back(start);
+    for (size_t oi = order.size() - 1; oi < order.size(); ++oi) {
+      for (auto& [other, weight] : links[order[oi]]) {
+        if (!visited[other]) {
+          visited[other] = true;
+          order.push_back(other);
+        }
+      }
+    }
+  }
+
+  std::vector<int> assignedNode(devices.size(), -1);
+  for (auto di : order) {
+    int best = -1;
+    size_t bestScore = 0;
+    for (size_t ni = 0; ni < topology.size(); ++ni) {
+      if (load[ni] >= capacity[ni]) {
+        continue;
+      }
+      size_t score = 0;
+      for (auto& [other, weight] : links[di]) {
+        score += assignedNode[other] == (int)ni ? weight : 0;
+      }
+      bool better = best < 0 || score > bestScore ||
+                    (score == bestScore && load[ni] * capacity[best] < load[best] * capacity[ni]);
+      if (better) {
+        best = ni;
+        bestScore = score;
+      }
+    }
+    assignedNode[di] = best;
+    load[best]++;
+  }
+
+  for (size_t ni = 0; ni < topology.size(); ++ni) {
+    auto const& cpus = topology[ni].cpus;
+    size_t k = 0;
+    for (size_t di = 0; di < devices.size(); ++di) {
+      if (assignedNode[di] != (int)ni) {
+        continue;
+      }
+      auto& resource = devices[di].resource;
+      resource.numaNode = topology[ni].id;
+      if (policy == DevicePlacementPolicy::Numa) {
+        resource.cpus = cpus;
+      } else if (load[ni] <= cpus.size()) {
+        resource.cpus.assign(cpus.begin() + k * cpus.size() / load[ni], cpus.begin() + (k + 1) * cpus.size() / load[ni]);
+      } else {
+        resource.cpus = {cpus[k % cpus.size()]};
+      }
+      ++k;
+    }
+  }
+}
+
+bool ComputingResourceHelpers::applyPlacement(ComputingResource const& resource)
+{
+#ifdef __linux__
+  bool ok = true;
+  if (!resource.cpus.empty()) {
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    for (auto cpu : resource.cpus) {
+      if (cpu < CPU_SETSIZE) {
+        CPU_SET(cpu, &set);
+      }
+    }
+    ok = sched_setaffinity(0, sizeof(set), &set) == 0;
+  }
+#ifdef SYS_set_mempolicy
+  // Bare system call, not to depend on libnuma. Preferred rather than bound,
+  // so that a full node does not make the device fail.
+  constexpr int MPOL_PREFERRED_MODE = 1;
+  constexpr size_t maskBits = 8 * sizeof(unsigned long);
+  if (resource.numaNode >= 0 && resource.numaNode < (int)(maskBits * 16)) {
+    unsigned long mask[16] = {0};
+    mask[resource.numaNode / maskBits] = 1ul << (resource.numaNode % maskBits);
+    ok = syscall(SYS_set_mempolicy, MPOL_PREFERRED_MODE, mask, maskBits * 16) == 0 && ok;
+  }
+#endif
+  return ok;
+#else
+  return resource.cpus.empty() && resource.numaNode < 0;
+#endif
+}
+
 } // namespace o2::framework
@@ -19,6 +19,14 @@
 
 namespace o2::framework
 {
+struct DeviceSpec;
+
+/// The cores of one NUMA node of the local host
+struct NumaNodeInfo {
+  int id;
+  std::vector<int> cpus;
+};
+
 struct ComputingResourceHelpers {
   /// This will create a ComputingResource which matches what offered by localhost.
   /// Notice that the port range will always be [22000, 23000) since in any case we will
@@ -29,6 +37,27 @@ struct ComputingResourceHelpers {
   ///
   /// <hostname>:<cpu cores>:<memory in MB>:<start port>:<last port>
   static std::vector<ComputingResource> parseResources(std::string const& resourceString);
+
+  /// Parse a list of cores in the kernel format, e.g. "0-3,8,10-11"
+  static std::vector<int> parseCpuList(std::string const& cpuList);
+  /// Inverse of parseCpuList
+  static std::string formatCpuList(std::vector<int> const& cpus);
+
+  /// The NUMA nodes of the local host, as found in @a sysfsNodes, restricted to the cores
+  /// the current process may run on. When the information is not available,
+  /// a single node with all the allowed cores is returned.
+  static std::vector<NumaNodeInfo> getLocalhostTopology(std::string const& sysfsNodes = "/sys/devices/system/node");
+
+  /// Fill the numaNode and the cpus of the resources of @a devices according to @a policy.
+  /// Devices are distributed over the nodes proportionally to their number of cores,
+  /// keeping on the same node the devices with the most routes between each other.
+  static void placeDevices(std::vector<DeviceSpec>& devices, std::vector<NumaNodeInfo> const& topology, DevicePlacementPolicy policy);
+
+  /// Bind the calling process to the cores and the memory of @a resource. Meant to be
+  /// invoked in the child, between fork and exec, so that all the threads of the device
+  /// inherit it.
+  /// @return false if the binding was not possible
+  static bool applyPlacement(ComputingResource const& resource);
 };
 } // namespace o2::framework
 
@@ -40,6 +40,13 @@ void ControlWebSocketHandler::frame(char const* frame, size_t s)
     }
     return false;
   };
+  if (DeviceMetricsHelper::parseBinaryMetric(tokenSV, metricMatch)) {
+    assert(mContext.metrics);
+    DeviceMetricsHelper::processMetric(metricMatch, (*mContext.metrics)[mIndex], newMetricCallback);
+    didProcessMetric = true;
+    didHaveNewMetric |= hasNewMetric;
+    return;
+  }
   LOG(debug3) << "Data received: " << std::string_view(frame, s);
   if (DeviceMetricsHelper::parseMetric(tokenSV, metricMatch)) {
     // We use this callback to cache which metrics are needed to provide a
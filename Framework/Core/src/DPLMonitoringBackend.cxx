@@ -11,6 +11,7 @@
 
 #include "DPLMonitoringBackend.h"
 #include "Framework/DriverClient.h"
+#include "Framework/DeviceMetricsHelper.h"
 #include "Framework/ServiceRegistry.h"
 #include "Framework/RuntimeError.h"
 #include <fmt/format.h>
@@ -55,6 +56,23 @@ inline unsigned long convertTimestamp(const std::chrono::time_point<std::chrono:
 void DPLMonitoringBackend::send(o2::monitoring::Metric const& metric)
 {
   std::array<char, 4096> buffer;
+  auto& client = mRegistry.get<framework::DriverClient>();
+  // Single valued metrics are sent in binary form when possible, which
+  // is cheaper to produce and to parse on the driver side. Tags are
+  // ignored by DPL anyway.
+  if (metric.getValuesSize() == 1 && client.acceptsBinaryMetrics()) {
+    auto timestamp = convertTimestamp(metric.getTimestamp());
+    auto size = std::visit(overloaded{
+                             [&](const std::string& value) { return DeviceMetricsHelper::encodeBinaryMetric(buffer.data(), buffer.size(), metric.getName(), std::string_view(value), timestamp); },
+                             [&](double value) { return DeviceMetricsHelper::encodeBinaryMetric(buffer.data(), buffer.size(), metric.getName(), (float)value, timestamp); },
+                             [&](auto value) { return DeviceMetricsHelper::encodeBinaryMetric(buffer.data(), buffer.size(), metric.getName(), value, timestamp); }},
+                           metric.getValues().front().second);
+    // Names which are too long still go through the text format.
+    if (size != 0) {
+      client.tell(buffer.data(), size);
+      return;
+    }
+  }
   auto mStream = fmt::format_to(buffer.begin(), "[METRIC] {}", metric.getName());
   for (auto& value : metric.getValues()) {
     auto stringValue = std::visit(overloaded{
@@ -84,7 +102,7 @@ void DPLMonitoringBackend::send(o2::monitoring::Metric const& metric)
     throw runtime_error_f("Metric too long");
   }
   buffer[size] = '\0';
-  mRegistry.get<framework::DriverClient>().tell(buffer.data(), size);
+  client.tell(buffer.data(), size);
 }
 
 } // namespace o2::framework
@@ -43,6 +43,13 @@ enum struct ParsingState {
   IN_EXIT,
   IN_ERROR,
 };
+
+// The data_relayer/<slot> metrics are the state of the slots, displayed
+// as enums in the GUI. data_relayer/w* and data_relayer/h* are not.
+static bool isEnumMetric(char const* key)
+{
+  return strncmp(key, "data_relayer/", 13) == 0 && key[13] != 'w' && key[13] != 'h';
+}
 // Parses a metric in the form
 //
 // [METRIC] <name>[/<begin>[-<end>]],<type> <value> <timestamp>[ <tag>,<tag>]
@@ -138,7 +145,7 @@ bool DeviceMetricsHelper::parseMetric(std::string_view const s, ParsedMetricMatc
           } else {
             break;
           }
-          if (strncmp(match.beginKey, "data_relayer/", 13) == 0 && match.beginKey[13] != 'w' && match.beginKey[13] != 'h') {
+          if (isEnumMetric(match.beginKey)) {
             match.type = MetricType::Enum;
           }
         }
@@ -224,6 +231,115 @@ bool DeviceMetricsHelper::parseMetric(std::string_view const s, ParsedMetricMatc
   }
 }
 
+namespace
+{
+template <typename T>
+size_t encodeBinary(char* buffer, size_t size, std::string_view name, MetricType type, T const* value, size_t valueSize, size_t timestamp)
+{
+  size_t total = 3 + name.size() + sizeof(uint64_t) + valueSize;
+  if (name.size() > MetricLabel::MAX_METRIC_LABEL_SIZE - 1 || total > size) {
+    return 0;
+  }
+  uint64_t ts = timestamp;
+  char* cur = buffer;
+  *cur++ = DeviceMetricsHelper::BINARY_METRIC_MARKER;
+  *cur++ = (char)type;
+  *cur++ = (char)(unsigned char)name.size();
+  memcpy(cur, name.data(), name.size());
+  cur += name.size();
+  memcpy(cur, &ts, sizeof(ts));
+  cur += sizeof(ts);
+  memcpy(cur, value, valueSize);
+  return total;
+}
+} // namespace
+
+size_t DeviceMetricsHelper::encodeBinaryMetric(char* buffer, size_t size, std::string_view name, int value, size_t timestamp)
+{
+  int32_t v = value;
+  return encodeBinary(buffer, size, name, MetricType::Int, &v, sizeof(v), timestamp);
+}
+
+size_t DeviceMetricsHelper::encodeBinaryMetric(char* buffer, size_t size, std::string_view name, float value, size_t timestamp)
+{
+  return encodeBinary(buffer, size, name, MetricType::Float, &value, sizeof(value), timestamp);
+}
+
+size_t DeviceMetricsHelper::encodeBinaryMetric(char* buffer, size_t size, std::string_view name, uint64_t value, size_t timestamp)
+{
+  return encodeBinary(buffer, size, name, MetricType::Uint64, &value, sizeof(value), timestamp);
+}
+
+size_t DeviceMetricsHelper::encodeBinaryMetric(char* buffer, size_t size, std::string_view name, std::string_view value, size_t timestamp)
+{
+  return encodeBinary(buffer, size, name, MetricType::String, value.data(), value.size(), timestamp);
+}
+
+bool DeviceMetricsHelper::parseBinaryMetric(std::string_view const s, ParsedMetricMatch& match)
+{
+  if (s.size() < 3 || s[0] != BINARY_METRIC_MARKER) {
+    return false;
+  }
+  auto type = (MetricType)(unsigned char)s[1];
+  size_t nameSize = (unsigned char)s[2];
+  size_t headerSize = 3 + nameSize + sizeof(uint64_t);
+  if (nameSize == 0 || s.size() < headerSize) {
+    return false;
+  }
+  char const* value = s.data() + headerSize;
+  size_t valueSize = s.size() - headerSize;
+  switch (type) {
+    case MetricType::Int: {
+      int32_t v;
+      if (valueSize != sizeof(v)) {
+        return false;
+      }
+      memcpy(&v, value, sizeof(v));
+      match.intValue = v;
+      match.uint64Value = v;
+      match.floatValue = v;
+    } break;
+    case MetricType::Float: {
+      float v;
+      if (valueSize != sizeof(v)) {
+        return false;
+      }
+      memcpy(&v, value, sizeof(v));
+      match.floatValue = v;
+      match.intValue = v;
+      match.uint64Value = v;
+    } break;
+    case MetricType::Uint64: {
+      uint64_t v;
+      if (valueSize != sizeof(v)) {
+        return false;
+      }
+      memcpy(&v, value, sizeof(v));
+      match.uint64Value = v;
+      match.intValue = v;
+      match.floatValue = v;
+    } break;
+    case MetricType::String:
+      match.beginStringValue = value;
+      match.endStringValue = value + valueSize;
+      break;
+    default:
+      return false;
+  }
+  uint64_t timestamp;
+  memcpy(&timestamp, s.data() + 3 + nameSize, sizeof(timestamp));
+  match.beginKey = s.data() + 3;
+  match.endKey = match.beginKey + nameSize;
+  match.firstIndex = -1;
+  match.lastIndex = -1;
+  match.timestamp = timestamp;
+  match.type = type;
+  if (type != MetricType::String && nameSize > 13 && isEnumMetric(match.beginKey)) {
+    match.type = MetricType::Enum;
+  }
+  return true;
+}
+
 static auto updatePrefix = [](std::string_view prefix, DeviceMetricsInfo& info, bool hasPrefix, std::vector<MetricPrefixIndex>::iterator pi) -> void {
   // Insert the prefix if needed
   if (!hasPrefix) {
@@ -269,6 +385,7 @@ static auto initMetric = [](DeviceMetricsInfo& info) -> void {
   info.maxDomain.push_back(std::numeric_limits<size_t>::lowest());
   info.minDomain.push_back(std::numeric_limits<size_t>::max());
   info.changed.push_back(false);
+  info.history.emplace_back();
   if (info.metricLabels.size() > DPL_MAX_METRICS_PER_DEVICE) {
     for (size_t i = 0; i < info.metricLabels.size(); i++) {
       std::cout << info.metricLabels[i].label << std::endl;
@@ -530,6 +647,9 @@ bool DeviceMetricsHelper::processMetric(ParsedMetricMatch& match,
     return previousAverage + (nextValue - previousAverage) / (previousCount + 1);
   };
   info.average[metricIndex] = onlineAverage(match.floatValue, info.average[metricIndex], metricInfo.filledMetrics);
+  if (metricInfo.type != MetricType::String && metricInfo.type != MetricType::Enum) {
+    updateHistory(info, metricIndex, match.floatValue, match.timestamp);
+  }
   // We point to the next metric
   metricInfo.pos = (metricInfo.pos + 1) % sizeOfCollection;
   ++metricInfo.filledMetrics;
@@ -553,4 +673,46 @@ size_t DeviceMetricsHelper::metricIdxByName(std::string_view const name, const D
   return i;
 }
 
+void DeviceMetricsHelper::updateHistory(DeviceMetricsInfo& info, size_t metricIndex, float value, size_t timestamp)
+{
+  auto& history = info.history[metricIndex];
+  for (size_t ri = 0; ri < MetricHistory::RESOLUTIONS; ++ri) {
+    auto& buckets = history.buckets[ri];
+    auto& pos = history.pos[ri];
+    auto capacity = MetricHistory::CAPACITY[ri];
+    auto index = (uint32_t)(timestamp / MetricHistory::BUCKET_WIDTH[ri]);
+    if (pos != 0) {
+      auto& last = buckets[(pos - 1) % capacity];
+      if (index <= last.index) {
+        last.min = std::min(last.min, value);
+        last.max = std::max(last.max, value);
+        last.sum += value;
+        last.count++;
+        continue;
+      }
+    }
+    MetricBucket bucket{.index = index, .count = 1, .min = value, .max = value, .sum = value};
+    if (buckets.size() < capacity) {
+      buckets.push_back(bucket);
+    } else {
+      buckets[pos % capacity] = bucket;
+    }
+    pos++;
+  }
+}
+
+size_t DeviceMetricsHelper::getHistory(DeviceMetricsInfo const& info, size_t metricIndex,
+                                       MetricResolution resolution, std::vector<MetricBucket>& result)
+{
+  auto ri = (size_t)resolution;
+  auto const& buckets = info.history[metricIndex].buckets[ri];
+  auto pos = info.history[metricIndex].pos[ri];
+  // Until the buffer wraps around, the oldest bucket is the first one.
+  auto first = buckets.size() < MetricHistory::CAPACITY[ri] ? 0 : pos % buckets.size();
+  for (size_t bi = 0; bi < buckets.size(); ++bi) {
+    result.push_back(buckets[(first + bi) % buckets.size()]);
+  }
+  return buckets.size();
+}
+
 } // namespace o2::framework
@@ -1128,7 +1128,16 @@ void DeviceSpecHelpers::dataProcessorSpecs2DeviceSpecs(const WorkflowSpec& workf
   // them before assigning to a device.
   std::vector<OutputSpec> outputs;
 
-  WorkflowHelpers::constructGraph(workflow, logicalEdges, outputs, availableForwardsInfo);
+  // The driver and every one of its devices go through here with the same
+  // workflow. When a cache is available, only the first one does the matching.
+  char const* graphCacheDir = getenv("DPL_WORKFLOW_GRAPH_CACHE");
+  if (graphCacheDir && *graphCacheDir) {
+    auto graphStart = uv_hrtime();
+    bool cached = WorkflowHelpers::constructGraphCached(workflow, graphCacheDir, logicalEdges, outputs, availableForwardsInfo);
+    LOGP(detail, "Workflow graph of {} edges {} in {} ms", logicalEdges.size(), cached ? "loaded from cache" : "constructed", (uv_hrtime() - graphStart) / 1000000);
+  } else {
+    WorkflowHelpers::constructGraph(workflow, logicalEdges, outputs, availableForwardsInfo);
+  }
 
   // We need to instanciate one device per (me, timeIndex) in the
   // DeviceConnectionEdge. For each device we need one new binding
@@ -1557,6 +1566,8 @@ void DeviceSpecHelpers::prepareArguments(bool defaultQuiet, bool defaultStopped,
         realOdesc.add_options()("shmid", bpo::value<std::string>());
         realOdesc.add_options()("shm-metadata-msg-size", bpo::value<std::string>()->default_value("0"));
         realOdesc.add_options()("shm-monitor", bpo::value<std::string>());
+        realOdesc.add_options()("output-buffer-pool-size", bpo::value<std::string>());
+        realOdesc.add_options()("output-buffer-pool-numa-node", bpo::value<std::string>());
         realOdesc.add_options()("channel-prefix", bpo::value<std::string>());
         realOdesc.add_options()("network-interface", bpo::value<std::string>());
         realOdesc.add_options()("early-forward-policy", bpo::value<std::string>());
@@ -1742,6 +1753,8 @@ boost::program_options::options_description DeviceSpecHelpers::getForwardedDevic
     ("shm-no-cleanup", bpo::value<std::string>()->default_value("false"), "no shm cleanup")                                                                          //
     ("shmid", bpo::value<std::string>(), "shmid")                                                                                                                    //
     ("shm-metadata-msg-size", bpo::value<std::string>()->default_value("0"), "numeric value in B used for padding FairMQ header, see FairMQ v.1.6.0")                //
+    ("output-buffer-pool-size", bpo::value<std::string>(), "size in MB of the pool recycling the output message buffers, one per transport (0 disables)")            //
+    ("output-buffer-pool-numa-node", bpo::value<std::string>(), "NUMA node for the output buffer pools (-1 lets the kernel decide)")                                  //
     ("environment", bpo::value<std::string>(), "comma separated list of environment variables to set for the device")                                                //
     ("stacktrace-on-signal", bpo::value<std::string>()->default_value("simple"),                                                                                     //
      "dump stacktrace on specified signal(s) (any of `all`, `segv`, `bus`, `ill`, `abrt`, `fpe`, `sys`.)"                                                            //
@@ -1758,7 +1771,8 @@ boost::program_options::options_description DeviceSpecHelpers::getForwardedDevic
     ("infologger-severity", bpo::value<std::string>(), "minimun FairLogger severity which goes to info logger")                                                      //
     ("dpl-tracing-flags", bpo::value<std::string>(), "pipe separated list of events to trace")                                                                       //
     ("signposts", bpo::value<std::string>()->default_value(defaultSignposts),                                                                                        //
-     "comma separated list of signposts to enable (any of `completion`, `data_processor_context`, `stream_context`, `device`, `monitoring_service`)")                //
+     "comma separated list of signposts to enable (any of `completion`, `data_processor_context`, `stream_context`, `device`, `monitoring_service`), "              //
+     "<name>:trace records them in dpl-trace.json")                                                                                                                  //
     ("child-driver", bpo::value<std::string>(), "external driver to start childs with (e.g. valgrind)");                                                             //
 
   return forwardedDeviceOptions;
@@ -21,6 +21,8 @@
 #include <fairmq/Message.h>
 #include <fairmq/TransportFactory.h>
 
+#include <algorithm>
+#include <iterator>
 #include <unordered_set>
 
 namespace o2::framework
@@ -210,9 +212,37 @@ std::unique_ptr<fair::mq::Message> FairMQDeviceProxy::createOutputMessage(RouteI
 
 std::unique_ptr<fair::mq::Message> FairMQDeviceProxy::createOutputMessage(RouteIndex routeIndex, const size_t size) const
 {
+  if (routeIndex.value < (int)mOutputRouteBufferPools.size()) {
+    return mOutputBufferPools[mOutputRouteBufferPools[routeIndex.value]]->createMessage(size);
+  }
   return getOutputTransport(routeIndex)->CreateMessage(size, fair::mq::Alignment{64});
 }
 
+void FairMQDeviceProxy::setOutputBufferPool(size_t bytesPerTransport, int numaNode)
+{
+  mOutputBufferPoolSize = bytesPerTransport;
+  mOutputBufferPoolNumaNode = numaNode;
+}
+
+bool FairMQDeviceProxy::getOutputBufferPoolStats(MessageBufferPool::Stats& stats) const
+{
+  if (mOutputBufferPools.empty()) {
+    return false;
+  }
+  stats = {};
+  for (auto& pool : mOutputBufferPools) {
+    auto poolStats = pool->stats();
+    stats.hits += poolStats.hits;
+    stats.misses += poolStats.misses;
+    stats.fallbacks += poolStats.fallbacks;
+    stats.capacity += poolStats.capacity;
+    stats.carved += poolStats.carved;
+    stats.inUse += poolStats.inUse;
+    stats.idle += poolStats.idle;
+  }
+  return true;
+}
+
 std::unique_ptr<fair::mq::Message> FairMQDeviceProxy::createInputMessage(RouteIndex routeIndex) const
 {
   return getInputTransport(routeIndex)->CreateMessage(fair::mq::Alignment{64});
@@ -291,6 +321,20 @@ void FairMQDeviceProxy::bind(std::vector<OutputRoute> const& outputs, std::vecto
     assert(mOutputRoutes.size() == outputs.size());
   }
 
+  if (mOutputBufferPoolSize > 0) {
+    // All the routes using the same transport share its pool. The pools are kept
+    // across binds, since the consumers might still hold messages from their regions.
+    mOutputRouteBufferPools.resize(mOutputRoutes.size());
+    for (size_t ri = 0; ri < mOutputRoutes.size(); ++ri) {
+      auto* transport = getOutputTransport(RouteIndex{(int)ri});
+      auto pool = std::find_if(mOutputBufferPools.begin(), mOutputBufferPools.end(), [transport](auto const& p) { return p->transport() == transport; });
+      if (pool == mOutputBufferPools.end()) {
+        pool = mOutputBufferPools.insert(pool, std::make_unique<MessageBufferPool>(transport, mOutputBufferPoolSize, mOutputBufferPoolNumaNode));
+      }
+      mOutputRouteBufferPools[ri] = std::distance(mOutputBufferPools.begin(), pool);
+    }
+  }
+
   {
     auto maxLanes = InputRouteHelpers::maxLanes(inputs);
     mInputs = inputs;
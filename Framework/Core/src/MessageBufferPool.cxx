@@ -0,0 +1,215 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+#include "Framework/MessageBufferPool.h"
+#include "Framework/Logger.h"
+
+#include <fairmq/Message.h>
+#include <fairmq/TransportFactory.h>
+#include <fairmq/UnmanagedRegion.h>
+
+#include <bit>
+#include <cerrno>
+#include <cstring>
+#include <iterator>
+
+#ifdef __linux__
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+namespace o2::framework
+{
+
+namespace
+{
+/// Prefer the pages of the given range on @a node. This is done with the bare
+/// system call, to avoid a dependency on libnuma. Pages which were already
+/// touched are moved.
+void bindToNumaNode(void* ptr, size_t size, int node)
+{
+#if defined(__linux__) && defined(SYS_mbind)
+  constexpr int MPOL_PREFERRED_MODE = 1;
+  constexpr unsigned MPOL_MF_MOVE_FLAG = 1 << 1;
+  constexpr size_t maskBits = 8 * sizeof(unsigned long);
+  if (node >= (int)(maskBits * 16)) {
+    LOGP(warn, "NUMA node {} out of range, not binding the output buffer pool", node);
+    return;
+  }
+  unsigned long mask[16] = {0};
+  mask[node / maskBits] = 1ul << (node % maskBits);
+  auto pageSize = (uintptr_t)sysconf(_SC_PAGESIZE);
+  auto begin = reinterpret_cast<uintptr_t>(ptr) & ~(pageSize - 1);
+  auto end = reinterpret_cast<uintptr_t>(ptr) + size;
+  if (syscall(SYS_mbind, begin, end - begin, MPOL_PREFERRED_MODE, mask, maskBits * 16, MPOL_MF_MOVE_FLAG) != 0) {
+    LOGP(warn, "Unable to bind the output buffer pool to NUMA node {}: {}", node, strerror(errno));
+  }
+#else
+  LOGP(warn, "NUMA placement of the output buffer pool not supported on this platform");
+#endif
+}
+} // namespace
+
+MessageBufferPool::MessageBufferPool(fair::mq::TransportFactory* transport, size_t capacity, int numaNode)
+  : mTransport{transport},
+    mCapacity{capacity},
+    mNumaNode{numaNode}
+{
+  mStats.capacity = capacity;
+}
+
+MessageBufferPool::~MessageBufferPool()
+{
+  // The region might still invoke the callback for the pending messages,
+  // so it has to go before the free lists and their mutex.
+  mRegion.reset();
+}
+
+size_t MessageBufferPool::sizeClass(size_t size)
+{
+  if (size < MinPooledSize) {
+    return size;
+  }
+  size_t step = std::bit_floor(size) / 8;
+  return (size + step - 1) & ~(step - 1);
+}
+
+bool MessageBufferPool::createRegion()
+{
+  fair::mq::RegionConfig cfg;
+  cfg.lock = false;
+  cfg.zero = false;
+  try {
+    mRegion = mTransport->CreateUnmanagedRegion(
+      mCapacity, fair::mq::RegionBulkCallback{[this](std::vector<fair::mq::RegionBlock> const& blocks) {
+        for (auto const& block : blocks) {
+          release(static_cast<char*>(block.ptr), reinterpret_cast<size_t>(block.hint));
+        }
+      }},
+      cfg);
+  } catch (std::exception& e) {
+    LOGP(warn, "Unable to create output buffer pool of {} bytes, using plain messages: {}", mCapacity, e.what());
+    mRegionFailed = true;
+    return false;
+  }
+  mRegionData = static_cast<char*>(mRegion->GetData());
+  mFreeSpace.emplace(0, mCapacity);
+  if (mNumaNode >= 0) {
+    bindToNumaNode(mRegion->GetData(), mRegion->GetSize(), mNumaNode);
+  }
+  LOGP(detail, "Created output buffer pool of {} bytes", mCapacity);
+  return true;
+}
+
+int64_t MessageBufferPool::carve(size_t size)
+{
+  for (auto it = mFreeSpace.begin(); it != mFreeSpace.end(); ++it) {
+    if (it->second < size) {
+      continue;
+    }
+    auto [offset, free] = *it;
+    mFreeSpace.erase(it);
+    if (free > size) {
+      mFreeSpace.emplace(offset + size, free - size);
+    }
+    mStats.carved += size;
+    return offset;
+  }
+  return -1;
+}
+
+void MessageBufferPool::uncarve(size_t offset, size_t size)
+{
+  mStats.carved -= size;
+  auto next = mFreeSpace.lower_bound(offset);
+  if (next != mFreeSpace.end() && offset + size == next->first) {
+    size += next->second;
+    next = mFreeSpace.erase(next);
+  }
+  if (next != mFreeSpace.begin()) {
+    auto prev = std::prev(next);
+    if (prev->first + prev->second == offset) {
+      prev->second += size;
+      return;
+    }
+  }
+  mFreeSpace.emplace(offset, size);
+}
+
+std::unique_ptr<fair::mq::Message> MessageBufferPool::createMessage(size_t size)
+{
+  if (size < MinPooledSize || size > mCapacity) {
+    return mTransport->CreateMessage(size, fair::mq::Alignment{64});
+  }
+  auto bufferSize = sizeClass(size);
+  int64_t offset = -1;
+  {
+    std::lock_guard<std::mutex> lock(mMutex);
+    if (!mRegion && (mRegionFailed || !createRegion())) {
+      return mTransport->CreateMessage(size, fair::mq::Alignment{64});
+    }
+    // The smallest idle buffer which is large enough
+    auto idle = mFreeBuffers.lower_bound(bufferSize);
+    if (idle != mFreeBuffers.end()) {
+      bufferSize = idle->first;
+      offset = idle->second.back();
+      idle->second.pop_back();
+      if (idle->second.empty()) {
+        mFreeBuffers.erase(idle);
+      }
+      mStats.idle -= bufferSize;
+      mStats.hits++;
+    } else {
+      offset = carve(bufferSize);
+      if (offset < 0 && mStats.idle > 0) {
+        // The region is full of idle buffers of other classes: give them back
+        // to the free space, where they merge with their free neighbours.
+        for (auto& [idleSize, offsets] : mFreeBuffers) {
+          for (auto idleOffset : offsets) {
+            uncarve(idleOffset, idleSize);
+          }
+        }
+        mFreeBuffers.clear();
+        mStats.idle = 0;
+        offset = carve(bufferSize);
+      }
+      if (offset >= 0) {
+        mStats.misses++;
+      }
+    }
+    if (offset < 0) {
+      mStats.fallbacks++;
+    } else {
+      mStats.inUse += bufferSize;
+    }
+  }
+  if (offset < 0) {
+    return mTransport->CreateMessage(size, fair::mq::Alignment{64});
+  }
+  // The size class travels as hint, since the released block only knows the used size.
+  return mTransport->CreateMessage(mRegion, mRegionData + offset, size, reinterpret_cast<void*>(bufferSize));
+}
+
+void MessageBufferPool::release(char* buffer, size_t bufferSize)
+{
+  std::lock_guard<std::mutex> lock(mMutex);
+  mFreeBuffers[bufferSize].push_back(buffer - mRegionData);
+  mStats.inUse -= bufferSize;
+  mStats.idle += bufferSize;
+}
+
+MessageBufferPool::Stats MessageBufferPool::stats() const
+{
+  std::lock_guard<std::mutex> lock(mMutex);
+  return mStats;
+}
+
+} // namespace o2::framework
@@ -19,8 +19,7 @@ namespace o2::framework
 
 fair::mq::MessagePtr MessageContext::createMessage(RouteIndex routeIndex, int index, size_t size)
 {
-  auto* transport = mProxy.getOutputTransport(routeIndex);
-  return transport->CreateMessage(size, fair::mq::Alignment{64});
+  return mProxy.createOutputMessage(routeIndex, size);
 }
 
 fair::mq::MessagePtr MessageContext::createMessage(RouteIndex routeIndex, int index, void* data, size_t size, fair::mq::FreeFn* ffn, void* hint)
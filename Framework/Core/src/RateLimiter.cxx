@@ -25,14 +25,26 @@
 
 using namespace o2::framework;
 
-int RateLimiter::check(ProcessingContext& ctx, int maxInFlight, size_t minSHM)
+int RateLimiter::check(ProcessingContext& ctx, int maxInFlight, size_t minSHM, size_t timeframeSize)
 {
   if (!maxInFlight && !minSHM) {
     return 0;
   }
   auto device = ctx.services().get<RawDeviceService>().device();
   auto& deviceState = ctx.services().get<DeviceState>();
+  static bool adaptive = getenv("DPL_ADAPTIVE_RATE_LIMITING") && atoi(getenv("DPL_ADAPTIVE_RATE_LIMITING"));
+  // The model learns from the feedback of the consumed timeframes, so it cannot work without.
+  bool useModel = adaptive && maxInFlight && device->GetChannels().count("metric-feedback");
+  size_t size = timeframeSize ? timeframeSize : 1;
   if (maxInFlight && device->GetChannels().count("metric-feedback")) {
+    if (useModel) {
+      // Keep track of the completions also when not blocked, the model needs them all.
+      auto msg = device->NewMessageFor("metric-feedback", 0, 0);
+      while (device->Receive(msg, "metric-feedback", 0, 0) > 0) {
+        mConsumedTimeframes = *(int64_t*)msg->GetData();
+      }
+      mCostModel.consumed(mConsumedTimeframes, uv_hrtime());
+    }
     auto& dtc = ctx.services().get<DataTakingContext>();
     const auto& device = ctx.services().get<RawDeviceService>().device();
     const auto& deviceContext = ctx.services().get<DeviceContext>();
@@ -67,6 +79,9 @@ int RateLimiter::check(ProcessingContext& ctx, int maxInFlight, size_t minSHM)
       }
       assert(msg->GetSize() == 8);
       mConsumedTimeframes = *(int64_t*)msg->GetData();
+      if (useModel) {
+        mCostModel.consumed(mConsumedTimeframes, uv_hrtime());
+      }
     }
     if (waitMessage) {
       if (dtc.deploymentMode == DeploymentMode::OnlineDDS || dtc.deploymentMode == DeploymentMode::OnlineECS || dtc.deploymentMode == DeploymentMode::FST) {
@@ -77,7 +92,17 @@ int RateLimiter::check(ProcessingContext& ctx, int maxInFlight, size_t minSHM)
     }
 
     bool doSmothThrottling = getenv("DPL_SMOOTH_RATE_LIMITING") && atoi(getenv("DPL_SMOOTH_RATE_LIMITING"));
-    if (doSmothThrottling) {
+    if (useModel) {
+      // Feed the chain at the rate it drains timeframes of this size, rather
+      // than filling it up and stalling until the oldest one is done.
+      auto delay = mCostModel.pacing(size, maxInFlight);
+      auto elapsed = uv_hrtime() - mLastInjection;
+      LOGP(debug, "TF cost model: latency {:.1f} ms, memory {} bytes, pacing {:.1f} ms", mCostModel.latency(size) / 1e6, (size_t)mCostModel.memory(size), delay / 1e6);
+      if (mLastInjection && elapsed < delay) {
+        uv_run(deviceState.loop, UV_RUN_NOWAIT);
+        std::this_thread::sleep_for(std::chrono::nanoseconds(delay - elapsed));
+      }
+    } else if (doSmothThrottling) {
       constexpr float factorStart = 0.7f;
       constexpr float factorFinal = 0.98f;
       constexpr float factorOfAverage = 0.7f;
@@ -144,9 +169,18 @@ int RateLimiter::check(ProcessingContext& ctx, int maxInFlight, size_t minSHM)
         throw std::runtime_error("Could not obtain free SHM memory");
       }
       uint64_t freeSHM = freeMemory;
-      if (freeSHM > minSHM) {
+      // What the next timeframe is going to take comes on top of the minimum.
+      // With nothing in flight, there is nothing to wait for.
+      uint64_t requiredSHM = minSHM;
+      if (useModel && mCostModel.inFlight()) {
+        if (waitMessage == 0) {
+          mCostModel.memorySample(freeSHM);
+        }
+        requiredSHM += mCostModel.memory(size);
+      }
+      if (freeSHM > requiredSHM) {
         if (waitMessage) {
-          LOG(important) << "Sufficient SHM memory free (" << freeSHM << " >= " << minSHM << "), continuing to publish";
+          LOG(important) << "Sufficient SHM memory free (" << freeSHM << " >= " << requiredSHM << "), continuing to publish";
         }
         static bool showReport = getenv("DPL_REPORT_PROCESSING") && atoi(getenv("DPL_REPORT_PROCESSING"));
         if (showReport) {
@@ -155,12 +189,25 @@ int RateLimiter::check(ProcessingContext& ctx, int maxInFlight, size_t minSHM)
         break;
       }
       if (waitMessage == 0) {
-        LOG(alarm) << "Free SHM memory too low: " << freeSHM << " < " << minSHM << ", waiting";
+        LOG(alarm) << "Free SHM memory too low: " << freeSHM << " < " << requiredSHM << ", waiting";
         waitMessage = 1;
       }
       usleep(30000);
+      if (useModel) {
+        // The timeframes completed meanwhile release their share of the memory
+        // the model expects the next one to take.
+        auto msg = device->NewMessageFor("metric-feedback", 0, 0);
+        while (device->Receive(msg, "metric-feedback", 0, 0) > 0) {
+          mConsumedTimeframes = *(int64_t*)msg->GetData();
+        }
+        mCostModel.consumed(mConsumedTimeframes, uv_hrtime());
+      }
     }
   }
+  if (useModel) {
+    mLastInjection = uv_hrtime();
+    mCostModel.injected(mSentTimeframes, size, mLastInjection);
+  }
   mSentTimeframes++;
   return 0;
 }
@@ -11,6 +11,12 @@
 
 #include "ResourcesMonitoringHelper.h"
 #include "Framework/DeviceMetricsInfo.h"
+#include "Framework/DeviceMetricsHelper.h"
+#include "Framework/Logger.h"
+#include <arrow/builder.h>
+#include <arrow/io/file.h>
+#include <arrow/ipc/writer.h>
+#include <arrow/table.h>
 #define BOOST_BIND_GLOBAL_PLACEHOLDERS
 #include <boost/property_tree/json_parser.hpp>
 #include <fstream>
@@ -172,3 +178,101 @@ bool ResourcesMonitoringHelper::dumpMetricsToJSON(const std::vector<DeviceMetric
 
   return true;
 }
+
+namespace
+{
+struct HistoryColumns {
+  arrow::StringBuilder device;
+  arrow::StringBuilder metric;
+  arrow::UInt32Builder resolution;
+  arrow::UInt64Builder start;
+  arrow::FloatBuilder min;
+  arrow::FloatBuilder max;
+  arrow::FloatBuilder average;
+  arrow::UInt32Builder count;
+};
+
+arrow::Status appendHistory(HistoryColumns& columns, std::string const& device, DeviceMetricsInfo const& info,
+                            std::vector<std::regex> const& metricsToDump)
+{
+  std::vector<MetricBucket> buckets;
+  for (size_t mi = 0; mi < info.metricLabels.size(); mi++) {
+    std::string_view metricLabel{info.metricLabels[mi].label, info.metricLabels[mi].size};
+    auto same = [metricLabel](std::regex const& matcher) -> bool {
+      return std::regex_match(metricLabel.begin(), metricLabel.end(), matcher);
+    };
+    if (std::find_if(std::begin(metricsToDump), std::end(metricsToDump), same) == metricsToDump.end()) {
+      continue;
+    }
+    for (size_t ri = 0; ri < MetricHistory::RESOLUTIONS; ++ri) {
+      buckets.clear();
+      DeviceMetricsHelper::getHistory(info, mi, (MetricResolution)ri, buckets);
+      auto width = MetricHistory::BUCKET_WIDTH[ri];
+      for (auto& bucket : buckets) {
+        ARROW_RETURN_NOT_OK(columns.device.Append(device));
+        ARROW_RETURN_NOT_OK(columns.metric.Append(metricLabel.data(), metricLabel.size()));
+        ARROW_RETURN_NOT_OK(columns.resolution.Append(width));
+        ARROW_RETURN_NOT_OK(columns.start.Append((uint64_t)bucket.index * width));
+        ARROW_RETURN_NOT_OK(columns.min.Append(bucket.min));
+        ARROW_RETURN_NOT_OK(columns.max.Append(bucket.max));
+        ARROW_RETURN_NOT_OK(columns.average.Append(bucket.average()));
+        ARROW_RETURN_NOT_OK(columns.count.Append(bucket.count));
+      }
+    }
+  }
+  return arrow::Status::OK();
+}
+
+arrow::Status writeHistory(std::vector<DeviceMetricsInfo> const& metrics,
+                           DeviceMetricsInfo const& driverMetrics,
+                           std::vector<DeviceSpec> const& specs,
+                           std::vector<std::regex> const& metricsToDump,
+                           char const* filename)
+{
+  HistoryColumns columns;
+  for (size_t di = 0; di < metrics.size(); ++di) {
+    ARROW_RETURN_NOT_OK(appendHistory(columns, specs[di].id, metrics[di], metricsToDump));
+  }
+  ARROW_RETURN_NOT_OK(appendHistory(columns, "driver", driverMetrics, metricsToDump));
+
+  auto schema = arrow::schema({arrow::field("device", arrow::utf8()),
+                               arrow::field("metric", arrow::utf8()),
+                               arrow::field("resolution_ms", arrow::uint32()),
+                               arrow::field("start_ms", arrow::uint64()),
+                               arrow::field("min", arrow::float32()),
+                               arrow::field("max", arrow::float32()),
+                               arrow::field("average", arrow::float32()),
+                               arrow::field("count", arrow::uint32())});
+  std::vector<std::shared_ptr<arrow::Array>> arrays(schema->num_fields());
+  ARROW_RETURN_NOT_OK(columns.device.Finish(&arrays[0]));
+  ARROW_RETURN_NOT_OK(columns.metric.Finish(&arrays[1]));
+  ARROW_RETURN_NOT_OK(columns.resolution.Finish(&arrays[2]));
+  ARROW_RETURN_NOT_OK(columns.start.Finish(&arrays[3]));
+  ARROW_RETURN_NOT_OK(columns.min.Finish(&arrays[4]));
+  ARROW_RETURN_NOT_OK(columns.max.Finish(&arrays[5]));
+  ARROW_RETURN_NOT_OK(columns.average.Finish(&arrays[6]));
+  ARROW_RETURN_NOT_OK(columns.count.Finish(&arrays[7]));
+  auto table = arrow::Table::Make(schema, arrays);
+
+  ARROW_ASSIGN_OR_RAISE(auto file, arrow::io::FileOutputStream::Open(filename));
+  ARROW_ASSIGN_OR_RAISE(auto writer, arrow::ipc::MakeFileWriter(file, schema));
+  ARROW_RETURN_NOT_OK(writer->WriteTable(*table));
+  ARROW_RETURN_NOT_OK(writer->Close());
+  return file->Close();
+}
+} // namespace
+
+bool ResourcesMonitoringHelper::dumpMetricsHistoryToArrow(std::vector<DeviceMetricsInfo> const& metrics,
+                                                          DeviceMetricsInfo const& driverMetrics,
+                                                          std::vector<DeviceSpec> const& specs,
+                                                          std::vector<std::regex> const& metricsToDump,
+                                                          char const* filename) noexcept
+{
+  assert(metrics.size() == specs.size());
+  auto status = writeHistory(metrics, driverMetrics, specs, metricsToDump, filename);
+  if (!status.ok()) {
+    LOGP(error, "Unable to dump the metrics history to {}: {}", filename, status.ToString());
+    return false;
+  }
+  return true;
+}
@@ -30,6 +30,14 @@ struct ResourcesMonitoringHelper {
                                 DeviceMetricsInfo const& driverMetrics,
                                 std::vector<DeviceSpec> const& specs,
                                 std::vector<std::regex> const& metricsToDump) noexcept;
+  /// Dump the downsampled history of the metrics in @a metrics which match the
+  /// names specified in @a metricsToDump to the Arrow IPC file @a filename,
+  /// with one row per bucket, for offline analysis.
+  static bool dumpMetricsHistoryToArrow(std::vector<DeviceMetricsInfo> const& metrics,
+                                        DeviceMetricsInfo const& driverMetrics,
+                                        std::vector<DeviceSpec> const& specs,
+                                        std::vector<std::regex> const& metricsToDump,
+                                        char const* filename) noexcept;
   static bool isResourcesMonitoringEnabled(unsigned short interval) noexcept { return interval > 0; }
 };
 
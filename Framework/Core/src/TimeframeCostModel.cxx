@@ -0,0 +1,104 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+#include "Framework/TimeframeCostModel.h"
+#include <algorithm>
+
+namespace o2::framework
+{
+
+TimeframeCostModel::TimeframeCostModel(double decay)
+  : mDecay{decay}
+{
+}
+
+void TimeframeCostModel::Fit::add(double sx, double sy, double decay)
+{
+  // Until the history is long enough, use the plain average.
+  double keep = samples * decay >= 1. ? 1. - decay : 1.;
+  w = w * keep + 1.;
+  x = x * keep + sx;
+  y = y * keep + sy;
+  xx = xx * keep + sx * sx;
+  xy = xy * keep + sx * sy;
+  samples++;
+}
+
+double TimeframeCostModel::Fit::slope() const
+{
+  if (w == 0) {
+    return 0;
+  }
+  double varX = xx / w - (x / w) * (x / w);
+  // All the samples at the same x: nothing to say about the dependency.
+  if (varX <= 1e-9 * std::max(1., xx / w)) {
+    return 0;
+  }
+  return (xy / w - (x / w) * (y / w)) / varX;
+}
+
+double TimeframeCostModel::Fit::predict(double sx) const
+{
+  if (w == 0) {
+    return 0;
+  }
+  return y / w + slope() * (sx - x / w);
+}
+
+void TimeframeCostModel::injected(int64_t timeslice, size_t size, uint64_t now)
+{
+  mInFlight.push_back(InFlight{timeslice, size, now});
+  mInFlightSize += size;
+}
+
+void TimeframeCostModel::consumed(int64_t oldestPossible, uint64_t now)
+{
+  while (!mInFlight.empty() && mInFlight.front().timeslice < oldestPossible) {
+    auto& done = mInFlight.front();
+    mLatencyFit.add(done.size, now - done.injected, mDecay);
+    mInFlightSize -= done.size;
+    mInFlight.pop_front();
+  }
+}
+
+void TimeframeCostModel::memorySample(size_t freeMemory)
+{
+  // The memory used grows with the data in flight, i.e. the free memory goes down.
+  mMemoryFit.add(mInFlightSize, -(double)freeMemory, mDecay);
+  // The most free memory seen is the best guess of what is free with an empty chain.
+  mMaxFreeMemory = std::max(mMaxFreeMemory, freeMemory);
+  mMaxUsedMemory = std::max(mMaxUsedMemory, mMaxFreeMemory - freeMemory);
+}
+
+double TimeframeCostModel::latency(size_t size) const
+{
+  return std::max(0., mLatencyFit.predict(size));
+}
+
+double TimeframeCostModel::memory(size_t size) const
+{
+  // A few samples at similar sizes can give any slope, do not block on them.
+  if (mMemoryFit.samples < MinSamples) {
+    return 0;
+  }
+  // A single timeframe never takes more than what was seen in flight at once.
+  return std::clamp(mMemoryFit.slope() * size, 0., (double)mMaxUsedMemory);
+}
+
+uint64_t TimeframeCostModel::pacing(size_t size, int maxInFlight) const
+{
+  if (!ready() || maxInFlight <= 0) {
+    return 0;
+  }
+  return latency(size) / maxInFlight;
+}
+
+} // namespace o2::framework
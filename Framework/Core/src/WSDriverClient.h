@@ -42,6 +42,8 @@ class WSDriverClient : public DriverClient
   ~WSDriverClient();
   void tell(const char* msg, size_t s, bool flush = true) final;
   void flushPending(ServiceRegistryRef mainThreadRef) final;
+  /// Every message is a separate websocket frame, so binary metrics are fine.
+  [[nodiscard]] bool acceptsBinaryMetrics() const final { return true; }
   void setDPLClient(std::unique_ptr<WSDPLClient>);
   void setConnection(uv_connect_t* connection) { mConnection = connection; };
   // Initiate a websocket session
@@ -32,11 +32,14 @@
 #include "Framework/Variant.h"
 #include "Headers/DataHeader.h"
 #include <algorithm>
+#include <cstdio>
+#include <fstream>
 #include <list>
 #include <set>
 #include <utility>
 #include <vector>
 #include <climits>
+#include <unistd.h>
 
 O2_DECLARE_DYNAMIC_LOG(workflow_helpers);
 
@@ -154,6 +157,103 @@ int defaultConditionQueryRateMultiplier()
   return getenv("DPL_CONDITION_QUERY_RATE_MULTIPLIER") ? std::stoi(getenv("DPL_CONDITION_QUERY_RATE_MULTIPLIER")) : 1;
 }
 
+namespace
+{
+// Whether @a from consumes, directly or through other data processors, something produced by @a to.
+bool dependsOn(WorkflowSpec const& workflow, size_t from, size_t to)
+{
+  std::vector<bool> visited(workflow.size(), false);
+  std::vector<size_t> pending{from};
+  visited[from] = true;
+  while (!pending.empty()) {
+    auto& consumer = workflow[pending.back()];
+    pending.pop_back();
+    for (size_t wi = 0; wi < workflow.size(); ++wi) {
+      if (visited[wi]) {
+        continue;
+      }
+      auto& producer = workflow[wi];
+      auto feeds = std::any_of(consumer.inputs.begin(), consumer.inputs.end(), [&producer](InputSpec const& input) {
+        return std::any_of(producer.outputs.begin(), producer.outputs.end(), [&input](OutputSpec const& output) { return DataSpecUtils::match(input, output); });
+      });
+      if (!feeds) {
+        continue;
+      }
+      if (wi == to) {
+        return true;
+      }
+      visited[wi] = true;
+      pending.push_back(wi);
+    }
+  }
+  return false;
+}
+
+bool isDerivedTable(OutputSpec const& output)
+{
+  return DataSpecUtils::partialMatch(output, header::DataOrigin{"DYN"}) || DataSpecUtils::partialMatch(output, header::DataOrigin{"IDX"});
+}
+} // namespace
+
+void WorkflowHelpers::shareDerivedTables(WorkflowSpec& workflow)
+{
+  // The data processors declaring each derived table, in workflow order
+  std::vector<std::pair<ConcreteDataMatcher, std::vector<size_t>>> declarers;
+  for (size_t wi = 0; wi < workflow.size(); ++wi) {
+    for (auto& output : workflow[wi].outputs) {
+      if (!isDerivedTable(output)) {
+        continue;
+      }
+      auto concrete = DataSpecUtils::asConcreteDataMatcher(output);
+      auto declared = std::find_if(declarers.begin(), declarers.end(), [&concrete](auto const& x) { return x.first == concrete; });
+      if (declared == declarers.end()) {
+        declarers.emplace_back(concrete, std::vector<size_t>{wi});
+      } else {
+        declared->second.push_back(wi);
+      }
+    }
+  }
+
+  auto receive = [&workflow](size_t wi, ConcreteDataMatcher const& concrete, std::vector<ConfigParamSpec> const& sources) {
+    auto& processor = workflow[wi];
+    auto output = std::find_if(processor.outputs.begin(), processor.outputs.end(), [&concrete](OutputSpec const& o) { return DataSpecUtils::match(o, concrete); });
+    InputSpec input{output->binding.value, concrete.origin, concrete.description, concrete.subSpec};
+    input.metadata = sources;
+    processor.outputs.erase(output);
+    DataSpecUtils::updateInputList(processor.inputs, std::move(input));
+  };
+
+  for (auto& [concrete, tasks] : declarers) {
+    if (tasks.size() < 2) {
+      continue;
+    }
+    auto what = DataSpecUtils::describe(OutputSpec{concrete});
+    // The tables the spawner or the index builder knows are produced there,
+    // once, upstream of all the tasks which declare them.
+    std::vector<ConfigParamSpec> sources;
+    if (readers::AODReaderHelpers::derivedTableSources(concrete, sources)) {
+      for (auto wi : tasks) {
+        LOGP(info, "{} is declared by several tasks, {} will get it from the {}", what, workflow[wi].name, concrete.origin == header::DataOrigin{"DYN"} ? "spawner" : "index builder");
+        receive(wi, concrete, sources);
+      }
+      continue;
+    }
+    // Tables defined by the analysis itself can only be made by the tasks:
+    // the first one declaring it provides it to the others, unless it
+    // depends on them.
+    auto& provider = workflow[tasks[0]];
+    for (size_t ti = 1; ti < tasks.size(); ++ti) {
+      auto& processor = workflow[tasks[ti]];
+      if (dependsOn(workflow, tasks[0], tasks[ti])) {
+        throw runtime_error_f("%s and %s both produce %s and the former depends on the latter. Please create it in only one of them.",
+                              provider.name.c_str(), processor.name.c_str(), what.c_str());
+      }
+      LOGP(info, "{} is already produced by {}, {} will reuse it", what, provider.name, processor.name);
+      receive(tasks[ti], concrete, {});
+    }
+  }
+}
+
 void WorkflowHelpers::injectServiceDevices(WorkflowSpec& workflow, ConfigContext& ctx)
 {
   auto fakeCallback = AlgorithmSpec{[](InitContext& ic) {
@@ -245,6 +345,8 @@ void WorkflowHelpers::injectServiceDevices(WorkflowSpec& workflow, ConfigContext
   ctx.services().registerService(ServiceRegistryHelpers::handleForService<AnalysisContext>(new AnalysisContext));
   auto& ac = ctx.services().get<AnalysisContext>();
 
+  shareDerivedTables(workflow);
+
   std::vector<InputSpec> requestedCCDBs;
   std::vector<OutputSpec> providedCCDBs;
 
@@ -366,6 +468,8 @@ void WorkflowHelpers::injectServiceDevices(WorkflowSpec& workflow, ConfigContext
         ac.providedAODs.emplace_back(output);
       } else if (DataSpecUtils::partialMatch(output, header::DataOrigin{"DYN"})) {
         ac.providedDYNs.emplace_back(output);
+      } else if (DataSpecUtils::partialMatch(output, header::DataOrigin{"IDX"})) {
+        ac.providedIDXs.emplace_back(output);
       } else if (DataSpecUtils::partialMatch(output, header::DataOrigin{"ATSK"})) {
         ac.providedOutputObjHist.emplace_back(output);
         auto it = std::find_if(ac.outObjHistMap.begin(), ac.outObjHistMap.end(), [&](auto&& x) { return x.id == hash; });
@@ -390,6 +494,11 @@ void WorkflowHelpers::injectServiceDevices(WorkflowSpec& workflow, ConfigContext
       ac.spawnerInputs.emplace_back(input);
     }
   }
+  for (auto& input : ac.requestedIDXs) {
+    if (std::none_of(ac.providedIDXs.begin(), ac.providedIDXs.end(), [&input](auto const& x) { return DataSpecUtils::match(input, x); })) {
+      ac.builderInputs.emplace_back(input);
+    }
+  }
 
   DataProcessorSpec aodSpawner{
     "internal-dpl-aod-spawner",
@@ -402,10 +511,10 @@ void WorkflowHelpers::injectServiceDevices(WorkflowSpec& workflow, ConfigContext
     "internal-dpl-aod-index-builder",
     {},
     {},
-    readers::AODReaderHelpers::indexBuilderCallback(ac.requestedIDXs),
+    readers::AODReaderHelpers::indexBuilderCallback(ac.builderInputs),
     {}};
 
-  AnalysisSupportHelpers::addMissingOutputsToBuilder(ac.requestedIDXs, ac.requestedAODs, ac.requestedDYNs, indexBuilder);
+  AnalysisSupportHelpers::addMissingOutputsToBuilder(ac.builderInputs, ac.requestedAODs, ac.requestedDYNs, indexBuilder);
   AnalysisSupportHelpers::addMissingOutputsToSpawner({}, ac.spawnerInputs, ac.requestedAODs, aodSpawner);
 
   AnalysisSupportHelpers::addMissingOutputsToReader(ac.providedAODs, ac.requestedAODs, aodReader);
@@ -862,6 +971,155 @@ void WorkflowHelpers::constructGraph(const WorkflowSpec& workflow,
   }
 }
 
+namespace
+{
+constexpr uint64_t GraphCacheMagic = 0x314850524750443aULL; // ":DPGRPH1"
+
+void hashBytes(uint64_t& hash, char const* data, size_t size)
+{
+  // FNV-1a
+  for (size_t i = 0; i < size; ++i) {
+    hash ^= (unsigned char)data[i];
+    hash *= 0x100000001b3ULL;
+  }
+}
+
+void hashString(uint64_t& hash, std::string const& s)
+{
+  // Includes the terminator, so that the fields cannot be shifted into each other.
+  hashBytes(hash, s.c_str(), s.size() + 1);
+}
+
+void hashSize(uint64_t& hash, uint64_t value)
+{
+  hashBytes(hash, reinterpret_cast<char const*>(&value), sizeof(value));
+}
+
+std::string graphCachePath(std::string const& cacheDir, uint64_t hash)
+{
+  return fmt::format("{}/dpl-graph-{:016x}.bin", cacheDir, hash);
+}
+
+/// Read the edges and the forwards cached for @a hash, checking that they
+/// are consistent with @a workflow and @a outputs. Any problem is a miss.
+bool loadGraph(std::string const& path, uint64_t hash, WorkflowSpec const& workflow,
+               std::vector<OutputSpec> const& outputs,
+               std::vector<DeviceConnectionEdge>& logicalEdges,
+               std::vector<LogicalForwardInfo>& forwardedInputsInfo)
+{
+  std::ifstream in(path, std::ios::binary);
+  if (!in) {
+    return false;
+  }
+  uint64_t header[4];
+  if (!in.read(reinterpret_cast<char*>(header), sizeof(header)) || header[0] != GraphCacheMagic || header[1] != hash) {
+    return false;
+  }
+  std::vector<uint64_t> words(header[2] * 7 + header[3] * 3);
+  if (!in.read(reinterpret_cast<char*>(words.data()), words.size() * sizeof(uint64_t)) || in.peek() != EOF) {
+    return false;
+  }
+  auto validInput = [&workflow](uint64_t consumer, uint64_t input) {
+    return consumer < workflow.size() && input < workflow[consumer].inputs.size();
+  };
+  uint64_t const* w = words.data();
+  for (size_t ei = 0; ei < header[2]; ++ei, w += 7) {
+    DeviceConnectionEdge edge{w[0], w[1], w[2], w[3], w[4], w[5], (w[6] & 0xff) != 0, (ConnectionKind)(w[6] >> 8)};
+    if (edge.producer >= workflow.size() || !validInput(edge.consumer, edge.consumerInputIndex) ||
+        edge.timeIndex >= workflow[edge.consumer].maxInputTimeslices ||
+        edge.producerTimeIndex >= workflow[edge.producer].maxInputTimeslices ||
+        edge.outputGlobalIndex >= outputs.size()) {
+      return false;
+    }
+    logicalEdges.push_back(edge);
+  }
+  for (size_t fi = 0; fi < header[3]; ++fi, w += 3) {
+    LogicalForwardInfo forward{w[0], w[1], w[2]};
+    if (!validInput(forward.consumer, forward.inputLocalIndex) || forward.outputGlobalIndex >= outputs.size()) {
+      return false;
+    }
+    forwardedInputsInfo.push_back(forward);
+  }
+  return true;
+}
+
+void storeGraph(std::string const& path, uint64_t hash,
+                std::vector<DeviceConnectionEdge> const& logicalEdges,
+                std::vector<LogicalForwardInfo> const& forwardedInputsInfo)
+{
+  std::vector<uint64_t> words{GraphCacheMagic, hash, logicalEdges.size(), forwardedInputsInfo.size()};
+  words.reserve(words.size() + logicalEdges.size() * 7 + forwardedInputsInfo.size() * 3);
+  for (auto& edge : logicalEdges) {
+    words.insert(words.end(), {edge.producer, edge.consumer, edge.timeIndex, edge.producerTimeIndex,
+                               edge.outputGlobalIndex, edge.consumerInputIndex, (uint64_t)edge.isForward | ((uint64_t)edge.kind << 8)});
+  }
+  for (auto& forward : forwardedInputsInfo) {
+    words.insert(words.end(), {forward.consumer, forward.inputLocalIndex, forward.outputGlobalIndex});
+  }
+  // Devices of other workflows might be reading the same file, so it is
+  // replaced atomically.
+  auto tmpPath = fmt::format("{}.{}", path, getpid());
+  {
+    std::ofstream out(tmpPath, std::ios::binary | std::ios::trunc);
+    out.write(reinterpret_cast<char const*>(words.data()), words.size() * sizeof(uint64_t));
+    if (!out) {
+      LOGP(warn, "Unable to write the workflow graph cache {}", tmpPath);
+      std::remove(tmpPath.c_str());
+      return;
+    }
+  }
+  if (std::rename(tmpPath.c_str(), path.c_str()) != 0) {
+    LOGP(warn, "Unable to write the workflow graph cache {}", path);
+    std::remove(tmpPath.c_str());
+  }
+}
+} // namespace
+
+uint64_t WorkflowHelpers::graphHash(const WorkflowSpec& workflow)
+{
+  uint64_t hash = 0xcbf29ce484222325ULL;
+  hashSize(hash, workflow.size());
+  for (auto& spec : workflow) {
+    hashString(hash, spec.name);
+    hashSize(hash, spec.maxInputTimeslices);
+    hashSize(hash, spec.inputs.size());
+    for (auto& input : spec.inputs) {
+      hashString(hash, DataSpecUtils::describe(input));
+    }
+    hashSize(hash, spec.outputs.size());
+    for (auto& output : spec.outputs) {
+      hashString(hash, DataSpecUtils::describe(output));
+    }
+  }
+  return hash;
+}
+
+bool WorkflowHelpers::constructGraphCached(const WorkflowSpec& workflow,
+                                           std::string const& cacheDir,
+                                           std::vector<DeviceConnectionEdge>& logicalEdges,
+                                           std::vector<OutputSpec>& outputs,
+                                           std::vector<LogicalForwardInfo>& forwardedInputsInfo)
+{
+  assert(!workflow.empty());
+  auto hash = graphHash(workflow);
+  auto path = graphCachePath(cacheDir, hash);
+
+  // The outputs are simply all the outputs of the workflow, in order, so
+  // there is no point in caching them.
+  for (auto& producer : workflow) {
+    outputs.insert(outputs.end(), producer.outputs.begin(), producer.outputs.end());
+  }
+  if (loadGraph(path, hash, workflow, outputs, logicalEdges, forwardedInputsInfo)) {
+    return true;
+  }
+  outputs.clear();
+  logicalEdges.clear();
+  forwardedInputsInfo.clear();
+  constructGraph(workflow, logicalEdges, outputs, forwardedInputsInfo);
+  storeGraph(path, hash, logicalEdges, forwardedInputsInfo);
+  return false;
+}
+
 std::vector<EdgeAction>
   WorkflowHelpers::computeOutEdgeActions(
     const std::vector<DeviceConnectionEdge>& edges,
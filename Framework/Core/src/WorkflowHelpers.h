@@ -17,6 +17,8 @@
 #include "Framework/DataOutputDirector.h"
 
 #include <cstddef>
+#include <cstdint>
+#include <string>
 #include <vector>
 #include <iosfwd>
 
@@ -182,6 +184,13 @@ struct WorkflowHelpers {
   // @a ctx the context for the configuration phase
   static void injectServiceDevices(WorkflowSpec& workflow, ConfigContext& ctx);
 
+  // Make sure each spawned (DYN) or index (IDX) table is computed only once
+  // per timeframe in @a workflow. When several data processors declare it as
+  // output, they all get it as an input instead: from the spawner or the
+  // index builder when they can produce it, otherwise from the first
+  // declaring data processor, which must not depend on the others.
+  static void shareDerivedTables(WorkflowSpec& workflow);
+
   // Final adjustments to @a workflow after service devices have been injected.
   static void adjustTopology(WorkflowSpec& workflow, ConfigContext const& ctx);
 
@@ -190,6 +199,21 @@ struct WorkflowHelpers {
                              std::vector<OutputSpec>& outputs,
                              std::vector<LogicalForwardInfo>& availableForwardsInfo);
 
+  /// Hash of everything constructGraph depends on, i.e. the names, the
+  /// time pipelining and the data specs of all the data processors in @a workflow.
+  static uint64_t graphHash(const WorkflowSpec& workflow);
+
+  /// Same as constructGraph, but the edges and the forwards are read from
+  /// a file in @a cacheDir, when one was stored there for the same graphHash.
+  /// Otherwise the graph is constructed and stored for the next time, so that
+  /// the devices of a workflow do not all redo the matching of the driver.
+  /// @return true if the graph was found in the cache.
+  static bool constructGraphCached(const WorkflowSpec& workflow,
+                                   std::string const& cacheDir,
+                                   std::vector<DeviceConnectionEdge>& logicalEdges,
+                                   std::vector<OutputSpec>& outputs,
+                                   std::vector<LogicalForwardInfo>& availableForwardsInfo);
+
   // FIXME: this is an implementation detail for compute edge action,
   //        actually. It should be moved to the cxx. Comes handy for testing things though..
   static void sortEdges(std::vector<size_t>& inEdgeIndex,
@@ -328,6 +328,26 @@ int calculateExitCode(DriverInfo& driverInfo, DeviceSpecs& deviceSpecs, DeviceIn
   }
   return 0;
 }
+
+/// Whether any signpost stream was enabled with <stream>:trace
+bool isSignpostTraceEnabled()
+{
+  bool enabled = false;
+  o2_walk_logs([](char const*, void* l, void* context) {
+    auto* log = (_o2_log_t*)l;
+    *(bool*)context |= log->binary && log->stacktrace;
+    return true;
+  },
+               &enabled);
+  return enabled;
+}
+
+/// File where the recorded signposts of the given process are exported at exit
+std::string signpostTraceFilename(std::string const& processName)
+{
+  return fmt::format("dpl-trace-{}.json", processName);
+}
+
 } // namespace
 
 void createPipes(int* pipes)
@@ -738,6 +758,9 @@ void spawnDevice(uv_loop_t* loop,
     dup2(childFds[ref.index].childstdin[0], STDIN_FILENO);
     dup2(childFds[ref.index].childstdout[1], STDOUT_FILENO);
     dup2(childFds[ref.index].childstdout[1], STDERR_FILENO);
+    if (!ComputingResourceHelpers::applyPlacement(spec.resource)) {
+      LOGP(warn, "Unable to bind {} to NUMA node {}, cpus {}", spec.id, spec.resource.numaNode, ComputingResourceHelpers::formatCpuList(spec.resource.cpus));
+    }
 
     for (auto& service : spec.services) {
       if (service.postForkChild != nullptr) {
@@ -1046,11 +1069,13 @@ int doChild(int argc, char** argv, ServiceRegistry& serviceRegistry,
       ("driver-client-backend", bpo::value<std::string>()->default_value(defaultDriverClient), "backend for device -> driver communicataon: stdout://: use stdout, ws://: use websockets")         //
       ("infologger-severity", bpo::value<std::string>()->default_value(""), "minimum FairLogger severity to send to InfoLogger")                                                                   //
       ("dpl-tracing-flags", bpo::value<std::string>()->default_value(""), "pipe `|` separate list of events to be traced")                                                                         //
-      ("signposts", bpo::value<std::string>()->default_value(defaultSignposts ? defaultSignposts : ""), "comma separated list of signposts to enable")                                             //
+      ("signposts", bpo::value<std::string>()->default_value(defaultSignposts ? defaultSignposts : ""), "comma separated list of signposts to enable, <name>:trace records them in dpl-trace.json") //
       ("expected-region-callbacks", bpo::value<std::string>()->default_value("0"), "how many region callbacks we are expecting")                                                                   //
       ("exit-transition-timeout", bpo::value<std::string>()->default_value(defaultExitTransitionTimeout), "how many second to wait before switching from RUN to READY")                            //
       ("data-processing-timeout", bpo::value<std::string>()->default_value(defaultDataProcessingTimeout), "how many second to wait before stopping data processing and allowing data calibration") //
       ("timeframes-rate-limit", bpo::value<std::string>()->default_value("0"), "how many timeframe can be in fly at the same moment (0 disables)")                                                 //
+      ("output-buffer-pool-size", bpo::value<std::string>()->default_value("0"), "size in MB of the pool recycling the output message buffers, one per transport (0 disables)")                     //
+      ("output-buffer-pool-numa-node", bpo::value<std::string>()->default_value("-1"), "NUMA node for the output buffer pools (-1 lets the kernel decide)")                                       //
       ("configuration,cfg", bpo::value<std::string>()->default_value("command-line"), "configuration backend")                                                                                     //
       ("infologger-mode", bpo::value<std::string>()->default_value(defaultInfologgerMode), "O2_INFOLOGGER_MODE override");
     r.fConfig.AddToCmdLineOptions(optsDesc, true);
@@ -1116,6 +1141,10 @@ int doChild(int argc, char** argv, ServiceRegistry& serviceRegistry,
   ServiceRegistryRef serviceRef = {serviceRegistry};
   auto& context = serviceRef.get<DataProcessorContext>();
   DataProcessorContext::preExitCallbacks(context.preExitHandles, serviceRef);
+  // The driver merges the traces of all the devices at exit.
+  if (isSignpostTraceEnabled()) {
+    o2_signpost_write_trace(signpostTraceFilename(spec.id).c_str(), spec.id.c_str());
+  }
   return result;
 }
 
@@ -1244,6 +1273,9 @@ void dumpMetricsCallback(uv_timer_t* handle)
   static auto performanceMetrics = getDumpableMetrics();
   ResourcesMonitoringHelper::dumpMetricsToJSON(*(context->metrics),
                                                context->driver->metrics, *(context->specs), performanceMetrics);
+  ResourcesMonitoringHelper::dumpMetricsHistoryToArrow(*(context->metrics),
+                                                       context->driver->metrics, *(context->specs), performanceMetrics,
+                                                       "performanceMetricsHistory.arrow");
 }
 
 void dumpRunSummary(DriverServerContext& context, DriverInfo const& driverInfo, DeviceInfos const& infos, DeviceSpecs const& specs)
@@ -2085,6 +2117,13 @@ int runStateMachine(DataProcessorSpecs const& workflow,
         for (auto& callback : preScheduleCallbacks) {
           callback(serviceRegistry, {varmap});
         }
+        if (driverInfo.devicePlacement != DevicePlacementPolicy::None) {
+          auto topology = ComputingResourceHelpers::getLocalhostTopology();
+          ComputingResourceHelpers::placeDevices(runningWorkflow.devices, topology, driverInfo.devicePlacement);
+          for (auto& device : runningWorkflow.devices) {
+            LOGP(info, "Placing {} on NUMA node {}, cpus {}", device.id, device.resource.numaNode, ComputingResourceHelpers::formatCpuList(device.resource.cpus));
+          }
+        }
         childFds.resize(runningWorkflow.devices.size());
         for (int di = 0; di < (int)runningWorkflow.devices.size(); ++di) {
           auto& context = childFds[di];
@@ -2104,6 +2143,7 @@ int runStateMachine(DataProcessorSpecs const& workflow,
                         childFds, parentCPU, parentNode);
           }
         }
+        LOGP(info, "{} devices spawned {} ms after the driver startup", runningWorkflow.devices.size(), (uv_hrtime() - driverInfo.startTime) / 1000000);
         handleSignals();
         handleChildrenStdio(&serverContext, forwardedStdin.str(), childFds, pollHandles);
         for (auto& callback : postScheduleCallbacks) {
@@ -2257,10 +2297,28 @@ int runStateMachine(DataProcessorSpecs const& workflow,
           if (driverInfo.resourcesMonitoringDumpInterval) {
             uv_timer_stop(&metricDumpTimer);
           }
-          LOG(info) << "Dumping performance metrics to performanceMetrics.json file";
+          LOG(info) << "Dumping performance metrics to performanceMetrics.json and performanceMetricsHistory.arrow files";
           dumpMetricsCallback(&metricDumpTimer);
         }
         dumpRunSummary(serverContext, driverInfo, infos, runningWorkflow.devices);
+        if (isSignpostTraceEnabled()) {
+          std::vector<std::string> traceFiles{signpostTraceFilename("driver")};
+          o2_signpost_write_trace(traceFiles.back().c_str(), "driver");
+          for (auto& device : runningWorkflow.devices) {
+            traceFiles.push_back(signpostTraceFilename(device.id));
+          }
+          std::vector<char const*> inputs;
+          for (auto& traceFile : traceFiles) {
+            inputs.push_back(traceFile.c_str());
+          }
+          LOGP(info, "Dumping signposts trace to dpl-trace.json");
+          if (o2_signpost_merge_traces("dpl-trace.json", inputs.data(), inputs.size()) < 0) {
+            LOGP(warning, "Could not write out the signposts trace. Read only run folder?");
+          }
+          for (auto& traceFile : traceFiles) {
+            unlink(traceFile.c_str());
+          }
+        }
         // This is a clean exit. Before we do so, if required,
         // we dump the configuration of all the devices so that
         // we can reuse it. Notice we do not dump anything if
@@ -2771,7 +2829,9 @@ void enableSignposts(std::string const& signpostsToEnable)
     std::string prefix = "ch.cern.aliceo2.";
     auto* last = strchr(selectedName, ':');
     int maxDepth = 1;
-    if (last) {
+    // <stream>:trace records the signposts in binary form, to be exported at exit
+    bool trace = last && strcmp(last + 1, "trace") == 0;
+    if (last && !trace) {
       char* err;
       maxDepth = strtol(last + 1, &err, 10);
       if (*(last + 1) == '\0' || *err != '\0') {
@@ -2780,7 +2840,12 @@ void enableSignposts(std::string const& signpostsToEnable)
     }
 
     auto fullName = prefix + std::string{selectedName, last ? last - selectedName : strlen(selectedName)};
-    if (fullName == name) {
+    if (fullName == name && trace) {
+      LOGP(info, "Recording signposts for stream \"{}\" in the trace.", fullName);
+      _o2_log_set_binary(log, 1);
+      _o2_log_set_stacktrace(log, 1);
+      return false;
+    } else if (fullName == name) {
       LOGP(info, "Enabling signposts for stream \"{}\" with depth {}.", fullName, maxDepth);
       _o2_log_set_stacktrace(log, maxDepth);
       return false;
@@ -2905,7 +2970,8 @@ int doMain(int argc, char** argv, o2::framework::WorkflowSpec const& workflow,
     ("no-IPC", bpo::value<bool>()->zero_tokens()->default_value(false), "disable IPC topology optimization")                                                           //                                                                                                                                        //
     ("o2-control,o2", bpo::value<std::string>()->default_value(""), "dump O2 Control workflow configuration under the specified name")                                 //
     ("resources-monitoring", bpo::value<unsigned short>()->default_value(0), "enable cpu/memory monitoring for provided interval in seconds")                          //
-    ("resources-monitoring-dump-interval", bpo::value<unsigned short>()->default_value(0), "dump monitoring information to disk every provided seconds");              //
+    ("resources-monitoring-dump-interval", bpo::value<unsigned short>()->default_value(0), "dump monitoring information to disk every provided seconds")               //
+    ("device-placement", bpo::value<std::string>()->default_value("none"), "bind the devices to the cores of the host: none, numa, cores");                            //
   // some of the options must be forwarded by default to the device
   executorOptions.add(DeviceSpecHelpers::getForwardedDeviceOptions());
 
@@ -3223,6 +3289,15 @@ int doMain(int argc, char** argv, o2::framework::WorkflowSpec const& workflow,
   driverInfo.resources = varmap["resources"].as<std::string>();
   driverInfo.resourcesMonitoringInterval = varmap["resources-monitoring"].as<unsigned short>();
   driverInfo.resourcesMonitoringDumpInterval = varmap["resources-monitoring-dump-interval"].as<unsigned short>();
+  auto devicePlacement = varmap["device-placement"].as<std::string>();
+  if (devicePlacement == "numa") {
+    driverInfo.devicePlacement = DevicePlacementPolicy::Numa;
+  } else if (devicePlacement == "cores") {
+    driverInfo.devicePlacement = DevicePlacementPolicy::Cores;
+  } else if (devicePlacement != "none") {
+    LOGP(error, "Invalid --device-placement {}. Valid values: none, numa, cores", devicePlacement);
+    return 1;
+  }
 
   // FIXME: should use the whole dataProcessorInfos, actually...
   driverInfo.processorInfo = dataProcessorInfos;
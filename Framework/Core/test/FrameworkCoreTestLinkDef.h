@@ -17,8 +17,10 @@
 #pragma link C++ class o2::test::Base + ;
 #pragma link C++ class o2::test::Polymorphic + ;
 #pragma link C++ class o2::test::SimplePODClass + ;
+#pragma link C++ class o2::test::ClusterCollection + ;
 #pragma link C++ class std::vector < o2::test::TriviallyCopyable > +;
 #pragma link C++ class std::vector < o2::test::Polymorphic > +;
+#pragma link C++ class std::vector < o2::test::ClusterCollection > +;
 
 #pragma link C++ class StepTHn + ;
 #pragma link C++ class StepTHnT < TArrayF> + ;
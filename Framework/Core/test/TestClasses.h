@@ -13,6 +13,8 @@
 
 #include <Rtypes.h>
 #include "Framework/OutputSpec.h"
+#include <cstdint>
+#include <vector>
 
 namespace o2::test
 {
@@ -84,5 +86,15 @@ class SimplePODClass
   ClassDefNV(SimplePODClass, 1);
 };
 
+/// Non-messageable aggregate, which can be sent either ROOT or flat serialized
+struct ClusterCollection {
+  int id = 0;
+  std::vector<float> x;
+  std::vector<float> y;
+  std::vector<uint16_t> charge;
+
+  ClassDefNV(ClusterCollection, 1);
+};
+
 } // namespace o2::test
 #endif // O2_FRAMEWORK_TEST_CLASSES_H_
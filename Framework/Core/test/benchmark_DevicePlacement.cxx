@@ -0,0 +1,133 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+#include <benchmark/benchmark.h>
+
+#include "../src/ComputingResourceHelpers.h"
+#include "Framework/DeviceSpec.h"
+#include <atomic>
+#include <thread>
+#include <vector>
+
+using namespace o2::framework;
+
+namespace
+{
+constexpr size_t BufferSize = 16 << 20;
+constexpr size_t Stages = 8;
+
+// Synthetic topology: a chain of devices, each with one route to the next.
+std::vector<DeviceSpec> createChain()
+{
+  std::vector<DeviceSpec> devices(Stages);
+  for (size_t di = 0; di < devices.size(); ++di) {
+    devices[di].id = "stage-" + std::to_string(di);
+    if (di + 1 < devices.size()) {
+      auto channel = "from_" + std::to_string(di) + "_to_" + std::to_string(di + 1);
+      devices[di].outputs.push_back(OutputRoute{0, 1, OutputSpec{"TST", "A", (uint32_t)di}, channel, nullptr});
+      devices[di + 1].inputChannels.push_back(InputChannelSpec{.name = channel});
+    }
+  }
+  return devices;
+}
+
+/// One thread per device, bound like the device would be. Each stage reads
+/// the buffer of the previous one and writes its own, as a consumer does
+/// with the messages of its producer, so that the cost of the placement is
+/// in the cross node traffic.
+void runChain(benchmark::State& state, std::vector<DeviceSpec> const& devices)
+{
+  std::vector<std::vector<char>> buffers(devices.size());
+  std::vector<std::atomic<int64_t>> done(devices.size());
+  for (auto& d : done) {
+    d = -1;
+  }
+  std::atomic<int64_t> target = -1;
+  std::atomic<bool> stop = false;
+
+  std::vector<std::thread> threads;
+  for (size_t si = 0; si < devices.size(); ++si) {
+    threads.emplace_back([&, si]() {
+      ComputingResourceHelpers::applyPlacement(devices[si].resource);
+      // First touch from the stage itself, so that the memory follows the binding.
+      buffers[si].resize(BufferSize, 0);
+      for (int64_t pass = 0;; ++pass) {
+        while (!stop && (target < pass || (si > 0 && done[si - 1] < pass) || (si + 1 < devices.size() && done[si + 1] < pass - 1))) {
+          std::this_thread::yield();
+        }
+        if (stop) {
+          return;
+        }
+        auto* out = buffers[si].data();
+        if (si == 0) {
+          for (size_t i = 0; i < BufferSize; ++i) {
+            out[i] = (char)(i + pass);
+          }
+        } else {
+          auto const* in = buffers[si - 1].data();
+          for (size_t i = 0; i < BufferSize; ++i) {
+            out[i] = in[i] + 1;
+          }
+        }
+        done[si] = pass;
+      }
+    });
+  }
+
+  int64_t pass = 0;
+  for (auto _ : state) {
+    target = pass;
+    while (done.back() < pass) {
+      std::this_thread::yield();
+    }
+    ++pass;
+  }
+  stop = true;
+  for (auto& thread : threads) {
+    thread.join();
+  }
+  state.SetBytesProcessed(state.iterations() * BufferSize * devices.size());
+}
+} // namespace
+
+static void BM_ChainUnbound(benchmark::State& state)
+{
+  auto devices = createChain();
+  runChain(state, devices);
+}
+
+// Placement chosen by the driver for --device-placement numa / cores
+static void BM_ChainPlaced(benchmark::State& state)
+{
+  auto devices = createChain();
+  auto topology = ComputingResourceHelpers::getLocalhostTopology();
+  ComputingResourceHelpers::placeDevices(devices, topology, (DevicePlacementPolicy)state.range(0));
+  runChain(state, devices);
+}
+
+// Worst case: every link of the chain crosses nodes. Same as placed on a
+// single node host.
+static void BM_ChainScattered(benchmark::State& state)
+{
+  auto devices = createChain();
+  auto topology = ComputingResourceHelpers::getLocalhostTopology();
+  for (size_t di = 0; di < devices.size(); ++di) {
+    auto& node = topology[di % topology.size()];
+    devices[di].resource.numaNode = node.id;
+    devices[di].resource.cpus = node.cpus;
+  }
+  runChain(state, devices);
+}
+
+BENCHMARK(BM_ChainUnbound)->UseRealTime();
+BENCHMARK(BM_ChainPlaced)->Arg((int)DevicePlacementPolicy::Numa)->Arg((int)DevicePlacementPolicy::Cores)->UseRealTime();
+BENCHMARK(BM_ChainScattered)->UseRealTime();
+
+BENCHMARK_MAIN();
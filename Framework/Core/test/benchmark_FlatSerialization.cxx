@@ -0,0 +1,107 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+#include <benchmark/benchmark.h>
+
+#include "Framework/FlatSerialization.h"
+#include "Framework/TMessageSerializer.h"
+#include "TestClasses.h"
+#include <fairmq/TransportFactory.h>
+#include <TClass.h>
+#include <algorithm>
+#include <vector>
+
+using namespace o2::framework;
+using Element = o2::test::ClusterCollection;
+
+// Vector of non-messageable structures made of vectors, with ROOT dictionary,
+// which would otherwise be sent with ROOTSerialized. The range of the benchmarks
+// is the total number of clusters, spread over collections of 64 clusters.
+constexpr size_t ClustersPerCollection = 64;
+
+std::vector<Element> createElements(size_t nClusters)
+{
+  std::vector<Element> elements(std::max<size_t>(1, nClusters / ClustersPerCollection));
+  for (size_t i = 0; i < elements.size(); ++i) {
+    auto& element = elements[i];
+    element.id = i;
+    for (size_t j = 0; j < ClustersPerCollection; ++j) {
+      element.x.push_back(i + 0.1f * j);
+      element.y.push_back(i - 0.1f * j);
+      element.charge.push_back(j);
+    }
+  }
+  return elements;
+}
+
+size_t payloadBytes(std::vector<Element> const& elements)
+{
+  return elements.size() * ClustersPerCollection * (2 * sizeof(float) + sizeof(uint16_t));
+}
+
+static void BM_ROOTSerializeDeserialize(benchmark::State& state)
+{
+  auto elements = createElements(state.range(0));
+  auto transport = fair::mq::TransportFactory::CreateTransportFactory("zeromq");
+  auto* cl = TClass::GetClass(typeid(std::vector<Element>));
+  for (auto _ : state) {
+    auto msg = transport->CreateMessage(4096);
+    TMessageSerializer::Serialize(*msg, &elements, cl);
+    std::unique_ptr<std::vector<Element>> result;
+    TMessageSerializer::Deserialize(*msg, result);
+    benchmark::DoNotOptimize(result->data());
+  }
+  state.SetBytesProcessed(state.iterations() * payloadBytes(elements));
+}
+
+static void BM_FlatSerializeDeserialize(benchmark::State& state)
+{
+  auto elements = createElements(state.range(0));
+  auto transport = fair::mq::TransportFactory::CreateTransportFactory("zeromq");
+  for (auto _ : state) {
+    auto msg = transport->CreateMessage(FlatSerialization::size(elements));
+    FlatSerialization::serialize(static_cast<char*>(msg->GetData()), msg->GetSize(), elements);
+    std::vector<Element> result;
+    FlatSerialization::deserialize(static_cast<char const*>(msg->GetData()), msg->GetSize(), result);
+    benchmark::DoNotOptimize(result.data());
+  }
+  state.SetBytesProcessed(state.iterations() * payloadBytes(elements));
+}
+
+// The vectors of the collections are accessed in place, without copying them out of the message
+static void BM_FlatSerializeInPlace(benchmark::State& state)
+{
+  auto elements = createElements(state.range(0));
+  auto transport = fair::mq::TransportFactory::CreateTransportFactory("zeromq");
+  for (auto _ : state) {
+    auto msg = transport->CreateMessage(FlatSerialization::size(elements));
+    FlatSerialization::serialize(static_cast<char*>(msg->GetData()), msg->GetSize(), elements);
+    auto reader = FlatSerialization::reader<std::vector<Element>>(static_cast<char const*>(msg->GetData()), msg->GetSize());
+    uint64_t count;
+    reader.read(count);
+    for (uint64_t i = 0; i < count; ++i) {
+      int id;
+      reader.read(id);
+      auto x = reader.readSpan<float>();
+      auto y = reader.readSpan<float>();
+      auto charge = reader.readSpan<uint16_t>();
+      benchmark::DoNotOptimize(x.data());
+      benchmark::DoNotOptimize(y.data());
+      benchmark::DoNotOptimize(charge.data());
+    }
+  }
+  state.SetBytesProcessed(state.iterations() * payloadBytes(elements));
+}
+
+BENCHMARK(BM_ROOTSerializeDeserialize)->Range(64, 1 << 20);
+BENCHMARK(BM_FlatSerializeDeserialize)->Range(64, 1 << 20);
+BENCHMARK(BM_FlatSerializeInPlace)->Range(64, 1 << 20);
+
+BENCHMARK_MAIN();
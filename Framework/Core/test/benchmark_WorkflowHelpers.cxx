@@ -16,7 +16,10 @@
 #include "Framework/SimpleOptionsRetriever.h"
 #include "../src/WorkflowHelpers.h"
 #include <benchmark/benchmark.h>
+#include <fmt/format.h>
 #include <algorithm>
+#include <cstdio>
+#include <unistd.h>
 
 using namespace o2::framework;
 
@@ -108,4 +111,84 @@ static void BM_CreateGraphReverseOverhead(benchmark::State& state)
 }
 
 BENCHMARK(BM_CreateGraphReverseOverhead)->Range(1, 1 << 10);
+
+/// A reconstruction-like topology with @a nDevices processors, each one
+/// producing a few outputs and consuming those of the previous two, plus a
+/// sink consuming everything. Every one of the devices spawned by the driver
+/// constructs the same graph at startup.
+static WorkflowSpec makeManyDevicesWorkflow(size_t nDevices)
+{
+  constexpr size_t nOutputs = 4;
+  WorkflowSpec workflow;
+  std::vector<InputSpec> sinkInputs;
+  for (size_t di = 0; di < nDevices; ++di) {
+    DataProcessorSpec spec{fmt::format("proc-{}", di)};
+    for (size_t oi = 0; oi < nOutputs; ++oi) {
+      auto subSpec = static_cast<o2::header::DataHeader::SubSpecificationType>(di * nOutputs + oi);
+      spec.outputs.emplace_back(OutputSpec{"TST", "A", subSpec});
+      sinkInputs.emplace_back(InputSpec{fmt::format("s{}", di * nOutputs + oi), "TST", "A", subSpec});
+      for (size_t pi = 1; pi <= 2 && pi <= di; ++pi) {
+        auto inSubSpec = static_cast<o2::header::DataHeader::SubSpecificationType>((di - pi) * nOutputs + oi);
+        spec.inputs.emplace_back(InputSpec{fmt::format("i{}{}", pi, oi), "TST", "A", inSubSpec});
+      }
+    }
+    workflow.push_back(spec);
+  }
+  workflow.push_back(DataProcessorSpec{"sink", sinkInputs});
+  if (WorkflowHelpers::verifyWorkflow(workflow) != WorkflowParsingState::Valid) {
+    throw std::runtime_error("invalid workflow");
+  }
+  auto context = makeEmptyConfigContext();
+  WorkflowHelpers::injectServiceDevices(workflow, *context);
+  return workflow;
+}
+
+static void BM_GraphManyDevices(benchmark::State& state)
+{
+  auto workflow = makeManyDevicesWorkflow(state.range(0));
+  size_t nEdges = 0;
+  for (auto _ : state) {
+    std::vector<DeviceConnectionEdge> logicalEdges;
+    std::vector<OutputSpec> outputs;
+    std::vector<LogicalForwardInfo> availableForwardsInfo;
+    WorkflowHelpers::constructGraph(workflow, logicalEdges, outputs, availableForwardsInfo);
+    nEdges = logicalEdges.size();
+  }
+  state.counters["edges"] = nEdges;
+}
+
+BENCHMARK(BM_GraphManyDevices)->RangeMultiplier(4)->Range(16, 1 << 10)->Unit(benchmark::kMillisecond);
+
+/// Same as above with DPL_WORKFLOW_GRAPH_CACHE set, after the driver populated the cache.
+static void BM_GraphManyDevicesCached(benchmark::State& state)
+{
+  auto workflow = makeManyDevicesWorkflow(state.range(0));
+  char cacheDir[] = "/tmp/dpl-graph-bench-XXXXXX";
+  if (mkdtemp(cacheDir) == nullptr) {
+    state.SkipWithError("cannot create the cache directory");
+    return;
+  }
+  {
+    std::vector<DeviceConnectionEdge> logicalEdges;
+    std::vector<OutputSpec> outputs;
+    std::vector<LogicalForwardInfo> availableForwardsInfo;
+    WorkflowHelpers::constructGraphCached(workflow, cacheDir, logicalEdges, outputs, availableForwardsInfo);
+  }
+  size_t nEdges = 0;
+  for (auto _ : state) {
+    std::vector<DeviceConnectionEdge> logicalEdges;
+    std::vector<OutputSpec> outputs;
+    std::vector<LogicalForwardInfo> availableForwardsInfo;
+    if (!WorkflowHelpers::constructGraphCached(workflow, cacheDir, logicalEdges, outputs, availableForwardsInfo)) {
+      state.SkipWithError("graph not found in the cache");
+      break;
+    }
+    nEdges = logicalEdges.size();
+  }
+  state.counters["edges"] = nEdges;
+  remove(fmt::format("{}/dpl-graph-{:016x}.bin", cacheDir, WorkflowHelpers::graphHash(workflow)).c_str());
+  rmdir(cacheDir);
+}
+
+BENCHMARK(BM_GraphManyDevicesCached)->RangeMultiplier(4)->Range(16, 1 << 10)->Unit(benchmark::kMillisecond);
 BENCHMARK_MAIN();
@@ -12,6 +12,8 @@
 #include <catch_amalgamated.hpp>
 
 #include "../src/ComputingResourceHelpers.h"
+#include "Framework/DeviceSpec.h"
+#include <algorithm>
 #include <string>
 #include <vector>
 
@@ -43,3 +45,62 @@ TEST_CASE("TestResourceParsing")
   REQUIRE(resources[1].startPort == 22000);
   REQUIRE(resources[1].lastPort == 23000);
 }
+
+TEST_CASE("TestCpuListParsing")
+{
+  REQUIRE(ComputingResourceHelpers::parseCpuList("0-3,8,10-11") == std::vector<int>{0, 1, 2, 3, 8, 10, 11});
+  REQUIRE(ComputingResourceHelpers::parseCpuList("5").size() == 1);
+  REQUIRE(ComputingResourceHelpers::parseCpuList("").empty());
+  REQUIRE(ComputingResourceHelpers::formatCpuList({0, 1, 2, 3, 8, 10, 11}) == "0-3,8,10-11");
+  REQUIRE(ComputingResourceHelpers::formatCpuList({}).empty());
+}
+
+TEST_CASE("TestLocalhostTopology")
+{
+  auto topology = ComputingResourceHelpers::getLocalhostTopology();
+  REQUIRE(topology.size() >= 1);
+  REQUIRE(topology[0].cpus.empty() == false);
+
+  // Without the sysfs information, one node with all the allowed cores
+  auto fallback = ComputingResourceHelpers::getLocalhostTopology("/this/does/not/exist");
+  REQUIRE(fallback.size() == 1);
+  REQUIRE(fallback[0].id == 0);
+}
+
+TEST_CASE("TestDevicePlacement")
+{
+  // Two chains A -> B and C -> D, on a host with two nodes of two cores.
+  std::vector<DeviceSpec> devices(4);
+  char const* names[] = {"A", "B", "C", "D"};
+  for (size_t di = 0; di < devices.size(); ++di) {
+    devices[di].id = names[di];
+  }
+  // Interleave the chains, so that the device order alone does not give the answer.
+  std::swap(devices[1], devices[2]);
+  devices[0].outputs.push_back(OutputRoute{0, 1, OutputSpec{"TST", "A"}, "from_A_to_B", nullptr});
+  devices[2].inputChannels.push_back(InputChannelSpec{.name = "from_A_to_B"});
+  devices[1].outputs.push_back(OutputRoute{0, 1, OutputSpec{"TST", "C"}, "from_C_to_D", nullptr});
+  devices[3].inputChannels.push_back(InputChannelSpec{.name = "from_C_to_D"});
+
+  std::vector<NumaNodeInfo> topology{{0, {0, 1}}, {1, {2, 3}}};
+  ComputingResourceHelpers::placeDevices(devices, topology, DevicePlacementPolicy::Numa);
+  REQUIRE(devices[0].resource.numaNode == devices[2].resource.numaNode);
+  REQUIRE(devices[1].resource.numaNode == devices[3].resource.numaNode);
+  REQUIRE(devices[0].resource.numaNode != devices[1].resource.numaNode);
+  REQUIRE(devices[0].resource.cpus == topology[devices[0].resource.numaNode].cpus);
+
+  ComputingResourceHelpers::placeDevices(devices, topology, DevicePlacementPolicy::Cores);
+  std::vector<int> used;
+  for (auto& device : devices) {
+    REQUIRE(device.resource.cpus.size() == 1);
+    used.push_back(device.resource.cpus[0]);
+  }
+  std::sort(used.begin(), used.end());
+  REQUIRE(used == std::vector<int>{0, 1, 2, 3});
+
+  ComputingResourceHelpers::placeDevices(devices, topology, DevicePlacementPolicy::None);
+  for (auto& device : devices) {
+    REQUIRE(device.resource.numaNode == -1);
+    REQUIRE(device.resource.cpus.empty());
+  }
+}
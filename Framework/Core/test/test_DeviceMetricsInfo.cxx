@@ -515,3 +515,101 @@ TEST_CASE("TestHelpers")
   REQUIRE(metric2 == 0);
   REQUIRE(metric3 == 1);
 }
+
+TEST_CASE("TestBinaryMetrics")
+{
+  using namespace o2::framework;
+  std::array<char, 1024> buffer;
+  ParsedMetricMatch match;
+  DeviceMetricsInfo info;
+
+  auto size = DeviceMetricsHelper::encodeBinaryMetric(buffer.data(), buffer.size(), "bkey", 12, 1789372894);
+  REQUIRE(size == 3 + 4 + 8 + 4);
+  REQUIRE(DeviceMetricsHelper::parseMetric(std::string_view(buffer.data(), size), match) == false);
+  REQUIRE(DeviceMetricsHelper::parseBinaryMetric(std::string_view(buffer.data(), size), match));
+  REQUIRE(std::string_view(match.beginKey, match.endKey - match.beginKey) == "bkey");
+  REQUIRE(match.type == MetricType::Int);
+  REQUIRE(match.intValue == 12);
+  REQUIRE(match.floatValue == 12.f);
+  REQUIRE(match.timestamp == 1789372894);
+  REQUIRE(DeviceMetricsHelper::processMetric(match, info));
+  REQUIRE(info.intMetrics[0][0] == 12);
+  REQUIRE(info.intTimestamps[0][0] == 1789372894);
+
+  size = DeviceMetricsHelper::encodeBinaryMetric(buffer.data(), buffer.size(), "ckey", 1.5f, 1789372895);
+  REQUIRE(DeviceMetricsHelper::parseBinaryMetric(std::string_view(buffer.data(), size), match));
+  REQUIRE(match.type == MetricType::Float);
+  REQUIRE(match.floatValue == 1.5f);
+
+  size = DeviceMetricsHelper::encodeBinaryMetric(buffer.data(), buffer.size(), "dkey", (uint64_t)1 << 40, 1789372896);
+  REQUIRE(DeviceMetricsHelper::parseBinaryMetric(std::string_view(buffer.data(), size), match));
+  REQUIRE(match.type == MetricType::Uint64);
+  REQUIRE(match.uint64Value == (uint64_t)1 << 40);
+
+  size = DeviceMetricsHelper::encodeBinaryMetric(buffer.data(), buffer.size(), "ekey", std::string_view("some string"), 1789372897);
+  REQUIRE(DeviceMetricsHelper::parseBinaryMetric(std::string_view(buffer.data(), size), match));
+  REQUIRE(match.type == MetricType::String);
+  REQUIRE(std::string_view(match.beginStringValue, match.endStringValue - match.beginStringValue) == "some string");
+  REQUIRE(DeviceMetricsHelper::processMetric(match, info));
+  REQUIRE(strcmp(info.stringMetrics[0][0].data, "some string") == 0);
+
+  size = DeviceMetricsHelper::encodeBinaryMetric(buffer.data(), buffer.size(), "data_relayer/1", 2, 1789372898);
+  REQUIRE(DeviceMetricsHelper::parseBinaryMetric(std::string_view(buffer.data(), size), match));
+  REQUIRE(match.type == MetricType::Enum);
+
+  // Truncated messages and text metrics are rejected
+  REQUIRE(DeviceMetricsHelper::parseBinaryMetric(std::string_view(buffer.data(), size - 1), match) == false);
+  REQUIRE(DeviceMetricsHelper::parseBinaryMetric("[METRIC] bkey,0 12 1789372894", match) == false);
+  // Does not fit
+  REQUIRE(DeviceMetricsHelper::encodeBinaryMetric(buffer.data(), 10, "bkey", 12, 1789372894) == 0);
+}
+
+TEST_CASE("TestMetricsHistory")
+{
+  using namespace o2::framework;
+  DeviceMetricsInfo info;
+  auto cursor = DeviceMetricsHelper::createNumericMetric<int>(info, "akey");
+  REQUIRE(info.history.size() == 1);
+
+  // Three values per second, for 10 minutes and a bit.
+  size_t start = 1789372800000;
+  for (size_t i = 0; i < 3 * 700; ++i) {
+    cursor(info, i % 3, start + i * 333 + i / 3);
+  }
+  std::vector<MetricBucket> seconds;
+  REQUIRE(DeviceMetricsHelper::getHistory(info, 0, MetricResolution::Second, seconds) == MetricHistory::CAPACITY[0]);
+  // The oldest 100 seconds were overwritten
+  REQUIRE(seconds.front().index == start / 1000 + 100);
+  REQUIRE(seconds.back().index == start / 1000 + 699);
+  for (size_t i = 0; i < seconds.size(); ++i) {
+    REQUIRE(seconds[i].index == seconds.front().index + i);
+    REQUIRE(seconds[i].count == 3);
+    REQUIRE(seconds[i].min == 0);
+    REQUIRE(seconds[i].max == 2);
+    REQUIRE(seconds[i].average() == 1);
+  }
+
+  std::vector<MetricBucket> minutes;
+  REQUIRE(DeviceMetricsHelper::getHistory(info, 0, MetricResolution::Minute, minutes) == 12);
+  REQUIRE(minutes.front().index == start / 60000);
+  REQUIRE(minutes[0].count == 180);
+  REQUIRE(minutes.back().count == 3 * 40);
+
+  // Late samples go in the last bucket.
+  cursor(info, 10, start);
+  seconds.clear();
+  DeviceMetricsHelper::getHistory(info, 0, MetricResolution::Second, seconds);
+  REQUIRE(seconds.back().count == 4);
+  REQUIRE(seconds.back().max == 10);
+
+  // Text metrics, strings are not downsampled.
+  ParsedMetricMatch match;
+  REQUIRE(DeviceMetricsHelper::parseMetric("[METRIC] bkey,1 foo 1789372894", match));
+  REQUIRE(DeviceMetricsHelper::processMetric(match, info));
+  REQUIRE(DeviceMetricsHelper::parseMetric("[METRIC] ckey,2 1.5 1789372894", match));
+  REQUIRE(DeviceMetricsHelper::processMetric(match, info));
+  std::vector<MetricBucket> buckets;
+  REQUIRE(DeviceMetricsHelper::getHistory(info, 1, MetricResolution::Second, buckets) == 0);
+  REQUIRE(DeviceMetricsHelper::getHistory(info, 2, MetricResolution::Minute, buckets) == 1);
+  REQUIRE(buckets[0].sum == 1.5f);
+}
@@ -0,0 +1,170 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+#include "Framework/FlatSerialization.h"
+#include <catch_amalgamated.hpp>
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+using namespace o2::framework;
+
+namespace
+{
+struct Hit {
+  float x;
+  float y;
+  uint16_t charge;
+};
+
+struct Track {
+  int id;
+  std::vector<Hit> hits;
+  std::string name;
+};
+
+struct Event {
+  static constexpr uint32_t FlatSchemaVersion = 2;
+  double time = 0;
+  uint8_t flags = 0;
+  std::vector<Track> tracks;
+  std::vector<int64_t> labels;
+};
+
+/// Two versions of the same element, with identical layout
+struct PointV1 {
+  static constexpr uint32_t FlatSchemaVersion = 1;
+  float x;
+  float y;
+};
+
+struct PointV2 {
+  static constexpr uint32_t FlatSchemaVersion = 2;
+  float x;
+  float y;
+};
+
+/// Aggregates with members which can not be flat serialized, directly or in a nested aggregate
+struct WithMap {
+  int id;
+  std::vector<Hit> hits;
+  std::map<int, float> weights;
+};
+
+struct WithOwner {
+  std::string name;
+  std::unique_ptr<Hit> hit;
+};
+
+struct Inner {
+  float x;
+  std::map<int, float> weights;
+};
+
+struct WithInner {
+  std::vector<int> ids;
+  Inner inner;
+};
+} // namespace
+
+TEST_CASE("TestFlatSerializationRoundTrip")
+{
+  Event event{1.5, 3, {{1, {{1.f, 2.f, 3}, {4.f, 5.f, 6}}, "first"}, {2, {}, ""}}, {7, 8, 9}};
+  std::vector<char> buffer(FlatSerialization::size(event));
+  REQUIRE(FlatSerialization::serialize(buffer.data(), buffer.size(), event) == buffer.size());
+
+  auto result = FlatSerialization::deserialize<Event>(buffer.data(), buffer.size());
+  REQUIRE(result->time == 1.5);
+  REQUIRE(result->flags == 3);
+  REQUIRE(result->tracks.size() == 2);
+  REQUIRE(result->tracks[0].id == 1);
+  REQUIRE(result->tracks[0].hits.size() == 2);
+  REQUIRE(result->tracks[0].hits[1].y == 5.f);
+  REQUIRE(result->tracks[0].hits[1].charge == 6);
+  REQUIRE(result->tracks[0].name == "first");
+  REQUIRE(result->tracks[1].hits.empty());
+  REQUIRE(result->labels == std::vector<int64_t>{7, 8, 9});
+
+  // the buffer is too small for the object or truncated
+  REQUIRE_THROWS(FlatSerialization::serialize(buffer.data(), buffer.size() - 1, event));
+  REQUIRE_THROWS(FlatSerialization::deserialize<Event>(buffer.data(), buffer.size() - 1));
+  // the schema version or the type do not match
+  REQUIRE_THROWS(FlatSerialization::deserialize<Track>(buffer.data(), buffer.size()));
+}
+
+TEST_CASE("TestFlatSerializationInPlace")
+{
+  std::vector<Hit> hits{{1.f, 2.f, 3}, {4.f, 5.f, 6}, {7.f, 8.f, 9}};
+  // make sure the buffer has the alignment of the messages
+  std::vector<uint64_t> buffer((FlatSerialization::size(hits) + 7) / 8);
+  auto* data = reinterpret_cast<char*>(buffer.data());
+  FlatSerialization::serialize(data, buffer.size() * 8, hits);
+
+  auto span = FlatSerialization::span<Hit>(data, buffer.size() * 8);
+  REQUIRE(span.size() == 3);
+  REQUIRE((void const*)span.data() > (void const*)data);
+  REQUIRE((void const*)span.data() < (void const*)(data + buffer.size() * 8));
+  REQUIRE(span[2].x == 7.f);
+  REQUIRE(span[2].charge == 9);
+
+  // a span is serialized in the same way as a vector
+  gsl::span<Hit const> hitsSpan(hits);
+  std::vector<uint64_t> buffer2(buffer.size());
+  FlatSerialization::serialize(reinterpret_cast<char*>(buffer2.data()), buffer2.size() * 8, hitsSpan);
+  REQUIRE(buffer == buffer2);
+
+  // nested vectors of messageable types can be read in place as well
+  Track track{1, hits, "track"};
+  std::vector<uint64_t> buffer3((FlatSerialization::size(track) + 7) / 8);
+  auto* data3 = reinterpret_cast<char*>(buffer3.data());
+  FlatSerialization::serialize(data3, buffer3.size() * 8, track);
+  auto reader = FlatSerialization::reader<Track>(data3, buffer3.size() * 8);
+  int id;
+  reader.read(id);
+  auto trackHits = reader.readSpan<Hit>();
+  std::string name;
+  reader.read(name);
+  REQUIRE(id == 1);
+  REQUIRE(trackHits.size() == 3);
+  REQUIRE(trackHits[1].y == 5.f);
+  REQUIRE(name == "track");
+}
+
+TEST_CASE("TestFlatSerializationElementSchemaVersion")
+{
+  // vectors and spans carry the schema version of their elements
+  std::vector<PointV1> points{{1.f, 2.f}, {3.f, 4.f}};
+  std::vector<uint64_t> buffer((FlatSerialization::size(points) + 7) / 8);
+  auto* data = reinterpret_cast<char*>(buffer.data());
+  FlatSerialization::serialize(data, buffer.size() * 8, points);
+  REQUIRE(FlatSerialization::deserialize<std::vector<PointV1>>(data, buffer.size() * 8)->size() == 2);
+  REQUIRE(FlatSerialization::span<PointV1>(data, buffer.size() * 8).size() == 2);
+  REQUIRE_THROWS(FlatSerialization::deserialize<std::vector<PointV2>>(data, buffer.size() * 8));
+  REQUIRE_THROWS(FlatSerialization::span<PointV2>(data, buffer.size() * 8));
+  REQUIRE(FlatSerialization::schemaVersion<std::vector<std::vector<PointV2>>>() == 2);
+}
+
+TEST_CASE("TestFlatSerializationSupportedTypes")
+{
+  static_assert(FlatSerialization::isSupported<Hit>());
+  static_assert(FlatSerialization::isSupported<Track>());
+  static_assert(FlatSerialization::isSupported<Event>());
+  static_assert(FlatSerialization::isSupported<std::vector<Event>>());
+  static_assert(FlatSerialization::isSupported<gsl::span<Track const>>());
+  static_assert(!FlatSerialization::isSupported<std::vector<bool>>());
+  static_assert(!FlatSerialization::isSupported<std::map<int, float>>());
+  // the members of aggregates are checked recursively
+  static_assert(!FlatSerialization::isSupported<WithMap>());
+  static_assert(!FlatSerialization::isSupported<WithOwner>());
+  static_assert(!FlatSerialization::isSupported<WithInner>());
+  static_assert(!FlatSerialization::isSupported<std::vector<WithInner>>());
+}
@@ -0,0 +1,118 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+#include <catch_amalgamated.hpp>
+#include "Framework/MessageBufferPool.h"
+#include <fairmq/Message.h>
+#include <fairmq/TransportFactory.h>
+#include <chrono>
+#include <thread>
+
+using namespace o2::framework;
+
+namespace
+{
+// The region callbacks are asynchronous
+bool waitForIdle(MessageBufferPool const& pool, size_t idle)
+{
+  for (int i = 0; i < 1000; ++i) {
+    if (pool.stats().idle == idle) {
+      return true;
+    }
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+  }
+  return false;
+}
+} // namespace
+
+TEST_CASE("MessageBufferPoolSizeClass")
+{
+  REQUIRE(MessageBufferPool::sizeClass(100) == 100);
+  REQUIRE(MessageBufferPool::sizeClass(4096) == 4096);
+  REQUIRE(MessageBufferPool::sizeClass(4097) == 4608);
+  REQUIRE(MessageBufferPool::sizeClass(10000) == 10240);
+  REQUIRE(MessageBufferPool::sizeClass(10240) == 10240);
+  REQUIRE(MessageBufferPool::sizeClass(600000) == 655360);
+  for (size_t size = 4096; size < (1 << 24); size = size * 3 / 2 + 7) {
+    auto sizeClass = MessageBufferPool::sizeClass(size);
+    REQUIRE(sizeClass >= size);
+    REQUIRE(sizeClass - size < size / 8);
+    REQUIRE(sizeClass % 64 == 0);
+  }
+}
+
+TEST_CASE("MessageBufferPoolRecycling")
+{
+  auto transport = fair::mq::TransportFactory::CreateTransportFactory("zeromq");
+  MessageBufferPool pool(transport.get(), 1 << 20);
+
+  // small messages do not go through the pool
+  auto small = pool.createMessage(100);
+  REQUIRE(small->GetSize() == 100);
+  REQUIRE(pool.stats().misses == 0);
+
+  void* data = nullptr;
+  {
+    auto msg = pool.createMessage(10000);
+    REQUIRE(msg->GetSize() == 10000);
+    data = msg->GetData();
+    REQUIRE(reinterpret_cast<uintptr_t>(data) % 64 == 0);
+    auto stats = pool.stats();
+    REQUIRE(stats.misses == 1);
+    REQUIRE(stats.inUse == 10240);
+  }
+  REQUIRE(waitForIdle(pool, 10240));
+
+  // same size class, the buffer is reused
+  {
+    auto msg = pool.createMessage(9999);
+    REQUIRE(msg->GetData() == data);
+    auto stats = pool.stats();
+    REQUIRE(stats.hits == 1);
+    REQUIRE(stats.idle == 0);
+    REQUIRE(stats.inUse == 10240);
+
+    // does not fit anymore while the first buffers are in use
+    auto big = pool.createMessage(600000);
+    auto tooBig = pool.createMessage(600000);
+    REQUIRE(tooBig->GetSize() == 600000);
+    stats = pool.stats();
+    REQUIRE(stats.misses == 2);
+    REQUIRE(stats.fallbacks == 1);
+    REQUIRE(stats.carved == 10240 + 655360);
+  }
+  REQUIRE(waitForIdle(pool, 10240 + 655360));
+
+  // the region is full: the idle buffers are merged back into free space, also with buffers in flight
+  auto small2 = pool.createMessage(10000);
+  REQUIRE(small2->GetData() == data);
+  void* hugeData = nullptr;
+  {
+    auto huge = pool.createMessage(700000);
+    hugeData = huge->GetData();
+    REQUIRE(hugeData == static_cast<char*>(data) + 10240);
+    auto stats = pool.stats();
+    REQUIRE(stats.hits == 2);
+    REQUIRE(stats.misses == 3);
+    REQUIRE(stats.fallbacks == 1);
+    REQUIRE(stats.carved == 10240 + 720896);
+    REQUIRE(stats.idle == 0);
+  }
+  REQUIRE(waitForIdle(pool, 720896));
+
+  // without an idle buffer of its class, a message takes the smallest larger one
+  auto msg = pool.createMessage(300000);
+  REQUIRE(msg->GetData() == hugeData);
+  auto stats = pool.stats();
+  REQUIRE(stats.hits == 3);
+  REQUIRE(stats.idle == 0);
+  REQUIRE(stats.inUse == 10240 + 720896);
+}
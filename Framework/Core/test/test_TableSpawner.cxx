@@ -28,9 +28,11 @@ DECLARE_SOA_COLUMN(Y, y, float);
 DECLARE_SOA_COLUMN(Z, z, float);
 DECLARE_SOA_EXPRESSION_COLUMN(Rsq, rsq, float, test::x* test::x + test::y * test::y + test::z * test::z);
 DECLARE_SOA_EXPRESSION_COLUMN(Sin, sin, float, test::x / nsqrt(test::x * test::x + test::y * test::y));
+DECLARE_SOA_DYNAMIC_COLUMN(R, r, [](float x, float y, float z) -> float { return std::sqrt(x * x + y * y + z * z); });
 } // namespace test
 
 DECLARE_SOA_TABLE(Points, "AOD", "PTSNG", test::X, test::Y, test::Z);
+DECLARE_SOA_TABLE(DynPoints, "AOD", "DYNPTSNG", test::X, test::Y, test::Z, test::R<test::X, test::Y, test::Z>);
 DECLARE_SOA_EXTENDED_TABLE(ExPoints, Points, "EXPTSNG", 0, test::Rsq, test::Sin);
 } // namespace o2::aod
 
@@ -72,3 +74,51 @@ TEST_CASE("TestTableSpawner")
     ++rexp_a;
   }
 }
+
+TEST_CASE("TestMaterializedDynamicColumns")
+{
+  TableBuilder b1;
+  auto w1 = b1.cursor<DynPoints>();
+
+  for (auto i = 1; i < 10; ++i) {
+    w1(0, i * 2., i * 3., i * 4.);
+  }
+
+  auto t1 = b1.finalize();
+  DynPoints points{t1};
+  using R = test::R<test::X, test::Y, test::Z>;
+
+  auto materialized = o2::soa::Materialize<DynPoints, R>(points);
+  REQUIRE(materialized.size() == 9);
+  REQUIRE(materialized.asArrowTable()->GetColumnByName("fMaterializedR") != nullptr);
+
+  // The rows of the materialized table read the stored values, the others still compute them
+  using columns_t = decltype(materialized)::columns_t;
+  static_assert(o2::framework::has_type<R::materialized>(columns_t{}));
+  static_assert(!o2::framework::has_type<R>(columns_t{}));
+  static_assert(o2::framework::has_type<R>(DynPoints::columns_t{}));
+
+  auto row = materialized.begin();
+  auto original = points.begin();
+  for (auto i = 1; i < 10; ++i) {
+    REQUIRE(row.r() == original.r());
+    REQUIRE(row.r() == std::sqrt((float)(i * i * 4 + i * i * 9 + i * i * 16)));
+    ++row;
+    ++original;
+  }
+
+  expressions::Filter f = o2::soa::materialized<R>() > 10.f;
+  auto selection = expressions::createSelection(materialized.asArrowTable(), f);
+  REQUIRE(selection->GetNumSlots() == 8);
+
+  // slices keep their offset, as with Attach
+  auto slice = points.rawSlice(3, 7);
+  auto materializedSlice = o2::soa::Materialize<DynPoints, R>(slice);
+  REQUIRE(materializedSlice.size() == 5);
+  REQUIRE(materializedSlice.offset() == 3);
+  REQUIRE(materializedSlice.begin().globalIndex() == 3);
+  REQUIRE(materializedSlice.begin().r() == slice.begin().r());
+
+  auto empty = o2::soa::Materialize<DynPoints, R>(DynPoints{makeEmptyTable<DynPoints>("empty")});
+  REQUIRE(empty.size() == 0);
+}
@@ -0,0 +1,73 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+#include <catch_amalgamated.hpp>
+#include "Framework/TimeframeCostModel.h"
+
+using namespace o2::framework;
+
+TEST_CASE("TimeframeCostModelLatency")
+{
+  TimeframeCostModel model;
+  REQUIRE(model.pacing(100, 4) == 0);
+  uint64_t now = 0;
+  // Latency of 1 us + 10 ns per unit of size
+  for (int64_t ts = 0; ts < 100; ++ts) {
+    size_t size = 50 + (ts * 37) % 100;
+    model.injected(ts, size, now);
+    REQUIRE(model.inFlight() == 1);
+    REQUIRE(model.inFlightSize() == size);
+    now += 1000 + 10 * size;
+    model.consumed(ts + 1, now);
+    REQUIRE(model.inFlight() == 0);
+  }
+  REQUIRE(model.ready());
+  REQUIRE(model.latency(100) == Catch::Approx(2000).epsilon(0.01));
+  REQUIRE(model.latency(200) == Catch::Approx(3000).epsilon(0.01));
+  REQUIRE(model.pacing(200, 4) == Catch::Approx(750).epsilon(0.01));
+}
+
+TEST_CASE("TimeframeCostModelUnknownSize")
+{
+  TimeframeCostModel model;
+  uint64_t now = 0;
+  for (int64_t ts = 0; ts < 10; ++ts) {
+    model.injected(ts, 1, now);
+    now += 5000;
+    model.consumed(ts + 1, now);
+  }
+  REQUIRE(model.latency(1) == Catch::Approx(5000));
+  REQUIRE(model.latency(1000) == Catch::Approx(5000));
+  REQUIRE(model.memory(1) == 0);
+}
+
+TEST_CASE("TimeframeCostModelMemory")
+{
+  TimeframeCostModel model;
+  // Every unit in flight takes 50 bytes of shared memory
+  size_t total = 1000000;
+  int64_t ts = 0;
+  for (int round = 0; round < 10; ++round) {
+    for (int i = 0; i < 4; ++i) {
+      model.memorySample(total - 50 * model.inFlightSize());
+      model.injected(ts++, 100 * (i + 1), 0);
+      // Not enough samples yet for the slope to be trusted
+      if (round == 0 && i < TimeframeCostModel::MinSamples - 1) {
+        REQUIRE(model.memory(100) == 0);
+      }
+    }
+    model.consumed(ts, 0);
+  }
+  REQUIRE(model.inFlight() == 0);
+  REQUIRE(model.memory(100) == Catch::Approx(5000));
+  // At most 600 units were seen in flight at once, i.e. 30000 bytes
+  REQUIRE(model.memory(1000) == Catch::Approx(30000));
+}
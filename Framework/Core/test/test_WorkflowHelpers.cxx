@@ -17,9 +17,11 @@
 #include "Framework/LifetimeHelpers.h"
 #include "../src/WorkflowHelpers.h"
 #include <catch_amalgamated.hpp>
+#include <fmt/format.h>
 #include <algorithm>
 #include <memory>
 #include <list>
+#include <unistd.h>
 
 using namespace o2::framework;
 
@@ -306,6 +308,67 @@ TEST_CASE("TestSimpleForward")
   }
 }
 
+TEST_CASE("TestGraphCache")
+{
+  WorkflowSpec workflow{
+    {"A", {}, Outputs{OutputSpec{"TST", "A"}}},
+    {"B", {InputSpec{"y", "TST", "A"}}, Outputs{OutputSpec{"TST", "B"}}},
+    {"C", {InputSpec{"y", "TST", "A"}, InputSpec{"x", "TST", "B"}}}};
+  workflow[1].maxInputTimeslices = 2;
+  REQUIRE(WorkflowHelpers::verifyWorkflow(workflow) == WorkflowParsingState::Valid);
+  auto context = makeEmptyConfigContext();
+  WorkflowHelpers::injectServiceDevices(workflow, *context);
+
+  std::vector<DeviceConnectionEdge> expectedEdges;
+  std::vector<OutputSpec> expectedOutputs;
+  std::vector<LogicalForwardInfo> expectedForwards;
+  WorkflowHelpers::constructGraph(workflow, expectedEdges, expectedOutputs, expectedForwards);
+
+  char cacheDir[] = "/tmp/dpl-graph-cache-XXXXXX";
+  REQUIRE(mkdtemp(cacheDir) != nullptr);
+  auto hash = WorkflowHelpers::graphHash(workflow);
+  auto cacheFile = fmt::format("{}/dpl-graph-{:016x}.bin", cacheDir, hash);
+
+  for (bool expectCached : {false, true}) {
+    std::vector<DeviceConnectionEdge> logicalEdges;
+    std::vector<OutputSpec> outputs;
+    std::vector<LogicalForwardInfo> availableForwardsInfo;
+    REQUIRE(WorkflowHelpers::constructGraphCached(workflow, cacheDir, logicalEdges, outputs, availableForwardsInfo) == expectCached);
+    REQUIRE(outputs == expectedOutputs);
+    REQUIRE(logicalEdges.size() == expectedEdges.size());
+    for (size_t ei = 0; ei < expectedEdges.size(); ++ei) {
+      REQUIRE(logicalEdges[ei].producer == expectedEdges[ei].producer);
+      REQUIRE(logicalEdges[ei].consumer == expectedEdges[ei].consumer);
+      REQUIRE(logicalEdges[ei].timeIndex == expectedEdges[ei].timeIndex);
+      REQUIRE(logicalEdges[ei].producerTimeIndex == expectedEdges[ei].producerTimeIndex);
+      REQUIRE(logicalEdges[ei].outputGlobalIndex == expectedEdges[ei].outputGlobalIndex);
+      REQUIRE(logicalEdges[ei].consumerInputIndex == expectedEdges[ei].consumerInputIndex);
+      REQUIRE(logicalEdges[ei].isForward == expectedEdges[ei].isForward);
+    }
+    REQUIRE(availableForwardsInfo.size() == expectedForwards.size());
+    for (size_t fi = 0; fi < expectedForwards.size(); ++fi) {
+      REQUIRE(availableForwardsInfo[fi].consumer == expectedForwards[fi].consumer);
+      REQUIRE(availableForwardsInfo[fi].inputLocalIndex == expectedForwards[fi].inputLocalIndex);
+      REQUIRE(availableForwardsInfo[fi].outputGlobalIndex == expectedForwards[fi].outputGlobalIndex);
+    }
+  }
+
+  // A different topology has a different key
+  workflow[1].maxInputTimeslices = 1;
+  REQUIRE(WorkflowHelpers::graphHash(workflow) != hash);
+
+  // A truncated file is a miss
+  REQUIRE(truncate(cacheFile.c_str(), 40) == 0);
+  workflow[1].maxInputTimeslices = 2;
+  std::vector<DeviceConnectionEdge> logicalEdges;
+  std::vector<OutputSpec> outputs;
+  std::vector<LogicalForwardInfo> availableForwardsInfo;
+  REQUIRE(WorkflowHelpers::constructGraphCached(workflow, cacheDir, logicalEdges, outputs, availableForwardsInfo) == false);
+  REQUIRE(logicalEdges.size() == expectedEdges.size());
+  remove(cacheFile.c_str());
+  rmdir(cacheDir);
+}
+
 TEST_CASE("TestGraphConstruction")
 {
   WorkflowSpec workflow{
@@ -648,3 +711,77 @@ TEST_CASE("TestOriginWildcard")
     }
   }
 }
+
+// A and B both spawn DYN/EXTRACK and build IDX/MA_RN3_EX, which the spawner
+// and the index builder know how to produce: both of them get the tables as
+// inputs, from there. They also both spawn DYN/EXTRA, which is defined by the
+// analysis itself: A stays its producer and B receives it, like C which was
+// already consuming it.
+TEST_CASE("TestShareDerivedTables")
+{
+  WorkflowSpec workflow{
+    {.name = "A",
+     .inputs = {InputSpec{"tracks", "AOD", "TRACK"}},
+     .outputs = {OutputSpec{{"extrack"}, "DYN", "EXTRACK"}, OutputSpec{{"index"}, "IDX", "MA_RN3_EX"}, OutputSpec{{"extra"}, "DYN", "EXTRA"}}},
+    {.name = "B",
+     .inputs = {InputSpec{"tracks", "AOD", "TRACK"}},
+     .outputs = {OutputSpec{{"extrack"}, "DYN", "EXTRACK"}, OutputSpec{{"index"}, "IDX", "MA_RN3_EX"}, OutputSpec{{"extra"}, "DYN", "EXTRA"}, OutputSpec{"TST", "B"}}},
+    {.name = "C",
+     .inputs = {InputSpec{"extra", "DYN", "EXTRA"}, InputSpec{"b", "TST", "B"}}}};
+
+  auto hasSources = [](InputSpec const& input) {
+    return std::any_of(input.metadata.begin(), input.metadata.end(), [](ConfigParamSpec const& m) { return m.name.find("input:") == 0; });
+  };
+
+  WorkflowHelpers::shareDerivedTables(workflow);
+  REQUIRE(workflow[0].outputs.size() == 1);
+  REQUIRE(DataSpecUtils::match(workflow[0].outputs[0], ConcreteDataMatcher{"DYN", "EXTRA", 0}));
+  REQUIRE(workflow[0].inputs.size() == 3);
+  for (auto& processor : {workflow[0], workflow[1]}) {
+    auto extrack = std::find_if(processor.inputs.begin(), processor.inputs.end(), [](InputSpec const& i) { return DataSpecUtils::match(i, ConcreteDataMatcher{"DYN", "EXTRACK", 0}); });
+    REQUIRE(extrack != processor.inputs.end());
+    REQUIRE(extrack->binding == "extrack");
+    REQUIRE(hasSources(*extrack));
+    auto index = std::find_if(processor.inputs.begin(), processor.inputs.end(), [](InputSpec const& i) { return DataSpecUtils::match(i, ConcreteDataMatcher{"IDX", "MA_RN3_EX", 0}); });
+    REQUIRE(index != processor.inputs.end());
+    REQUIRE(index->binding == "index");
+    REQUIRE(hasSources(*index));
+  }
+  REQUIRE(workflow[1].outputs.size() == 1);
+  REQUIRE(DataSpecUtils::match(workflow[1].outputs[0], ConcreteDataMatcher{"TST", "B", 0}));
+  REQUIRE(workflow[1].inputs.size() == 4);
+  REQUIRE(workflow[1].inputs[3].binding == "extra");
+  REQUIRE(DataSpecUtils::match(workflow[1].inputs[3], ConcreteDataMatcher{"DYN", "EXTRA", 0}));
+  REQUIRE(workflow[2].inputs.size() == 2);
+
+  // Nothing left to share
+  WorkflowHelpers::shareDerivedTables(workflow);
+  REQUIRE(workflow[0].outputs.size() == 1);
+  REQUIRE(workflow[1].outputs.size() == 1);
+  REQUIRE(workflow[1].inputs.size() == 4);
+
+  // B cannot receive the table from A if A depends on B, also through C
+  WorkflowSpec loop{
+    {.name = "A",
+     .inputs = {InputSpec{"c", "TST", "C"}},
+     .outputs = {OutputSpec{{"extra"}, "DYN", "EXTRA"}}},
+    {.name = "B",
+     .inputs = {InputSpec{"tracks", "AOD", "TRACK"}},
+     .outputs = {OutputSpec{{"extra"}, "DYN", "EXTRA"}, OutputSpec{"TST", "B"}}},
+    {.name = "C",
+     .inputs = {InputSpec{"b", "TST", "B"}},
+     .outputs = {OutputSpec{"TST", "C"}}}};
+  REQUIRE_THROWS(WorkflowHelpers::shareDerivedTables(loop));
+
+  // No loop when the table comes from the spawner
+  for (auto& processor : loop) {
+    for (auto& output : processor.outputs) {
+      if (DataSpecUtils::match(output, ConcreteDataMatcher{"DYN", "EXTRA", 0})) {
+        output = OutputSpec{{"extrack"}, "DYN", "EXTRACK"};
+      }
+    }
+  }
+  WorkflowHelpers::shareDerivedTables(loop);
+  REQUIRE(loop[0].outputs.empty());
+  REQUIRE(loop[1].outputs.size() == 1);
+}
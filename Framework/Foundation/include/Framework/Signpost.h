@@ -148,7 +148,9 @@ o2_log_handle_t* o2_walk_logs(bool (*callback)(char const* name, void* log, void
 #include <array>
 #include <cassert>
 #include <cinttypes>
+#include <cstdarg>
 #include <cstddef>
+#include <cstdint>
 
 struct _o2_lock_free_stack {
   static constexpr size_t N = 1024;
@@ -196,6 +198,44 @@ struct _o2_log_t {
 
   // Default stacktrace level for the log, when enabled.
   int defaultStacktrace = 1;
+
+  // When not 0, the signposts of an enabled log are recorded in the binary
+  // per-thread ring buffers rather than printed, see o2_signpost_write_trace.
+  int binary = 0;
+
+  // Name of the log, used as category of the exported trace events.
+  char const* name = nullptr;
+};
+
+// One entry in the per-thread ring buffer of signposts recorded in binary mode.
+struct _o2_signpost_record_t {
+  enum Type : uint8_t {
+    IntervalBegin,
+    IntervalEnd,
+    Event
+  };
+  static constexpr size_t MessageSize = 95;
+  // Nanoseconds of the steady clock, which is common to all the processes of the node.
+  uint64_t timestamp = 0;
+  int64_t id = 0;
+  _o2_log_t const* log = nullptr;
+  // Name of the signpost, expected to be a string literal.
+  char const* name = nullptr;
+  Type type = Event;
+  // The formatted message, truncated to MessageSize - 1 characters.
+  char message[MessageSize];
+};
+
+// Single producer ring buffer of the records emitted by one thread. When the
+// buffer is full, the oldest records are overwritten. The rings are never
+// deallocated, so that the records of threads which are gone can still be exported.
+struct _o2_signpost_ring_t {
+  static constexpr size_t N = 1 << 14;
+  // Number of records written since the creation of the ring.
+  std::atomic<uint64_t> head = 0;
+  uint64_t tid = 0;
+  _o2_signpost_ring_t* next = nullptr;
+  _o2_signpost_record_t records[N];
 };
 
 bool _o2_lock_free_stack_push(_o2_lock_free_stack& stack, const int& value, bool spin = false);
@@ -205,6 +245,16 @@ void _o2_signpost_event_emit(_o2_log_t* log, _o2_signpost_id_t id, char const* n
 void _o2_signpost_interval_begin(_o2_log_t* log, _o2_signpost_id_t id, char const* name, char const* const format, ...);
 void _o2_signpost_interval_end(_o2_log_t* log, _o2_signpost_id_t id, char const* name, char const* const format, ...);
 void _o2_log_set_stacktrace(_o2_log_t* log, int stacktrace);
+void _o2_log_set_binary(_o2_log_t* log, int binary);
+void _o2_signpost_record_v(_o2_log_t* log, _o2_signpost_record_t::Type type, _o2_signpost_id_t id, char const* name, char const* const format, va_list args);
+
+// Write the signposts recorded in binary mode by all the threads of this process to filename as a
+// Chrome JSON trace, which can be loaded in the Perfetto UI or in chrome://tracing.
+// Returns the number of exported records or -1 in case the file could not be written.
+int o2_signpost_write_trace(char const* filename, char const* processName);
+// Merge the traces written by o2_signpost_write_trace, e.g. by the different devices of a workflow,
+// in a single trace. Missing inputs are skipped. Returns the number of merged traces or -1 on error.
+int o2_signpost_merge_traces(char const* filename, char const* const* inputs, int nInputs);
 
 // This generates a unique id for a signpost. Do not use this directly, use O2_SIGNPOST_ID_GENERATE instead.
 // Notice that this is only valid on a given computer.
@@ -234,6 +284,15 @@ inline _o2_signpost_id_t _o2_signpost_id_make_with_pointer(_o2_log_t* log, void
 #include <cstdio>
 #include <cstring>
 #include <execinfo.h>
+#include <algorithm>
+#include <chrono>
+#include <functional>
+#include <thread>
+#include <vector>
+#include <unistd.h>
+#ifdef __linux__
+#include <sys/syscall.h>
+#endif
 #include "Framework/RuntimeError.h"
 #include "Framework/BacktraceHelpers.h"
 void _o2_signpost_interval_end_v(_o2_log_t* log, _o2_signpost_id_t id, char const* name, char const* const format, va_list args);
@@ -333,6 +392,7 @@ void* _o2_log_create(char const* name, int defaultStacktrace)
   }
 #endif
   newHandle->name = strdup(name);
+  log->name = newHandle->name;
   newHandle->next = o2_get_logs_tail().load();
   // Until I manage to replace the log I have in next, keep trying.
   // Notice this does not protect against two threads trying to insert
@@ -352,6 +412,11 @@ void _o2_signpost_event_emit(_o2_log_t* log, _o2_signpost_id_t id, char const* n
 {
   va_list args;
   va_start(args, format);
+  if (log->binary) {
+    _o2_signpost_record_v(log, _o2_signpost_record_t::Event, id, name, format, args);
+    va_end(args);
+    return;
+  }
 
   // Find the index of the activity
   int leading = 0;
@@ -392,6 +457,12 @@ void _o2_signpost_interval_begin(_o2_log_t* log, _o2_signpost_id_t id, char cons
 {
   va_list args;
   va_start(args, format);
+  // In binary mode the nesting is reconstructed from the timestamps, no need to keep track of the slots.
+  if (log->binary) {
+    _o2_signpost_record_v(log, _o2_signpost_record_t::IntervalBegin, id, name, format, args);
+    va_end(args);
+    return;
+  }
   // This is a unique slot for this interval.
   _o2_signpost_index_t signpost_index;
   _o2_lock_free_stack_pop(log->slots, signpost_index, true);
@@ -413,6 +484,10 @@ void _o2_signpost_interval_end_v(_o2_log_t* log, _o2_signpost_id_t id, char cons
   if (log->stacktrace == 0) {
     return;
   }
+  if (log->binary) {
+    _o2_signpost_record_v(log, _o2_signpost_record_t::IntervalEnd, id, name, format, args);
+    return;
+  }
   // Find the index of the activity
   int i = 0;
   for (i = 0; i < log->ids.size(); ++i) {
@@ -458,12 +533,185 @@ void _o2_log_set_stacktrace(_o2_log_t* log, int stacktrace)
 {
   log->stacktrace = stacktrace;
 }
+
+void _o2_log_set_binary(_o2_log_t* log, int binary)
+{
+  log->binary = binary;
+}
+
+// The head of the list of all the rings, so that they can be walked when exporting.
+std::atomic<_o2_signpost_ring_t*>& _o2_signpost_get_rings()
+{
+  static std::atomic<_o2_signpost_ring_t*> first = nullptr;
+  return first;
+}
+
+_o2_signpost_ring_t* _o2_signpost_get_thread_ring()
+{
+  thread_local _o2_signpost_ring_t* ring = nullptr;
+  if (O2_BUILTIN_LIKELY(ring != nullptr)) {
+    return ring;
+  }
+  ring = new _o2_signpost_ring_t();
+#ifdef __linux__
+  ring->tid = syscall(SYS_gettid);
+#else
+  ring->tid = std::hash<std::thread::id>{}(std::this_thread::get_id());
+#endif
+  ring->next = _o2_signpost_get_rings().load();
+  while (!_o2_signpost_get_rings().compare_exchange_weak(ring->next, ring,
+                                                          std::memory_order_release,
+                                                          std::memory_order_relaxed)) {
+  }
+  return ring;
+}
+
+void _o2_signpost_record_v(_o2_log_t* log, _o2_signpost_record_t::Type type, _o2_signpost_id_t id, char const* name, char const* const format, va_list args)
+{
+  auto* ring = _o2_signpost_get_thread_ring();
+  // Only this thread writes to the ring, the release store of the head publishes the record.
+  uint64_t pos = ring->head.load(std::memory_order_relaxed);
+  auto& record = ring->records[pos & (_o2_signpost_ring_t::N - 1)];
+  record.timestamp = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+  record.id = id.value;
+  record.log = log;
+  record.name = name;
+  record.type = type;
+  if (format && format[0] != 0) {
+    vsnprintf(record.message, _o2_signpost_record_t::MessageSize, format, args);
+  } else {
+    record.message[0] = 0;
+  }
+  ring->head.store(pos + 1, std::memory_order_release);
+}
+
+// Print s as the content of a JSON string.
+void _o2_signpost_json_escape(FILE* out, char const* s)
+{
+  for (; s && *s; ++s) {
+    switch (*s) {
+      case '"':
+        fputs("\\\"", out);
+        break;
+      case '\\':
+        fputs("\\\\", out);
+        break;
+      default:
+        if ((unsigned char)*s < 0x20) {
+          fprintf(out, "\\u%04x", *s);
+        } else {
+          fputc(*s, out);
+        }
+    }
+  }
+}
+
+// The trace has one event per line, all but the first one prefixed by a comma,
+// between a header and a footer line. o2_signpost_merge_traces relies on this layout.
+int o2_signpost_write_trace(char const* filename, char const* processName)
+{
+  FILE* out = fopen(filename, "w");
+  if (out == nullptr) {
+    return -1;
+  }
+  int pid = getpid();
+  fprintf(out, "{\"traceEvents\":[\n");
+  fprintf(out, "{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":%d,\"args\":{\"name\":\"", pid);
+  _o2_signpost_json_escape(out, processName);
+  fprintf(out, "\"}}\n");
+  char const* phases[] = {"b", "e", "i"};
+  size_t prefixSize = strlen("ch.cern.aliceo2.");
+  int nRecords = 0;
+  std::vector<_o2_signpost_record_t> records;
+  for (auto* ring = _o2_signpost_get_rings().load(); ring; ring = ring->next) {
+    // The writer may overwrite the oldest records while we copy them: after the copy, drop the
+    // ones which might have been overwritten, including the one which is possibly being written.
+    uint64_t head = ring->head.load(std::memory_order_acquire);
+    uint64_t first = head > _o2_signpost_ring_t::N ? head - _o2_signpost_ring_t::N : 0;
+    records.clear();
+    for (uint64_t pos = first; pos < head; ++pos) {
+      records.push_back(ring->records[pos & (_o2_signpost_ring_t::N - 1)]);
+    }
+    uint64_t newHead = ring->head.load(std::memory_order_acquire);
+    uint64_t valid = newHead + 1 > _o2_signpost_ring_t::N ? newHead + 1 - _o2_signpost_ring_t::N : 0;
+    for (uint64_t pos = std::max(first, valid); pos < head; ++pos) {
+      auto& record = records[pos - first];
+      char const* category = record.log->name ? record.log->name : "";
+      if (strncmp(category, "ch.cern.aliceo2.", prefixSize) == 0) {
+        category += prefixSize;
+      }
+      fprintf(out, ",{\"name\":\"");
+      _o2_signpost_json_escape(out, record.name);
+      fprintf(out, "\",\"cat\":\"%s\",\"ph\":\"%s\",\"ts\":%" PRIu64 ".%03" PRIu64 ",\"pid\":%d,\"tid\":%" PRIu64,
+              category, phases[record.type], record.timestamp / 1000, record.timestamp % 1000, pid, ring->tid);
+      if (record.type == _o2_signpost_record_t::Event) {
+        fprintf(out, ",\"s\":\"t\"");
+      } else {
+        fprintf(out, ",\"id\":\"0x%" PRIx64 "\"", (uint64_t)record.id);
+      }
+      fprintf(out, ",\"args\":{\"id\":\"0x%" PRIx64 "\",\"message\":\"", (uint64_t)record.id);
+      _o2_signpost_json_escape(out, record.message);
+      fprintf(out, "\"}}\n");
+      nRecords++;
+    }
+  }
+  fprintf(out, "]}\n");
+  if (fclose(out) != 0) {
+    return -1;
+  }
+  return nRecords;
+}
+
+int o2_signpost_merge_traces(char const* filename, char const* const* inputs, int nInputs)
+{
+  FILE* out = fopen(filename, "w");
+  if (out == nullptr) {
+    return -1;
+  }
+  fprintf(out, "{\"traceEvents\":[\n");
+  int nMerged = 0;
+  char* line = nullptr;
+  size_t lineSize = 0;
+  for (int ii = 0; ii < nInputs; ++ii) {
+    FILE* in = fopen(inputs[ii], "r");
+    if (in == nullptr) {
+      continue;
+    }
+    // Skip the header and drop the footer. The first event of each trace is not prefixed by a
+    // comma, so we need to add one unless this is the first trace being merged.
+    ssize_t len = getline(&line, &lineSize, in);
+    bool firstEvent = true;
+    while ((len = getline(&line, &lineSize, in)) > 0) {
+      if (strncmp(line, "]}", 2) == 0) {
+        break;
+      }
+      if (firstEvent && nMerged) {
+        fputc(',', out);
+      }
+      firstEvent = false;
+      fwrite(line, 1, len, out);
+    }
+    fclose(in);
+    nMerged++;
+  }
+  free(line);
+  fprintf(out, "]}\n");
+  if (fclose(out) != 0) {
+    return -1;
+  }
+  return nMerged;
+}
 // A C function which can be used to enable the signposts
 extern "C" {
 void o2_debug_log_set_stacktrace(_o2_log_t* log, int stacktrace)
 {
   log->stacktrace = stacktrace;
 }
+// Can be invoked from the debugger to dump the binary signposts of the process
+int o2_debug_signpost_write_trace(char const* filename)
+{
+  return o2_signpost_write_trace(filename, "");
+}
 }
 #endif // O2_SIGNPOST_IMPLEMENTATION
 
@@ -477,6 +725,11 @@ void o2_debug_log_set_stacktrace(_o2_log_t* log, int stacktrace)
 // When we enable the log, we set the stacktrace to the default value.
 #define O2_LOG_ENABLE(log) _o2_log_set_stacktrace(private_o2_log_##log, private_o2_log_##log->defaultStacktrace)
 #define O2_LOG_DISABLE(log) _o2_log_set_stacktrace(private_o2_log_##log, 0)
+// Enable the log recording its signposts in the binary ring buffers rather than printing them.
+#define O2_LOG_ENABLE_TRACE(log) __extension__({                                         \
+  _o2_log_set_binary(private_o2_log_##log, 1);                                           \
+  _o2_log_set_stacktrace(private_o2_log_##log, private_o2_log_##log->defaultStacktrace); \
+})
 // For the moment we simply use LOG DEBUG. We should have proper activities so that we can
 // turn on and off the printing.
 #define O2_LOG_DEBUG(log, ...) __extension__({                        \
@@ -549,6 +802,7 @@ void o2_debug_log_set_stacktrace(_o2_log_t* log, int stacktrace)
 #define O2_DECLARE_LOG(x, category)
 #define O2_LOG_ENABLE(log)
 #define O2_LOG_DISABLE(log)
+#define O2_LOG_ENABLE_TRACE(log)
 #define O2_LOG_DEBUG(log, ...)
 #define O2_SIGNPOST_ID_FROM_POINTER(name, log, pointer)
 #define O2_SIGNPOST_ID_GENERATE(name, log)
@@ -0,0 +1,93 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+#include "Framework/Signpost.h"
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <unistd.h>
+
+O2_DECLARE_DYNAMIC_LOG(test_SignpostTrace);
+
+std::string readFile(char const* filename)
+{
+  std::ifstream in(filename);
+  std::stringstream ss;
+  ss << in.rdbuf();
+  return ss.str();
+}
+
+size_t countOf(std::string const& s, std::string const& what)
+{
+  size_t count = 0;
+  for (auto pos = s.find(what); pos != std::string::npos; pos = s.find(what, pos + 1)) {
+    ++count;
+  }
+  return count;
+}
+
+int main(int argc, char** argv)
+{
+  O2_LOG_ENABLE_TRACE(test_SignpostTrace);
+
+  auto work = [](int n) {
+    for (int i = 0; i < n; ++i) {
+      O2_SIGNPOST_ID_GENERATE(id, test_SignpostTrace);
+      O2_SIGNPOST_START(test_SignpostTrace, id, "iteration", "Iteration %d with \"quotes\"", i);
+      O2_SIGNPOST_EVENT_EMIT(test_SignpostTrace, id, "step", "Half way");
+      O2_SIGNPOST_END(test_SignpostTrace, id, "iteration", "");
+    }
+  };
+  std::thread t1(work, 10);
+  std::thread t2(work, 20);
+  t1.join();
+  t2.join();
+
+  char first[] = "/tmp/o2-test-signpost-trace-XXXXXX";
+  char second[] = "/tmp/o2-test-signpost-trace-XXXXXX";
+  char merged[] = "/tmp/o2-test-signpost-trace-XXXXXX";
+  for (char* name : {first, second, merged}) {
+    close(mkstemp(name));
+  }
+
+  int nRecords = o2_signpost_write_trace(first, "test_SignpostTrace");
+  std::string trace = readFile(first);
+  bool ok = nRecords == 90 &&
+            countOf(trace, "\"ph\":\"b\"") == 30 &&
+            countOf(trace, "\"ph\":\"e\"") == 30 &&
+            countOf(trace, "\"ph\":\"i\"") == 30 &&
+            countOf(trace, "\"cat\":\"test_SignpostTrace\"") == 90 &&
+            countOf(trace, "Iteration 19 with \\\"quotes\\\"") == 1;
+  if (!ok) {
+    std::cerr << "Unexpected trace with " << nRecords << " records:\n"
+              << trace;
+  }
+
+  o2_signpost_write_trace(second, "test_SignpostTrace2");
+  char const* inputs[] = {first, second, "/non/existing/trace.json"};
+  int nMerged = o2_signpost_merge_traces(merged, inputs, 3);
+  std::string mergedTrace = readFile(merged);
+  // All the events but the first one are separated by a comma
+  if (nMerged != 2 || countOf(mergedTrace, "\"ph\":\"b\"") != 60 || countOf(mergedTrace, "process_name") != 2 ||
+      countOf(mergedTrace, "\n,") != 2 * 91 - 1) {
+    std::cerr << "Unexpected merged trace of " << nMerged << " inputs:\n"
+              << mergedTrace;
+    ok = false;
+  }
+
+  for (char* name : {first, second, merged}) {
+    unlink(name);
+  }
+  return ok ? 0 : 1;
+}
@@ -55,6 +55,8 @@ struct MultiplotData {
   MetricType type;
   const char* legend = nullptr;
   int axis = 0;
+  // Width of the buckets when Y points to the MetricBucket of a downsampled history, 0 otherwise.
+  size_t bucketWidth = 0;
 };
 
 } // namespace o2::framework::gui
@@ -349,15 +351,20 @@ int formatTimeSinceStart(double value, char* buff, int size, void* user_data)
   return snprintf(buff, size, "%02" PRIi64 ":%02" PRIi64, minutes, seconds % 60);
 }
 
+/// @a resolution < 0 displays the raw values, otherwise the downsampled
+/// history at the given MetricResolution.
 void displayDeviceMetrics(const char* label,
                           size_t rangeBegin, size_t rangeEnd, size_t bins, MetricsDisplayStyle displayType,
                           std::vector<MetricDisplayState>& state,
                           AllMetricsStore const& metricStore,
-                          DriverInfo const& driverInfo)
+                          DriverInfo const& driverInfo,
+                          int resolution)
 {
   std::vector<void*> metricsToDisplay;
   std::vector<const char*> deviceNames;
   std::vector<MultiplotData> userData;
+  // Keeps the buckets of the downsampled histories alive while plotting.
+  std::vector<std::vector<MetricBucket>> histories;
 #ifdef NDEBUG
   for (size_t si = 0; si < TOTAL_TYPES_OF_METRICS; ++si) {
     assert(metricsStore.metrics[si].size() == metricStore.specs[si].size());
@@ -393,6 +400,21 @@ void displayDeviceMetrics(const char* label,
         maxDomain = std::max(maxDomain, metricsInfos[di].maxDomain[mi]);
         axisFlags |= data.axis == 1 ? (ImPlotFlags_)ImPlotFlags_YAxis2 : ImPlotFlags_None;
         axisFlags |= data.axis == 2 ? (ImPlotFlags_)ImPlotFlags_YAxis3 : ImPlotFlags_None;
+        bool numeric = metric.type == MetricType::Int || metric.type == MetricType::Float || metric.type == MetricType::Uint64;
+        if (resolution >= 0 && numeric) {
+          auto& buckets = histories.emplace_back();
+          DeviceMetricsHelper::getHistory(metricsInfos[di], mi, (MetricResolution)resolution, buckets);
+          data.bucketWidth = MetricHistory::BUCKET_WIDTH[resolution];
+          data.Y = buckets.data();
+          data.first = 0;
+          data.mod = buckets.size();
+          if (!buckets.empty()) {
+            minDomain = std::min(minDomain, (size_t)buckets.front().index * data.bucketWidth);
+          }
+          userData.emplace_back(data);
+          gmi++;
+          continue;
+        }
         switch (metric.type) {
           case MetricType::Int: {
             data.Y = metricsInfos[di].intMetrics[metric.storeIdx].data();
@@ -450,6 +472,10 @@ void displayDeviceMetrics(const char* label,
 
   auto getterXY = [](int idx, void* hData) -> ImPlotPoint {
     auto histoData = reinterpret_cast<const MultiplotData*>(hData);
+    if (histoData->bucketWidth != 0) {
+      auto& bucket = static_cast<const MetricBucket*>(histoData->Y)[idx];
+      return ImPlotPoint{(double)bucket.index * histoData->bucketWidth, bucket.average()};
+    }
     size_t pos = (histoData->first + static_cast<size_t>(idx)) % histoData->mod;
     double x = static_cast<const size_t*>(histoData->X)[pos];
     double y = 0.;
@@ -811,6 +837,18 @@ void displayMetrics(gui::WorkspaceGUIState& state,
     ImGui::EndCombo();
   }
   ImGui::PopItemWidth();
+  // Index 0 is the raw values, the others the MetricResolution + 1.
+  static char const* resolutions[] = {
+    "raw",
+    "1 s",
+    "1 min"};
+  static int currentResolution = 0;
+  ImGui::SameLine();
+  ImGui::TextUnformatted("Resolution:");
+  ImGui::SameLine();
+  ImGui::PushItemWidth(100);
+  ImGui::Combo("##Select resolution", &currentResolution, resolutions, IM_ARRAYSIZE(resolutions));
+  ImGui::PopItemWidth();
 
   size_t gmi = 0;
   int visibleMetrics = 0;
@@ -888,7 +926,7 @@ void displayMetrics(gui::WorkspaceGUIState& state,
     case MetricsDisplayStyle::Lines: {
       displayDeviceMetrics("Metrics",
                            minTime, maxTime, 1024,
-                           currentStyle, metricDisplayState, metricsStore, driverInfo);
+                           currentStyle, metricDisplayState, metricsStore, driverInfo, currentResolution - 1);
     } break;
     case MetricsDisplayStyle::Sparks: {
       displaySparks(state.startTime, visibleMetricsIndex, metricDisplayState, metricsStore);
@@ -22,6 +22,7 @@
 #include "Framework/DataProcessingStates.h"
 #include "Framework/Signpost.h"
 #include "InspectorHelpers.h"
+#include "../src/ComputingResourceHelpers.h"
 #include <DebugGUI/icons_font_awesome.h>
 
 #include "DebugGUI/imgui.h"
@@ -271,6 +272,11 @@ void displayDeviceInspector(DeviceSpec const& spec,
   }
   ImGui::Text("Device state: %s", info.deviceState.data());
   ImGui::Text("Rank: %zu/%zu%%%zu/%zu", spec.rank, spec.nSlots, spec.inputTimesliceId, spec.maxInputTimeslices);
+  if (spec.resource.numaNode >= 0) {
+    ImGui::Text("Placement: NUMA node %d, cpus %s", spec.resource.numaNode, ComputingResourceHelpers::formatCpuList(spec.resource.cpus).c_str());
+  } else {
+    ImGui::TextUnformatted("Placement: none");
+  }
 
   if (ImGui::Button(ICON_FA_BUG "Attach debugger")) {
     std::string pid = std::to_string(info.pid);
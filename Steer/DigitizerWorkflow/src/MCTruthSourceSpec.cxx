@@ -44,21 +44,26 @@ class MCTruthSourceTask : public o2::framework::Task
 
     using TruthElement = o2::MCCompLabel;
     using Container = dataformats::MCTruthContainer<TruthElement>;
-    Container container;
-    // create a very large container and stream it to TTree
-    for (int i = 0; i < mSize; ++i) {
-      container.addElement(i, TruthElement(i, i, i));
-      container.addElement(i, TruthElement(i + 1, i, i));
-    }
 
     if (mNew) {
       LOG(info) << "New serialization";
-      // we need to flatten it and write to managed shared memory container
+      // fill the labels directly in the flat layout into the managed shared memory container
       auto& sharedlabels = pc.outputs().make<o2::dataformats::ConstMCTruthContainer<o2::MCCompLabel>>(Output{"TST", "LABELS", 0});
-      container.flatten_to(sharedlabels);
+      auto builder = dataformats::makeConstMCTruthContainerBuilder<TruthElement>(sharedlabels, mSize, 2 * mSize);
+      for (int i = 0; i < mSize; ++i) {
+        builder.addElement(i, TruthElement(i, i, i));
+        builder.addElement(i, TruthElement(i + 1, i, i));
+      }
+      builder.finalize();
       sleep(1);
     } else {
       LOG(info) << "Old serialization";
+      Container container;
+      // create a very large container and stream it to TTree
+      for (int i = 0; i < mSize; ++i) {
+        container.addElement(i, TruthElement(i, i, i));
+        container.addElement(i, TruthElement(i + 1, i, i));
+      }
       pc.outputs().snapshot({"TST", "LABELS", 0}, container);
       sleep(1);
     }
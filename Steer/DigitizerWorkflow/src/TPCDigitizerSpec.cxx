@@ -405,6 +405,7 @@ class TPCDPLDigitizerTask : public BaseDPLDigitizer
         std::copy(mCommonMode.begin(), mCommonMode.end(), std::back_inserter(commonModeAccum));
       }
       mDigitCounter += mDigits.size();
+      mTotalDigitCounter += mDigits.size();
     };
 
     if (isContinuous) {
@@ -468,7 +469,11 @@ class TPCDPLDigitizerTask : public BaseDPLDigitizer
     }
 
     timer.Stop();
+    mTotalDigitizationTime += timer.RealTime();
     LOG(info) << "TPC: Digitization took " << timer.CpuTime() << "s";
+    const auto& digitContainer = mDigitizer.getDigitContainer();
+    LOG(info) << "TPC: Digit container holds " << digitContainer.getNAllocatedTimeBins() << " time bins ("
+              << digitContainer.getAllocatedMemory() / (1024 * 1024) << " MB), " << mTotalDigitCounter / std::max(mTotalDigitizationTime, 1.e-6) << " digits/s";
   }
 
  private:
@@ -482,6 +487,8 @@ class TPCDPLDigitizerTask : public BaseDPLDigitizer
   TFile* mInternalROOTFlushFile = nullptr;
   TTree* mInternalROOTFlushTTree = nullptr;
   size_t mDigitCounter = 0;
+  size_t mTotalDigitCounter = 0;     // digits produced since the start, not reset per input, for the rate
+  double mTotalDigitizationTime = 0; // wall time spent in the digitization of these digits
   size_t mFlushCounter = 0;
   int mLaneId = 0; // the id of the current process within the parallel pipeline
   int mSector = 0;